@@ -0,0 +1,236 @@
+/**
+ * LIBGAUSS - CHÍNH SÁCH CHỌN ENGINE VÀ ĐIỂM VÀO CHUNG
+ * Các engine nằm trong gauss_sequential.c, gauss_openmp.c, gauss_pthread.c,
+ * gauss_mpi.c (lõi dùng chung: gauss_core.c). GAUSS_HAVE_OPENMP /
+ * GAUSS_HAVE_MPI do Makefile định nghĩa khi engine tương ứng build được.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "gauss.h"
+#include "gauss_verify.h"
+
+// n nhỏ hơn: chi phí tạo luồng lớn hơn phần việc, giải tuần tự
+#define GAUSS_SEQUENTIAL_MAX 256
+
+// Số hàng tối thiểu cho mỗi luồng (dải hàng của ma trận con đủ lớn)
+#define GAUSS_ROWS_PER_THREAD 128
+
+// n nhỏ hơn: giao tiếp MPI lấn át tính toán, giải trên một process
+#define GAUSS_MPI_MIN 2000
+
+/* ============ Engine không build được: trả GAUSS_EENGINE ============ */
+
+#ifndef GAUSS_HAVE_OPENMP
+int gauss_solve_openmp(int n, double *A, int lda, double *b, double *x, int *perm,
+                       int num_threads, int block_size) {
+    (void)n; (void)A; (void)lda; (void)b; (void)x; (void)perm;
+    (void)num_threads; (void)block_size;
+    return GAUSS_EENGINE;
+}
+#endif
+
+#ifndef GAUSS_HAVE_MPI
+int gauss_solve_mpi(int n, const double *A, int lda, const double *b, double *x,
+                    int block_size) {
+    (void)n; (void)A; (void)lda; (void)b; (void)x; (void)block_size;
+    return GAUSS_EENGINE;
+}
+
+int gauss_mpi_init(int *argc, char ***argv, int *rank) {
+    (void)argc; (void)argv;
+    *rank = 0;
+    return GAUSS_EENGINE;
+}
+
+void gauss_mpi_finalize(void) {
+}
+
+int gauss_mpi_processes(void) {
+    return 0;
+}
+#endif
+
+void gauss_options_init(GaussOptions *opt) {
+    opt->engine = GAUSS_ENGINE_AUTO;
+    opt->num_threads = 0;
+    opt->block_size = -1;
+}
+
+int gauss_lda(int n) {
+    int lda = (n + 7) & ~7;
+    if (lda % 512 == 0) {
+        lda += 8;
+    }
+    return lda;
+}
+
+int gauss_engine_available(GaussEngine engine) {
+    switch (engine) {
+    case GAUSS_ENGINE_AUTO:
+    case GAUSS_ENGINE_SEQUENTIAL:
+    case GAUSS_ENGINE_PTHREAD:
+        return 1;
+    case GAUSS_ENGINE_OPENMP:
+#ifdef GAUSS_HAVE_OPENMP
+        return 1;
+#else
+        return 0;
+#endif
+    case GAUSS_ENGINE_MPI:
+#ifdef GAUSS_HAVE_MPI
+        return 1;
+#else
+        return 0;
+#endif
+    }
+    return 0;
+}
+
+const char* gauss_engine_name(GaussEngine engine) {
+    switch (engine) {
+    case GAUSS_ENGINE_AUTO:       return "auto";
+    case GAUSS_ENGINE_SEQUENTIAL: return "sequential";
+    case GAUSS_ENGINE_OPENMP:     return "openmp";
+    case GAUSS_ENGINE_PTHREAD:    return "pthread";
+    case GAUSS_ENGINE_MPI:        return "mpi";
+    }
+    return "?";
+}
+
+const char* gauss_strerror(int code) {
+    switch (code) {
+    case GAUSS_OK:        return "thành công";
+    case GAUSS_ESINGULAR: return "ma trận suy biến";
+    case GAUSS_EINVAL:    return "tham số không hợp lệ";
+    case GAUSS_ENOMEM:    return "không đủ bộ nhớ";
+    case GAUSS_EENGINE:   return "engine không có trong bản build hoặc MPI chưa khởi tạo";
+    }
+    return "lỗi không xác định";
+}
+
+/**
+ * Chính sách: nhiều process MPI và n đủ lớn → MPI; n nhỏ hoặc chỉ đủ việc
+ * cho một luồng → tuần tự; còn lại OpenMP (nếu build được, ngược lại
+ * Pthread) với số luồng min(cores, n / GAUSS_ROWS_PER_THREAD)
+ */
+GaussEngine gauss_select_engine(int n, int cores, int *num_threads) {
+    if (cores <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        cores = (online > 0) ? (int)online : 1;
+    }
+    
+    int procs = gauss_mpi_processes();
+    if (procs > 1 && n >= GAUSS_MPI_MIN) {
+        *num_threads = procs;
+        return GAUSS_ENGINE_MPI;
+    }
+    
+    int threads = n / GAUSS_ROWS_PER_THREAD;
+    if (threads > cores) {
+        threads = cores;
+    }
+    if (n < GAUSS_SEQUENTIAL_MAX || threads < 2) {
+        *num_threads = 1;
+        return GAUSS_ENGINE_SEQUENTIAL;
+    }
+    
+    *num_threads = threads;
+#ifdef GAUSS_HAVE_OPENMP
+    return GAUSS_ENGINE_OPENMP;
+#else
+    return GAUSS_ENGINE_PTHREAD;
+#endif
+}
+
+int gauss_solve(int n, double *A, int lda, double *b, double *x, int *perm,
+                const GaussOptions *opt, GaussInfo *info) {
+    GaussOptions defaults;
+    if (!opt) {
+        gauss_options_init(&defaults);
+        opt = &defaults;
+    }
+    if (n <= 0 || lda < n || !A || !b || !x || opt->num_threads < 0) {
+        return GAUSS_EINVAL;
+    }
+    
+    int num_threads = opt->num_threads;
+    GaussEngine engine = opt->engine;
+    if (engine == GAUSS_ENGINE_AUTO) {
+        // Số luồng caller đưa là số core chính sách được dùng
+        engine = gauss_select_engine(n, opt->num_threads, &num_threads);
+    } else if (num_threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (online > 0) ? (int)online : 1;
+    }
+    
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    
+    int rc;
+    switch (engine) {
+    case GAUSS_ENGINE_SEQUENTIAL:
+        num_threads = 1;
+        rc = gauss_solve_sequential(n, A, lda, b, x, perm, opt->block_size);
+        break;
+    case GAUSS_ENGINE_OPENMP:
+        rc = gauss_solve_openmp(n, A, lda, b, x, perm, num_threads, opt->block_size);
+        break;
+    case GAUSS_ENGINE_PTHREAD:
+        rc = gauss_solve_pthread(n, A, lda, b, x, perm, num_threads, opt->block_size);
+        break;
+    case GAUSS_ENGINE_MPI:
+        num_threads = gauss_mpi_processes();
+        rc = gauss_solve_mpi(n, A, lda, b, x, opt->block_size);
+        break;
+    default:
+        rc = GAUSS_EINVAL;
+        break;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (info) {
+        info->engine = engine;
+        info->num_threads = num_threads;
+        info->time = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    }
+    return rc;
+}
+
+int gauss_test_system(int n, double *A, int lda, double *b) {
+    if (n <= 0 || lda < n || !A || !b) {
+        return GAUSS_EINVAL;
+    }
+    double *true_x = malloc(n * sizeof(double));
+    if (!true_x) {
+        return GAUSS_ENOMEM;
+    }
+    for (int i = 0; i < n; i++) {
+        true_x[i] = i + 1.0;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        double *row = A + (size_t)i * lda;
+        verify_test_row(n, i, 0, n, row);
+        b[i] = simd_dot(n, row, true_x);
+    }
+    
+    free(true_x);
+    return GAUSS_OK;
+}
+
+double gauss_backward_error(int n, const double *A, int lda, const double *b, const double *x) {
+    VerifySource src;
+    memset(&src, 0, sizeof(src));
+    src.n = n;
+    src.A = A;
+    src.lda = lda;
+    src.b = (double*)b;
+    
+    VerifyNorms acc;
+    verify_norms_init(&acc);
+    verify_rows(&src, x, 0, n, &acc);
+    return verify_backward_error(&acc, n, x, b);
+}
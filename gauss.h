@@ -0,0 +1,115 @@
+/**
+ * GAUSS - THƯ VIỆN GIẢI HỆ DENSE (libgauss)
+ * Một API cho cả 4 engine (tuần tự, OpenMP, Pthread, MPI), làm việc thẳng
+ * trên bộ đệm của caller: không sao chép, không cấp phát ma trận.
+ *
+ * A là ma trận n x n row-major, hàng i ở A + i * lda (lda >= n; gauss_lda(n)
+ * là bước hàng engine chạy nhanh nhất, đầu hàng căn lề 64 byte nếu A căn lề).
+ * Engine bộ nhớ chung phân tích LU tại chỗ: A nhận L\U theo hàng vật lý, b bị
+ * ghi đè, perm (NULL được) nhận hoán vị hàng: hàng logic i của L\U là hàng
+ * vật lý perm[i]. Engine MPI chỉ đọc A, b (mọi process truyền cùng hệ đầy đủ,
+ * mỗi process chép phần khối mình sở hữu) và không ghi perm.
+ *
+ * Biên dịch: make libgauss → build/libgauss.a, build/libgauss.so. Engine
+ * OpenMP / MPI chỉ có khi build được (gauss_engine_available).
+ */
+
+#ifndef GAUSS_H
+#define GAUSS_H
+
+#define GAUSS_API __attribute__((visibility("default")))
+
+// Mã trả về
+#define GAUSS_OK        0
+#define GAUSS_ESINGULAR 1   // Ma trận suy biến (pivot ~ 0)
+#define GAUSS_EINVAL    2   // Tham số không hợp lệ
+#define GAUSS_ENOMEM    3   // Hết bộ nhớ
+#define GAUSS_EENGINE   4   // Engine không có trong bản build (hoặc MPI chưa khởi tạo)
+
+// Engine giải
+typedef enum {
+    GAUSS_ENGINE_AUTO = 0,  // Chọn theo n và số core (gauss_select_engine)
+    GAUSS_ENGINE_SEQUENTIAL,
+    GAUSS_ENGINE_OPENMP,
+    GAUSS_ENGINE_PTHREAD,
+    GAUSS_ENGINE_MPI
+} GaussEngine;
+
+// Tùy chọn của gauss_solve (gauss_options_init gán mặc định)
+typedef struct {
+    GaussEngine engine;     // Mặc định GAUSS_ENGINE_AUTO
+    int num_threads;        // 0: số core; AUTO: số core chính sách được dùng
+    int block_size;         // Độ rộng panel LU khối (0: khử từng cột; MPI: khối
+                            // phân phối, 0 = mặc định), -1: mặc định engine
+} GaussOptions;
+
+// Thông tin lần giải
+typedef struct {
+    GaussEngine engine;     // Engine đã chạy
+    int num_threads;        // Số luồng (MPI: số process)
+    double time;            // Thời gian phân tích + thế (giây)
+} GaussInfo;
+
+GAUSS_API void gauss_options_init(GaussOptions *opt);
+
+/**
+ * Bước hàng khuyến nghị cho ma trận n x n: bội số 8 double, tránh bội số 4KB
+ */
+GAUSS_API int gauss_lda(int n);
+
+/**
+ * Chính sách chọn engine cho hệ n x n trên cores core (<= 0: số core online);
+ * *num_threads nhận số luồng nên dùng
+ */
+GAUSS_API GaussEngine gauss_select_engine(int n, int cores, int *num_threads);
+
+GAUSS_API int gauss_engine_available(GaussEngine engine);
+GAUSS_API const char* gauss_engine_name(GaussEngine engine);
+GAUSS_API const char* gauss_strerror(int code);
+
+/**
+ * Giải A x = b (xem đầu file về A, b, perm); opt NULL: mặc định, info NULL
+ * được. Với engine MPI (kể cả khi AUTO chọn MPI) mọi process của
+ * MPI_COMM_WORLD phải cùng gọi; x nhận nghiệm trên mọi process.
+ */
+GAUSS_API int gauss_solve(int n, double *A, int lda, double *b, double *x, int *perm,
+                          const GaussOptions *opt, GaussInfo *info);
+
+/**
+ * Hệ test dominant diagonal của các chương trình (nghiệm x[i] = i + 1).
+ * Trả về GAUSS_OK, GAUSS_EINVAL hoặc GAUSS_ENOMEM
+ */
+GAUSS_API int gauss_test_system(int n, double *A, int lda, double *b);
+
+/**
+ * Sai số ngược chuẩn vô cùng ||b - A*x|| / (||A|| * ||x|| + ||b||) trên hệ
+ * gốc (A, b chưa bị ghi đè); A = NULL: hệ test của gauss_test_system
+ */
+GAUSS_API double gauss_backward_error(int n, const double *A, int lda, const double *b,
+                                      const double *x);
+
+/* ============ Engine riêng (gauss_solve gọi sau khi kiểm tra tham số) ============ */
+
+GAUSS_API int gauss_solve_sequential(int n, double *A, int lda, double *b, double *x,
+                                     int *perm, int block_size);
+GAUSS_API int gauss_solve_openmp(int n, double *A, int lda, double *b, double *x,
+                                 int *perm, int num_threads, int block_size);
+GAUSS_API int gauss_solve_pthread(int n, double *A, int lda, double *b, double *x,
+                                  int *perm, int num_threads, int block_size);
+GAUSS_API int gauss_solve_mpi(int n, const double *A, int lda, const double *b, double *x,
+                              int block_size);
+
+/**
+ * Khởi tạo MPI cho chương trình không tự gọi MPI_Init (bỏ qua nếu đã khởi
+ * tạo), *rank nhận rank trong MPI_COMM_WORLD. gauss_mpi_finalize chỉ kết
+ * thúc MPI nếu gauss_mpi_init đã khởi tạo nó.
+ */
+GAUSS_API int gauss_mpi_init(int *argc, char ***argv, int *rank);
+GAUSS_API void gauss_mpi_finalize(void);
+
+/**
+ * Số process MPI khi MPI đã khởi tạo, 0 nếu chưa (hoặc không có engine MPI)
+ */
+GAUSS_API int gauss_mpi_processes(void);
+
+#endif /* GAUSS_H */
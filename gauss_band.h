@@ -0,0 +1,324 @@
+/**
+ * GAUSS BAND - LƯU TRỮ BĂNG VÀ LU BĂNG
+ * Ma trận có kl đường chéo dưới và ku đường chéo trên chỉ lưu
+ * ldab = 2*kl + ku + 1 phần tử mỗi cột (kiểu LAPACK dgbtrf, column-major):
+ * kl hàng đầu dành cho phần điền thêm (fill-in) khi đổi hàng pivot, vì hàng
+ * pivot có thể kéo U rộng tới kl + ku đường chéo trên.
+ *
+ * Khử cột j chỉ chạm cửa sổ (kl + 1) x (kl + ku + 1) quanh đường chéo nên chi
+ * phí là O(n * kl * (kl + ku)) thay vì O(n³). LU chia panel BAND_BLOCK cột:
+ * panel phân tích tuần tự, sau đó mỗi cột của cửa sổ phía sau nhận cả panel
+ * độc lập với các cột khác, nên các backend song song chia các cột đó cho
+ * các luồng; band_factor là bản tuần tự.
+ */
+
+#ifndef GAUSS_BAND_H
+#define GAUSS_BAND_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gauss_simd.h"
+
+// Chọn lưu trữ băng khi độ rộng lưu trữ 2*kl + ku + 1 <= n / BAND_MIN_RATIO
+#define BAND_MIN_RATIO 4
+
+// Độ rộng panel của LU băng khối
+#define BAND_BLOCK 32
+
+// Backend song song chỉ chia cửa sổ cho các luồng khi kl * (kl + ku) đạt
+// ngưỡng này; băng hẹp hơn chạy band_factor tuần tự
+#define BAND_PARALLEL_MIN 1024
+
+// Hệ băng: A(i, j) nằm ở AB[j * ldab + kl + ku + i - j]
+typedef struct {
+    double *AB;     // n cột x ldab, căn lề 64 byte; bị ghi đè bởi L và U
+    int ldab;       // 2*kl + ku + 1
+    int *ipiv;      // Cột j đã đổi hàng j với hàng ipiv[j]
+    double *b;      // Vế phải (không bị sửa khi giải)
+    double *x;      // Nghiệm
+    int n;
+    int kl;         // Số đường chéo dưới
+    int ku;         // Số đường chéo trên (của A ban đầu)
+} BandSystem;
+
+static inline size_t band_idx(const BandSystem *bs, int i, int j) {
+    return (size_t)j * bs->ldab + bs->kl + bs->ku + i - j;
+}
+
+static inline BandSystem* band_create(int n, int kl, int ku) {
+    BandSystem *bs = malloc(sizeof(BandSystem));
+    bs->n = n;
+    bs->kl = kl;
+    bs->ku = ku;
+    bs->ldab = 2 * kl + ku + 1;
+
+    size_t bytes = (size_t)n * bs->ldab * sizeof(double);
+    if (posix_memalign((void**)&bs->AB, 64, bytes) != 0) {
+        free(bs);
+        return NULL;
+    }
+    // Vùng fill-in phải bắt đầu bằng 0
+    memset(bs->AB, 0, bytes);
+
+    bs->ipiv = malloc(n * sizeof(int));
+    bs->b = calloc(n, sizeof(double));
+    bs->x = calloc(n, sizeof(double));
+    return bs;
+}
+
+static inline void band_free(BandSystem *bs) {
+    if (!bs) return;
+
+    free(bs->AB);
+    free(bs->ipiv);
+    free(bs->b);
+    free(bs->x);
+    free(bs);
+}
+
+/**
+ * Đo độ rộng băng của ma trận dense (row-major, bước lda): *kl / *ku là
+ * khoảng cách xa nhất tới đường chéo của phần tử khác 0 phía dưới / trên.
+ * Trả về 1 nếu băng đủ hẹp để lưu trữ băng có lợi; dừng sớm khi đã vượt
+ * ngưỡng (ma trận dense chỉ tốn vài hàng).
+ */
+static inline int band_detect(const double *A, int lda, int n, int *kl, int *ku) {
+    int max_width = n / BAND_MIN_RATIO;
+    *kl = 0;
+    *ku = 0;
+
+    for (int i = 0; i < n; i++) {
+        const double *row = A + (size_t)i * lda;
+        for (int j = 0; j < i - *kl; j++) {
+            if (row[j] != 0.0) {
+                *kl = i - j;
+                break;
+            }
+        }
+        for (int j = n - 1; j > i + *ku; j--) {
+            if (row[j] != 0.0) {
+                *ku = j - i;
+                break;
+            }
+        }
+        if (2 * *kl + *ku + 1 > max_width) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Chép phần băng của ma trận dense (row-major, bước lda) và vế phải b
+ */
+static inline void band_load(BandSystem *bs, const double *A, int lda, const double *b) {
+    int n = bs->n;
+    for (int j = 0; j < n; j++) {
+        int i0 = (j - bs->ku > 0) ? j - bs->ku : 0;
+        int i1 = (j + bs->kl < n - 1) ? j + bs->kl : n - 1;
+        for (int i = i0; i <= i1; i++) {
+            bs->AB[band_idx(bs, i, j)] = A[(size_t)i * lda + j];
+        }
+    }
+    memcpy(bs->b, b, n * sizeof(double));
+}
+
+/**
+ * Phần tử (i, j) trong băng của hệ test: ngẫu nhiên giả trong [-0.5, 0.5),
+ * đường chéo kl + ku + 1 (trội chéo yếu, vẫn có lúc phải đổi hàng)
+ */
+static inline double band_test_entry(const BandSystem *bs, int i, int j) {
+    if (i == j) {
+        return bs->kl + bs->ku + 1.0;
+    }
+    uint32_t h = ((uint32_t)i * 40503u + (uint32_t)j * 9973u + 1u) * 2654435761u;
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    return h / 4294967296.0 - 0.5;
+}
+
+/**
+ * Tạo hệ test trực tiếp trong lưu trữ băng (không cần ma trận dense):
+ * nghiệm x[i] = i + 1 như generate_test_system, b = A * x
+ */
+static inline void band_fill_test(BandSystem *bs) {
+    int n = bs->n;
+    memset(bs->b, 0, n * sizeof(double));
+    for (int j = 0; j < n; j++) {
+        int i0 = (j - bs->ku > 0) ? j - bs->ku : 0;
+        int i1 = (j + bs->kl < n - 1) ? j + bs->kl : n - 1;
+        for (int i = i0; i <= i1; i++) {
+            double a = band_test_entry(bs, i, j);
+            bs->AB[band_idx(bs, i, j)] = a;
+            bs->b[i] += a * (j + 1.0);
+        }
+    }
+}
+
+/**
+ * Phân tích panel cột j0 .. j0+jb-1 (dgbtf2 giới hạn trong panel): chọn pivot
+ * trong kl + 1 hàng, đổi hàng và cập nhật hạng 1 chỉ trên các cột của panel.
+ * *ju là cột xa nhất mà U đã chạm tới (tăng dần theo pivot); ju_step[j - j0]
+ * nhận giá trị của nó sau cột j. Trả về 0 nếu pivot ≈ 0.
+ */
+static inline int band_factor_panel(BandSystem *bs, int j0, int jb, int *ju, int *ju_step) {
+    int n = bs->n;
+    int j_end = j0 + jb;
+
+    for (int j = j0; j < j_end; j++) {
+        int km = (bs->kl < n - 1 - j) ? bs->kl : n - 1 - j;
+        double *col = bs->AB + band_idx(bs, j, j);
+
+        int jp = 0;
+        double max_val = fabs(col[0]);
+        for (int r = 1; r <= km; r++) {
+            if (fabs(col[r]) > max_val) {
+                max_val = fabs(col[r]);
+                jp = r;
+            }
+        }
+        if (max_val < 1e-12) {
+            return 0;
+        }
+        bs->ipiv[j] = j + jp;
+
+        int last = (j + bs->ku + jp < n - 1) ? j + bs->ku + jp : n - 1;
+        if (last > *ju) {
+            *ju = last;
+        }
+        ju_step[j - j0] = *ju;
+        int c_end = (*ju < j_end - 1) ? *ju + 1 : j_end;
+
+        if (jp != 0) {
+            for (int c = j; c < c_end; c++) {
+                double *p = bs->AB + band_idx(bs, j, c);
+                double *q = bs->AB + band_idx(bs, j + jp, c);
+                double tmp = *p;
+                *p = *q;
+                *q = tmp;
+            }
+        }
+        for (int r = 1; r <= km; r++) {
+            col[r] /= col[0];
+        }
+        for (int c = j + 1; c < c_end; c++) {
+            double u = bs->AB[band_idx(bs, j, c)];
+            if (u != 0.0) {
+                simd_axpy(km, -u, col + 1, bs->AB + band_idx(bs, j + 1, c));
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * Áp dụng các bước của panel (đổi hàng rồi cập nhật hạng 1) lên các cột
+ * col_begin .. col_end-1 sau panel. Mỗi cột chỉ đọc L của panel và ghi chính
+ * nó (liên tục trong AB) nên các cột độc lập, chia được cho các luồng.
+ * Bước j bỏ qua cột c > ju_step[j - j0]: các hàng j .. j+kl ở đó còn bằng 0.
+ */
+static inline void band_update_block(BandSystem *bs, int j0, int jb, const int *ju_step,
+                                     int col_begin, int col_end) {
+    int n = bs->n;
+    for (int c = col_begin; c < col_end; c++) {
+        for (int j = j0; j < j0 + jb; j++) {
+            if (ju_step[j - j0] < c) {
+                continue;
+            }
+            int km = (bs->kl < n - 1 - j) ? bs->kl : n - 1 - j;
+            double *a_jc = bs->AB + band_idx(bs, j, c);
+            int p = bs->ipiv[j];
+            if (p != j) {
+                double *a_pc = bs->AB + band_idx(bs, p, c);
+                double tmp = *a_jc;
+                *a_jc = *a_pc;
+                *a_pc = tmp;
+            }
+            if (*a_jc != 0.0) {
+                simd_axpy(km, -*a_jc, bs->AB + band_idx(bs, j + 1, j), a_jc + 1);
+            }
+        }
+    }
+}
+
+/**
+ * LU băng khối tuần tự có chọn pivot (dgbtrf): panel BAND_BLOCK cột rồi
+ * cập nhật các cột còn lại của cửa sổ
+ */
+static inline int band_factor(BandSystem *bs) {
+    int ju = 0;
+    int ju_step[BAND_BLOCK];
+    for (int j0 = 0; j0 < bs->n; j0 += BAND_BLOCK) {
+        int jb = (j0 + BAND_BLOCK < bs->n) ? BAND_BLOCK : bs->n - j0;
+        if (!band_factor_panel(bs, j0, jb, &ju, ju_step)) {
+            return 0;
+        }
+        band_update_block(bs, j0, jb, ju_step, j0 + jb, ju + 1);
+    }
+    return 1;
+}
+
+/**
+ * x = U^-1 * L^-1 * P * b bằng LU băng, O(n * (2*kl + ku))
+ */
+static inline void band_solve(BandSystem *bs) {
+    int n = bs->n;
+    int kv = bs->kl + bs->ku;
+    double *x = bs->x;
+    memcpy(x, bs->b, n * sizeof(double));
+
+    for (int j = 0; j < n - 1; j++) {
+        int km = (bs->kl < n - 1 - j) ? bs->kl : n - 1 - j;
+        int p = bs->ipiv[j];
+        if (p != j) {
+            double tmp = x[j];
+            x[j] = x[p];
+            x[p] = tmp;
+        }
+        simd_axpy(km, -x[j], bs->AB + band_idx(bs, j + 1, j), x + j + 1);
+    }
+
+    // U có kl + ku đường chéo trên, duyệt theo cột (liên tục trong AB)
+    for (int j = n - 1; j >= 0; j--) {
+        x[j] /= bs->AB[band_idx(bs, j, j)];
+        int i0 = (j - kv > 0) ? j - kv : 0;
+        simd_axpy(j - i0, -x[j], bs->AB + band_idx(bs, i0, j), x + i0);
+    }
+}
+
+/**
+ * Sai số ngược chuẩn hóa ||A*x - b|| / (||A|| * ||x|| + ||b||) (chuẩn vô
+ * cùng); AB là bản sao lưu trữ băng của A trước khi phân tích
+ */
+static inline double band_backward_error(const BandSystem *bs, const double *AB) {
+    int n = bs->n;
+    double *r = calloc(n, sizeof(double));
+    double *row_sum = calloc(n, sizeof(double));
+
+    for (int j = 0; j < n; j++) {
+        int i0 = (j - bs->ku > 0) ? j - bs->ku : 0;
+        int i1 = (j + bs->kl < n - 1) ? j + bs->kl : n - 1;
+        for (int i = i0; i <= i1; i++) {
+            double a = AB[band_idx(bs, i, j)];
+            r[i] += a * bs->x[j];
+            row_sum[i] += fabs(a);
+        }
+    }
+
+    double norm_a = 0.0, norm_x = 0.0, norm_b = 0.0, norm_r = 0.0;
+    for (int i = 0; i < n; i++) {
+        if (row_sum[i] > norm_a) norm_a = row_sum[i];
+        if (fabs(bs->x[i]) > norm_x) norm_x = fabs(bs->x[i]);
+        if (fabs(bs->b[i]) > norm_b) norm_b = fabs(bs->b[i]);
+        if (fabs(r[i] - bs->b[i]) > norm_r) norm_r = fabs(r[i] - bs->b[i]);
+    }
+
+    free(r);
+    free(row_sum);
+    return norm_r / (norm_a * norm_x + norm_b);
+}
+
+#endif /* GAUSS_BAND_H */
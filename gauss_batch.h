@@ -0,0 +1,317 @@
+/**
+ * GAUSS BATCH - GIẢI HÀNG LOẠT HỆ NHỎ CÙNG KÍCH THƯỚC
+ * Bố cục xen kẽ (SoA theo nhóm): BATCH_LANES hệ liên tiếp tạo một nhóm, phần
+ * tử (i, j) của các hệ trong nhóm nằm liền nhau nên mỗi phép toán của khử
+ * Gauss là một phép toán vector trên BATCH_LANES hệ cùng lúc.
+ *
+ * Dùng: batch_create(n, count) -> ghi A/b qua batch_a / batch_b ->
+ * batch_init() -> batch_solve_groups(bs, 0, bs->groups) -> đọc nghiệm qua
+ * batch_x, trạng thái trong info. batch_kernel là riêng của từng file .c nên
+ * batch_init gọi trong chính file gọi batch_solve_groups. Mỗi nhóm độc lập
+ * nên các engine song song chia dải nhóm cho các luồng.
+ */
+
+#ifndef GAUSS_BATCH_H
+#define GAUSS_BATCH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gauss_simd.h"
+
+// Số hệ trong một nhóm: 8 double = 64 byte = một cache line / một vector AVX-512
+#define BATCH_LANES 8
+
+// Vector BATCH_LANES double (GCC tự tách thành SSE2/AVX2 khi CPU hẹp hơn)
+typedef double batch_vec __attribute__((vector_size(BATCH_LANES * sizeof(double))));
+typedef long long batch_mask __attribute__((vector_size(BATCH_LANES * sizeof(double))));
+
+// Lô count hệ n x n: mỗi nhóm giữ A (n*n phần tử), b, x (n phần tử), mỗi phần
+// tử là BATCH_LANES double của các hệ liên tiếp
+typedef struct {
+    double *A;      // groups * n * n * BATCH_LANES, căn lề 64 byte
+    double *b;      // groups * n * BATCH_LANES (bị ghi đè khi khử)
+    double *x;      // groups * n * BATCH_LANES
+    int *info;      // 0: giải được; k + 1: suy biến ở cột k
+    int n;          // Kích thước mỗi hệ
+    int count;      // Số hệ thật
+    int groups;     // Số nhóm (hệ đệm ở nhóm cuối là ma trận đơn vị)
+} BatchSystem;
+
+/**
+ * Vị trí phần tử (i, j) của hệ s trong A
+ */
+static inline size_t batch_index(const BatchSystem *bs, int s, int i, int j) {
+    return (((size_t)(s / BATCH_LANES) * bs->n + i) * bs->n + j) * BATCH_LANES + s % BATCH_LANES;
+}
+
+static inline double* batch_a(BatchSystem *bs, int s, int i, int j) {
+    return bs->A + batch_index(bs, s, i, j);
+}
+
+static inline double* batch_b(BatchSystem *bs, int s, int i) {
+    return bs->b + ((size_t)(s / BATCH_LANES) * bs->n + i) * BATCH_LANES + s % BATCH_LANES;
+}
+
+static inline double* batch_x(BatchSystem *bs, int s, int i) {
+    return bs->x + ((size_t)(s / BATCH_LANES) * bs->n + i) * BATCH_LANES + s % BATCH_LANES;
+}
+
+/**
+ * Tạo lô count hệ n x n: một khối nhớ căn lề cho cả A, b, x thay vì n + 3
+ * lần malloc cho mỗi hệ. Hệ đệm được khởi tạo là ma trận đơn vị.
+ */
+static inline BatchSystem* batch_create(int n, int count) {
+    BatchSystem *bs = malloc(sizeof(BatchSystem));
+    bs->n = n;
+    bs->count = count;
+    bs->groups = (count + BATCH_LANES - 1) / BATCH_LANES;
+
+    size_t a_len = (size_t)bs->groups * n * n * BATCH_LANES;
+    size_t v_len = (size_t)bs->groups * n * BATCH_LANES;
+    if (posix_memalign((void**)&bs->A, 64, (a_len + 2 * v_len) * sizeof(double)) != 0) {
+        free(bs);
+        return NULL;
+    }
+    memset(bs->A, 0, (a_len + 2 * v_len) * sizeof(double));
+    bs->b = bs->A + a_len;
+    bs->x = bs->b + v_len;
+    bs->info = calloc(count, sizeof(int));
+
+    for (int s = count; s < bs->groups * BATCH_LANES; s++) {
+        for (int i = 0; i < n; i++) {
+            *batch_a(bs, s, i, i) = 1.0;
+        }
+    }
+    return bs;
+}
+
+static inline void batch_free(BatchSystem *bs) {
+    if (!bs) return;
+
+    free(bs->A);
+    free(bs->info);
+    free(bs);
+}
+
+#define BATCH_LOAD(p) (*(batch_vec*)(p))
+#define BATCH_STORE(p, v) (*(batch_vec*)(p) = (v))
+
+/**
+ * Khử Gauss có chọn pivot cho một nhóm BATCH_LANES hệ. Mỗi hệ có pivot riêng:
+ * tìm pivot bằng so sánh vector, đổi hàng từng lane (chỉ lane cần đổi), còn
+ * khử và thế ngược là phép toán vector trên cả nhóm.
+ */
+static inline __attribute__((always_inline))
+void batch_group_body(double *A, double *b, double *x, int *info, int n, int lanes) {
+    const batch_mask sign = (batch_mask){ 0 } + 0x7fffffffffffffffLL;
+    int singular[BATCH_LANES] = { 0 };
+
+    for (int k = 0; k < n; k++) {
+        // Tìm pivot theo từng lane: |A[i][k]| lớn nhất với i >= k
+        batch_vec best = (batch_vec)((batch_mask)BATCH_LOAD(A + ((size_t)k * n + k) * BATCH_LANES) & sign);
+        batch_mask piv = (batch_mask){ 0 } + k;
+        for (int i = k + 1; i < n; i++) {
+            batch_vec v = (batch_vec)((batch_mask)BATCH_LOAD(A + ((size_t)i * n + k) * BATCH_LANES) & sign);
+            batch_mask gt = v > best;
+            best = (batch_vec)(((batch_mask)v & gt) | ((batch_mask)best & ~gt));
+            piv = (piv & ~gt) | (((batch_mask){ 0 } + i) & gt);
+        }
+
+        // Đổi hàng k và hàng pivot của lane cần đổi (O(n) mỗi lane)
+        for (int l = 0; l < BATCH_LANES; l++) {
+            int p = (int)piv[l];
+            if (best[l] < 1e-12 && !singular[l]) {
+                singular[l] = k + 1;
+            }
+            if (p == k) {
+                continue;
+            }
+            for (int j = k; j < n; j++) {
+                double *ak = A + ((size_t)k * n + j) * BATCH_LANES + l;
+                double *ap = A + ((size_t)p * n + j) * BATCH_LANES + l;
+                double tmp = *ak;
+                *ak = *ap;
+                *ap = tmp;
+            }
+            double tmp = b[k * BATCH_LANES + l];
+            b[k * BATCH_LANES + l] = b[p * BATCH_LANES + l];
+            b[p * BATCH_LANES + l] = tmp;
+        }
+
+        // Khử: cả nhóm cùng lúc
+        const double *row_k = A + (size_t)k * n * BATCH_LANES;
+        batch_vec inv = 1.0 / BATCH_LOAD(row_k + k * BATCH_LANES);
+        batch_vec bk = BATCH_LOAD(b + k * BATCH_LANES);
+        for (int i = k + 1; i < n; i++) {
+            double *row_i = A + (size_t)i * n * BATCH_LANES;
+            batch_vec factor = BATCH_LOAD(row_i + k * BATCH_LANES) * inv;
+            for (int j = k + 1; j < n; j++) {
+                BATCH_STORE(row_i + j * BATCH_LANES,
+                            BATCH_LOAD(row_i + j * BATCH_LANES) - factor * BATCH_LOAD(row_k + j * BATCH_LANES));
+            }
+            BATCH_STORE(b + i * BATCH_LANES, BATCH_LOAD(b + i * BATCH_LANES) - factor * bk);
+        }
+    }
+
+    // Thế ngược
+    for (int i = n - 1; i >= 0; i--) {
+        const double *row_i = A + (size_t)i * n * BATCH_LANES;
+        batch_vec sum = BATCH_LOAD(b + i * BATCH_LANES);
+        for (int j = i + 1; j < n; j++) {
+            sum -= BATCH_LOAD(row_i + j * BATCH_LANES) * BATCH_LOAD(x + j * BATCH_LANES);
+        }
+        BATCH_STORE(x + i * BATCH_LANES, sum / BATCH_LOAD(row_i + i * BATCH_LANES));
+    }
+
+    for (int l = 0; l < lanes; l++) {
+        info[l] = singular[l];
+    }
+}
+
+typedef void (*BatchGroupKernel)(double *A, double *b, double *x, int *info, int n, int lanes);
+
+static inline void batch_group_generic(double *A, double *b, double *x, int *info, int n, int lanes) {
+    batch_group_body(A, b, x, info, n, lanes);
+}
+
+#ifdef GAUSS_SIMD_X86
+__attribute__((target("avx2,fma")))
+static inline void batch_group_avx2(double *A, double *b, double *x, int *info, int n, int lanes) {
+    batch_group_body(A, b, x, info, n, lanes);
+}
+
+__attribute__((target("avx512f")))
+static inline void batch_group_avx512(double *A, double *b, double *x, int *info, int n, int lanes) {
+    batch_group_body(A, b, x, info, n, lanes);
+}
+#endif
+
+static BatchGroupKernel batch_kernel = batch_group_generic;
+
+/**
+ * Chọn kernel nhóm theo kernel SIMD đã chọn (gọi sau simd_init, trước khi tạo luồng)
+ */
+static inline void batch_init(void) {
+    batch_kernel = batch_group_generic;
+#ifdef GAUSS_SIMD_X86
+    if (simd_kernels.axpy == axpy_avx512) {
+        batch_kernel = batch_group_avx512;
+    } else if (simd_kernels.axpy == axpy_avx2) {
+        batch_kernel = batch_group_avx2;
+    }
+#endif
+}
+
+/**
+ * Giải các nhóm [g_begin, g_end); các nhóm không dùng chung dữ liệu
+ */
+static inline void batch_solve_groups(BatchSystem *bs, int g_begin, int g_end) {
+    int n = bs->n;
+    for (int g = g_begin; g < g_end; g++) {
+        int lanes = bs->count - g * BATCH_LANES;
+        if (lanes > BATCH_LANES) {
+            lanes = BATCH_LANES;
+        }
+        batch_kernel(bs->A + (size_t)g * n * n * BATCH_LANES,
+                     bs->b + (size_t)g * n * BATCH_LANES,
+                     bs->x + (size_t)g * n * BATCH_LANES,
+                     bs->info + (size_t)g * BATCH_LANES, n, lanes);
+    }
+}
+
+/**
+ * Phần tử (i, j) của hệ test thứ s: giả ngẫu nhiên trong [-0.5, 0.5), không
+ * trội đường chéo nên pivot thực sự đổi hàng
+ */
+static inline double batch_test_entry(int s, int i, int j) {
+    uint32_t h = (uint32_t)s * 2654435761u ^ (uint32_t)(i * 40503 + j * 9973 + 1);
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    h *= 3266489917u;
+    h ^= h >> 16;
+    return h / 4294967296.0 - 0.5;
+}
+
+/**
+ * Nghiệm đúng của hệ test thứ s
+ */
+static inline double batch_test_solution(int s, int i) {
+    return 1.0 + (i + s) % 10;
+}
+
+/**
+ * Vế phải b = A * x của hệ test thứ s
+ */
+static inline double batch_test_rhs(int s, int i, int n) {
+    double sum = 0.0;
+    for (int j = 0; j < n; j++) {
+        sum += batch_test_entry(s, i, j) * batch_test_solution(s, j);
+    }
+    return sum;
+}
+
+/**
+ * Tạo các hệ test [s_begin, s_end) của lô
+ */
+static inline void batch_fill_test(BatchSystem *bs, int s_begin, int s_end) {
+    int n = bs->n;
+    for (int s = s_begin; s < s_end; s++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                *batch_a(bs, s, i, j) = batch_test_entry(s, i, j);
+            }
+            *batch_b(bs, s, i) = batch_test_rhs(s, i, n);
+        }
+    }
+}
+
+/**
+ * Sai số ngược chuẩn hóa lớn nhất ||A*x - b|| / (||A|| * ||x|| + ||b||) (chuẩn
+ * vô cùng) trên các hệ test giải được; *singular nhận số hệ suy biến.
+ * Không phụ thuộc số điều kiện như sai số so với nghiệm đúng.
+ */
+static inline double batch_verify_test(BatchSystem *bs, int *singular) {
+    int n = bs->n;
+    double max_error = 0.0;
+    *singular = 0;
+
+    for (int s = 0; s < bs->count; s++) {
+        if (bs->info[s]) {
+            (*singular)++;
+            continue;
+        }
+        double norm_a = 0.0, norm_x = 0.0, norm_b = 0.0, norm_r = 0.0;
+        for (int i = 0; i < n; i++) {
+            double row_sum = 0.0, ax = 0.0;
+            for (int j = 0; j < n; j++) {
+                double a = batch_test_entry(s, i, j);
+                row_sum += fabs(a);
+                ax += a * *batch_x(bs, s, j);
+            }
+            double bi = batch_test_rhs(s, i, n);
+            double r = fabs(ax - bi);
+            if (row_sum > norm_a) {
+                norm_a = row_sum;
+            }
+            if (fabs(*batch_x(bs, s, i)) > norm_x) {
+                norm_x = fabs(*batch_x(bs, s, i));
+            }
+            if (fabs(bi) > norm_b) {
+                norm_b = fabs(bi);
+            }
+            if (r > norm_r || r != r) {
+                norm_r = r;
+            }
+        }
+        double error = norm_r / (norm_a * norm_x + norm_b);
+        if (error > max_error || error != error) {
+            max_error = error;
+        }
+    }
+    return max_error;
+}
+
+#endif /* GAUSS_BATCH_H */
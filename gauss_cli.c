@@ -0,0 +1,133 @@
+/**
+ * GAUSS CLI - CHƯƠNG TRÌNH MỎNG TRÊN LIBGAUSS
+ * Chỉ dùng API trong gauss.h: sinh hệ test vào bộ đệm của chương trình, giải
+ * bằng gauss_solve (engine tự chọn hoặc --engine) rồi kiểm tra sai số ngược
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gauss.h"
+
+int main(int argc, char *argv[]) {
+    int n = 1000;  // Kích thước mặc định
+    GaussOptions opt;
+    gauss_options_init(&opt);
+    
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--engine") == 0 && a + 1 < argc) {
+            const char *name = argv[++a];
+            int found = 0;
+            for (int e = GAUSS_ENGINE_AUTO; e <= GAUSS_ENGINE_MPI; e++) {
+                if (strcmp(name, gauss_engine_name((GaussEngine)e)) == 0) {
+                    opt.engine = (GaussEngine)e;
+                    found = 1;
+                }
+            }
+            if (!found) {
+                printf("Engine không hợp lệ: %s\n", name);
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            opt.num_threads = atoi(argv[++a]);
+            if (opt.num_threads <= 0) {
+                printf("Số luồng phải > 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--block") == 0 && a + 1 < argc) {
+            opt.block_size = atoi(argv[++a]);
+            if (opt.block_size < 0) {
+                printf("Kích thước khối phải >= 0\n");
+                return 1;
+            }
+        } else if (argv[a][0] == '-') {
+            printf("Tham số không hợp lệ: %s\n", argv[a]);
+            printf("Dùng: %s [n] [--engine auto|sequential|openmp|pthread|mpi]\n"
+                   "          [--threads t] [--block nb]\n", argv[0]);
+            return 1;
+        } else {
+            n = atoi(argv[a]);
+            if (n <= 0) {
+                printf("Kích thước ma trận phải > 0\n");
+                return 1;
+            }
+        }
+    }
+    
+    if (!gauss_engine_available(opt.engine)) {
+        printf("❌ Engine %s không có trong bản build libgauss\n", gauss_engine_name(opt.engine));
+        return 1;
+    }
+    
+    // Engine MPI: mọi process cùng giải, chỉ process 0 in kết quả
+    int rank = 0;
+    if (opt.engine == GAUSS_ENGINE_MPI && gauss_mpi_init(&argc, &argv, &rank) != GAUSS_OK) {
+        printf("❌ Không khởi tạo được MPI\n");
+        return 1;
+    }
+    
+    // Bộ đệm của chương trình, libgauss giải tại chỗ không sao chép
+    int lda = gauss_lda(n);
+    double *A = NULL;
+    if (posix_memalign((void**)&A, 64, (size_t)n * lda * sizeof(double)) != 0) {
+        A = NULL;
+    }
+    double *b = malloc(n * sizeof(double));
+    double *b0 = malloc(n * sizeof(double));
+    double *x = malloc(n * sizeof(double));
+    if (!A || !b || !b0 || !x) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận %d x %d\n", n, n);
+        free(A);
+        free(b);
+        free(b0);
+        free(x);
+        gauss_mpi_finalize();
+        return 1;
+    }
+    
+    if (gauss_test_system(n, A, lda, b) != GAUSS_OK) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận %d x %d\n", n, n);
+        free(A);
+        free(b);
+        free(b0);
+        free(x);
+        gauss_mpi_finalize();
+        return 1;
+    }
+    memcpy(b0, b, n * sizeof(double));
+    
+    GaussInfo info;
+    int rc = gauss_solve(n, A, lda, b, x, NULL, &opt, &info);
+    
+    int success = (rc == GAUSS_OK);
+    if (rank == 0) {
+        printf("🧮 GAUSSIAN ELIMINATION - LIBGAUSS\n");
+        printf("Kích thước ma trận: %d x %d\n", n, n);
+        printf("Engine: %s (%d %s)\n\n", gauss_engine_name(info.engine), info.num_threads,
+               (info.engine == GAUSS_ENGINE_MPI) ? "processes" : "luồng");
+    
+        if (success) {
+            printf("✅ Giải thành công!\n");
+            printf("⏱️  Thời gian thực hiện: %.6f giây\n", info.time);
+    
+            // A đã bị ghi đè bởi L\U: kiểm tra trên hệ test sinh lại
+            double error = gauss_backward_error(n, NULL, 0, b0, x);
+            if (error < 1e-10) {
+                printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+            } else {
+                printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+                success = 0;
+            }
+        } else {
+            printf("❌ Giải thất bại: %s\n", gauss_strerror(rc));
+        }
+    }
+    
+    free(A);
+    free(b);
+    free(b0);
+    free(x);
+    gauss_mpi_finalize();
+    
+    return success ? 0 : 1;
+}
@@ -0,0 +1,411 @@
+/**
+ * GAUSS CORE - PHẦN LÕI DÙNG CHUNG CỦA CÁC ENGINE BỘ NHỚ CHUNG
+ * Tạo / bọc / giải phóng LinearSystem, thế xuôi/ngược bằng LU đã phân tích
+ * (một và nhiều vế phải), cập nhật khối của LU và các vế phải thêm (--rhs).
+ * Chỉ biên dịch một lần: engine tuần tự / OpenMP / Pthread và các chương
+ * trình sequential / openmp / pthread cùng link bản này qua libgauss.a.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gauss_core.h"
+
+/**
+ * Tạo hệ phương trình mới với kích thước n x n, NULL nếu hết bộ nhớ
+ */
+LinearSystem* create_system(int n) {
+    LinearSystem *sys = malloc(sizeof(LinearSystem));
+    if (!sys) {
+        return NULL;
+    }
+    sys->n = n;
+    
+    // Pad mỗi hàng lên bội số 8 double để đầu mọi hàng đều căn lề 64 byte.
+    // Tránh bước hàng là bội số 4KB (n lũy thừa 2) gây xung đột cache set
+    // khi duyệt theo cột (tìm pivot).
+    sys->lda = (n + 7) & ~7;
+    if (sys->lda % 512 == 0) {
+        sys->lda += 8;
+    }
+    
+    if (posix_memalign((void**)&sys->A, MATRIX_ALIGN,
+                       (size_t)n * sys->lda * sizeof(double)) != 0) {
+        free(sys);
+        return NULL;
+    }
+    
+    sys->perm = malloc(n * sizeof(int));
+    sys->origin = malloc(n * sizeof(int));
+    sys->b = malloc(n * sizeof(double));
+    sys->x = malloc(n * sizeof(double));
+    sys->file = NULL;
+    if (!sys->perm || !sys->origin || !sys->b || !sys->x) {
+        free_system(sys);
+        return NULL;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        sys->perm[i] = i;
+        sys->origin[i] = i;
+    }
+    
+    return sys;
+}
+
+/**
+ * Giải phóng bộ nhớ
+ */
+void free_system(LinearSystem *sys) {
+    if (!sys) return;
+    
+    if (sys->file) {
+        gauss_io_unmap(sys->file);
+        free(sys->file);
+    } else {
+        free(sys->A);
+        free(sys->b);
+    }
+    free(sys->perm);
+    free(sys->origin);
+    free(sys->x);
+    free(sys);
+}
+
+/**
+ * Hệ từ file --input đã map: A và b trỏ thẳng vào vùng map (MAP_PRIVATE nên
+ * LU ghi đè tại chỗ không sửa file), chỉ cấp phát perm, origin và x.
+ * NULL nếu hết bộ nhớ (file vẫn thuộc caller).
+ */
+LinearSystem* map_system(GaussFile *file) {
+    LinearSystem *sys = malloc(sizeof(LinearSystem));
+    if (!sys) {
+        return NULL;
+    }
+    int n = (int)file->hdr.n;
+    sys->n = n;
+    sys->lda = (int)file->hdr.lda;
+    sys->A = file->A;
+    sys->b = file->b;
+    sys->file = file;
+    
+    sys->perm = malloc(n * sizeof(int));
+    sys->origin = malloc(n * sizeof(int));
+    sys->x = malloc(n * sizeof(double));
+    if (!sys->perm || !sys->origin || !sys->x) {
+        free(sys->perm);
+        free(sys->origin);
+        free(sys->x);
+        free(sys);
+        return NULL;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        sys->perm[i] = i;
+        sys->origin[i] = i;
+    }
+    
+    return sys;
+}
+
+/**
+ * Trả lại phần wrap_system đã cấp phát (perm: mảng caller truyền, NULL được)
+ */
+void unwrap_system(LinearSystem *sys, const int *perm) {
+    if (!perm) {
+        free(sys->perm);
+    }
+    free(sys->origin);
+}
+
+/**
+ * Hệ bọc thẳng bộ đệm của caller cho engine libgauss (gauss.h) như
+ * map_system: chỉ cấp phát origin (và perm khi caller không truyền).
+ * Trả về 0 nếu hết bộ nhớ.
+ */
+int wrap_system(LinearSystem *sys, int n, double *A, int lda, double *b, double *x, int *perm) {
+    sys->A = A;
+    sys->lda = lda;
+    sys->b = b;
+    sys->x = x;
+    sys->n = n;
+    sys->file = NULL;
+    sys->perm = perm ? perm : malloc(n * sizeof(int));
+    sys->origin = malloc(n * sizeof(int));
+    if (!sys->perm || !sys->origin) {
+        unwrap_system(sys, perm);
+        return 0;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        sys->perm[i] = i;
+        sys->origin[i] = i;
+    }
+    return 1;
+}
+
+/**
+ * b = A * x với x[i] = i + 1 như hệ test (A nạp từ file .mtx)
+ */
+void fill_test_rhs(LinearSystem *sys) {
+    int n = sys->n;
+    double *true_x = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        true_x[i] = i + 1.0;
+    }
+    for (int i = 0; i < n; i++) {
+        sys->b[i] = simd_dot(n, row_ptr(sys, i), true_x);
+    }
+    free(true_x);
+}
+
+/**
+ * Giải tam giác dưới với L đơn vị tại chỗ: y <- L^-1 * y
+ */
+void solve_lower(LinearSystem *sys, double *y) {
+    int n = sys->n;
+    
+    for (int i = 1; i < n; i++) {
+        y[i] -= simd_dot(i, row_ptr(sys, i), y);
+    }
+}
+
+/**
+ * Giải tam giác trên: x <- U^-1 * y (x có thể trùng y)
+ */
+void solve_upper(LinearSystem *sys, const double *y, double *x) {
+    int n = sys->n;
+    
+    for (int i = n - 1; i >= 0; i--) {
+        double *row_i = row_ptr(sys, i);
+        
+        // Trừ đi các phần tử đã biết, chia cho hệ số của ẩn x[i]
+        x[i] = (y[i] - simd_dot(n - i - 1, row_i + i + 1, x + i + 1)) / row_i[i];
+    }
+}
+
+/**
+ * Giải tam giác cho khối hàng U12: U12 = L11^-1 * A12 (cột col_begin .. col_end-1)
+ */
+void update_row_block(LinearSystem *sys, int k0, int kb, int col_begin, int col_end) {
+    for (int i = k0 + 1; i < k0 + kb; i++) {
+        double *row_i = row_ptr(sys, i);
+        
+        for (int p = k0; p < i; p++) {
+            double *row_p = row_ptr(sys, p);
+            simd_axpy(col_end - col_begin, -row_i[p], row_p + col_begin, row_i + col_begin);
+        }
+    }
+}
+
+/**
+ * Cập nhật một khối A[row_begin:row_end, col_begin:col_end] -= L21 * U12
+ * (L21 là cột k0 .. k0+kb-1 của các hàng đích, U12 là hàng k0 .. k0+kb-1).
+ * Gộp 4 hàng U mỗi lượt để giảm số lần đọc/ghi hàng đích.
+ */
+void update_tile(LinearSystem *sys, int k0, int kb, int row_begin, int row_end,
+                 int col_begin, int col_end) {
+    int k_end = k0 + kb;
+    int len = col_end - col_begin;
+    
+    for (int i = row_begin; i < row_end; i++) {
+        double *row_i = row_ptr(sys, i);
+        int p = k0;
+        
+        for (; p + 3 < k_end; p += 4) {
+            double l[4] = { -row_i[p], -row_i[p+1], -row_i[p+2], -row_i[p+3] };
+            simd_axpy4(len, l,
+                       row_ptr(sys, p) + col_begin, row_ptr(sys, p+1) + col_begin,
+                       row_ptr(sys, p+2) + col_begin, row_ptr(sys, p+3) + col_begin,
+                       row_i + col_begin);
+        }
+        for (; p < k_end; p++) {
+            simd_axpy(len, -row_i[p], row_ptr(sys, p) + col_begin, row_i + col_begin);
+        }
+    }
+}
+
+/**
+ * Cập nhật ma trận con A22 -= L21 * U12 cho các hàng row_begin .. row_end-1.
+ * Duyệt theo lát cột để khối U12 (kb x UPDATE_COL_CHUNK) nằm trong cache.
+ */
+void update_trailing(LinearSystem *sys, int k0, int kb, int row_begin, int row_end) {
+    int n = sys->n;
+    
+    for (int jc = k0 + kb; jc < n; jc += UPDATE_COL_CHUNK) {
+        int jc_end = (jc + UPDATE_COL_CHUNK < n) ? jc + UPDATE_COL_CHUNK : n;
+        update_tile(sys, k0, kb, row_begin, row_end, jc, jc_end);
+    }
+}
+
+/**
+ * Giải A*x = rhs trong O(n²) bằng LU đã phân tích: x = U^-1 * L^-1 * P * rhs.
+ * rhs theo thứ tự hàng gốc và không bị sửa. Dùng origin thay vì perm vì chế
+ * độ tile của OpenMP đổi dữ liệu hàng thật, perm không còn phản ánh hoán vị.
+ */
+void lu_solve(LinearSystem *sys, const double *rhs, double *x) {
+    int n = sys->n;
+    
+    for (int i = 0; i < n; i++) {
+        x[i] = rhs[sys->origin[i]];
+    }
+    solve_lower(sys, x);
+    solve_upper(sys, x, x);
+}
+
+/**
+ * Khối đường chéo của L (đơn vị): X[k0..k1) <- L11^-1 * X[k0..k1), cột c0..c1-1
+ */
+void trsm_lower_diag(LinearSystem *sys, int k0, int k1,
+                     double *X, int ldx, int c0, int c1) {
+    for (int i = k0 + 1; i < k1; i++) {
+        double *row_i = row_ptr(sys, i);
+        double *x_i = X + (size_t)i * ldx + c0;
+        for (int p = k0; p < i; p++) {
+            simd_axpy(c1 - c0, -row_i[p], X + (size_t)p * ldx + c0, x_i);
+        }
+    }
+}
+
+/**
+ * Khối đường chéo của U: X[k0..k1) <- U11^-1 * X[k0..k1), cột c0..c1-1
+ */
+void trsm_upper_diag(LinearSystem *sys, int k0, int k1,
+                     double *X, int ldx, int c0, int c1) {
+    for (int i = k1 - 1; i >= k0; i--) {
+        double *row_i = row_ptr(sys, i);
+        double *x_i = X + (size_t)i * ldx + c0;
+        for (int p = i + 1; p < k1; p++) {
+            simd_axpy(c1 - c0, -row_i[p], X + (size_t)p * ldx + c0, x_i);
+        }
+        double inv = 1.0 / row_i[i];
+        for (int c = 0; c < c1 - c0; c++) {
+            x_i[c] *= inv;
+        }
+    }
+}
+
+/**
+ * X[r0..r1) -= A[r0..r1, k0..k1) * X[k0..k1) trên cột c0..c1-1 (A là L hoặc U
+ * tùy phía). Cùng dạng với cập nhật ma trận con của LU: gộp 4 hàng X mỗi lượt,
+ * khối X[k0..k1) x (c1-c0) nằm trong cache suốt các hàng đích.
+ */
+void gemm_update_rhs(LinearSystem *sys, int k0, int k1, int r0, int r1,
+                     double *X, int ldx, int c0, int c1) {
+    int len = c1 - c0;
+    for (int i = r0; i < r1; i++) {
+        double *row_i = row_ptr(sys, i);
+        double *x_i = X + (size_t)i * ldx + c0;
+        int p = k0;
+        for (; p + 3 < k1; p += 4) {
+            double l[4] = { -row_i[p], -row_i[p+1], -row_i[p+2], -row_i[p+3] };
+            simd_axpy4(len, l,
+                       X + (size_t)p * ldx + c0, X + (size_t)(p+1) * ldx + c0,
+                       X + (size_t)(p+2) * ldx + c0, X + (size_t)(p+3) * ldx + c0, x_i);
+        }
+        for (; p < k1; p++) {
+            simd_axpy(len, -row_i[p], X + (size_t)p * ldx + c0, x_i);
+        }
+    }
+}
+
+/**
+ * Giải A*X = B cho m vế phải cùng lúc bằng LU đã phân tích. B, X là ma trận
+ * n x m row-major (bước ldb, ldx, không trùng nhau), B theo thứ tự hàng gốc.
+ * Thế xuôi/ngược theo khối SOLVE_BLOCK hàng x UPDATE_COL_CHUNK cột: mỗi hệ số
+ * L/U được đọc một lần cho cả lát cột thay vì một lần cho mỗi vế phải, phần
+ * lớn công việc là cập nhật dạng GEMM.
+ */
+void lu_solve_multi(LinearSystem *sys, const double *B, int ldb, double *X, int ldx, int m) {
+    int n = sys->n;
+    
+    for (int i = 0; i < n; i++) {
+        memcpy(X + (size_t)i * ldx, B + (size_t)sys->origin[i] * ldb, m * sizeof(double));
+    }
+    
+    for (int c0 = 0; c0 < m; c0 += UPDATE_COL_CHUNK) {
+        int c1 = (c0 + UPDATE_COL_CHUNK < m) ? c0 + UPDATE_COL_CHUNK : m;
+        
+        // Thế xuôi L*Y = P*B
+        for (int k0 = 0; k0 < n; k0 += SOLVE_BLOCK) {
+            int k1 = (k0 + SOLVE_BLOCK < n) ? k0 + SOLVE_BLOCK : n;
+            trsm_lower_diag(sys, k0, k1, X, ldx, c0, c1);
+            gemm_update_rhs(sys, k0, k1, k1, n, X, ldx, c0, c1);
+        }
+        
+        // Thế ngược U*X = Y
+        for (int k0 = ((n - 1) / SOLVE_BLOCK) * SOLVE_BLOCK; k0 >= 0; k0 -= SOLVE_BLOCK) {
+            int k1 = (k0 + SOLVE_BLOCK < n) ? k0 + SOLVE_BLOCK : n;
+            trsm_upper_diag(sys, k0, k1, X, ldx, c0, c1);
+            gemm_update_rhs(sys, k0, k1, 0, k0, X, ldx, c0, c1);
+        }
+    }
+}
+
+/**
+ * Nghiệm đúng thứ j của các vế phải thêm (--rhs)
+ */
+static inline double extra_solution(int i, int j) {
+    return 1.0 + (i + j) % 10;
+}
+
+/**
+ * Tạo count vế phải B = A * X_true (ma trận n x count row-major, cột j là
+ * vế phải thứ j) để thử giải nhiều lần với cùng A.
+ * Phải gọi trước khi A bị ghi đè bởi LU.
+ */
+double* generate_extra_rhs(LinearSystem *sys, int count) {
+    int n = sys->n;
+    double *rhs = malloc((size_t)n * count * sizeof(double));
+    double *x_j = malloc(n * sizeof(double));
+    
+    for (int j = 0; j < count; j++) {
+        for (int i = 0; i < n; i++) {
+            x_j[i] = extra_solution(i, j);
+        }
+        for (int i = 0; i < n; i++) {
+            rhs[(size_t)i * count + j] = simd_dot(n, row_ptr(sys, i), x_j);
+        }
+    }
+    
+    free(x_j);
+    return rhs;
+}
+
+/**
+ * Giải lần lượt từng vế phải (cột của B) bằng lu_solve, ghi nghiệm vào cột của X
+ */
+void solve_extra_rhs(LinearSystem *sys, const double *rhs, double *X, int count) {
+    int n = sys->n;
+    double *b = calloc(n, sizeof(double));
+    double *x = malloc(n * sizeof(double));
+    
+    for (int j = 0; j < count; j++) {
+        for (int i = 0; i < n; i++) {
+            b[i] = rhs[(size_t)i * count + j];
+        }
+        lu_solve(sys, b, x);
+        for (int i = 0; i < n; i++) {
+            X[(size_t)i * count + j] = x[i];
+        }
+    }
+    
+    free(b);
+    free(x);
+}
+
+/**
+ * Sai số lớn nhất của nghiệm X (n x count) so với nghiệm đúng
+ */
+double extra_rhs_error(const double *X, int n, int count) {
+    double max_error = 0.0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < count; j++) {
+            double error = fabs(X[(size_t)i * count + j] - extra_solution(i, j));
+            if (error > max_error) {
+                max_error = error;
+            }
+        }
+    }
+    return max_error;
+}
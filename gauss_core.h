@@ -0,0 +1,193 @@
+/**
+ * GAUSS CORE - PHẦN NỘI BỘ CỦA LIBGAUSS DÙNG CHUNG GIỮA ENGINE VÀ CHƯƠNG TRÌNH
+ * LinearSystem dense cùng các hàm lõi (gauss_core.c) và điểm vào của ba
+ * engine bộ nhớ chung (gauss_sequential.c, gauss_openmp.c, gauss_pthread.c).
+ * Các chương trình sequential / openmp / pthread chỉ giữ main, đọc tham số và
+ * in kết quả, phần tính toán nằm trong libgauss.a. Engine MPI: gauss_mpi.h.
+ *
+ * Hàm của thư viện không in gì: lỗi báo qua giá trị trả về (0 / NULL hoặc mã
+ * GAUSS_*), chương trình gọi tự in thông báo.
+ */
+
+#ifndef GAUSS_CORE_H
+#define GAUSS_CORE_H
+
+#include <stddef.h>
+#include "gauss_simd.h"
+#include "gauss_batch.h"
+#include "gauss_mixed.h"
+#include "gauss_band.h"
+#include "gauss_tridiag.h"
+#include "gauss_sparse.h"
+#include "gauss_ooc.h"
+#include "gauss_io.h"
+#include "gauss_mtx.h"
+#include "gauss_verify.h"
+#include "gauss.h"
+
+// Căn lề khối ma trận theo cache line (đủ cho cả AVX-512)
+#define MATRIX_ALIGN 64
+
+// Độ rộng panel mặc định cho LU khối (0 = khử Gauss cổ điển từng cột)
+#define DEFAULT_BLOCK_SIZE 64
+
+// Số cột mỗi lát khi cập nhật ma trận con (giữ khối U12 trong cache L2)
+#define UPDATE_COL_CHUNK 256
+
+// Số hàng mỗi khối khi thế xuôi/ngược cho nhiều vế phải
+#define SOLVE_BLOCK 64
+
+// Số bước panel được chạy trước phần cập nhật còn lại (OpenMP --tile)
+#define DEFAULT_LOOKAHEAD 1
+
+// Giới hạn tile (OpenMP --tile): mỗi bước tạo O(nt²) task và phụ thuộc, tile
+// nhỏ hơn TILE_MIN_SIZE bị từ chối, số tile mỗi chiều không vượt TILE_MAX_COUNT
+#define TILE_MIN_SIZE 16
+#define TILE_MAX_COUNT 64
+
+// Cấu trúc lưu trữ hệ phương trình
+typedef struct {
+    double *A;      // Ma trận hệ số n x n, một khối liên tục row-major
+    int lda;        // Leading dimension: khoảng cách (phần tử) giữa 2 hàng vật lý
+    int *perm;      // Hoán vị hàng: hàng logic i nằm ở hàng vật lý perm[i]
+    int *origin;    // Hàng gốc (trước pivoting) của hàng logic i, đổi cùng b
+    double *b;      // Vector hằng số (theo thứ tự hàng logic)
+    double *x;      // Vector nghiệm
+    int n;          // Kích thước ma trận
+    GaussFile *file;  // File --input đã map (A, b trỏ vào vùng map), NULL nếu tự cấp phát
+} LinearSystem;
+
+/**
+ * Con trỏ tới đầu hàng logic i (đi qua vector hoán vị)
+ */
+static inline double* row_ptr(LinearSystem *sys, int i) {
+    return sys->A + (size_t)sys->perm[i] * sys->lda;
+}
+
+/**
+ * Đổi chỗ b và hàng gốc của hai hàng logic (phần dùng chung của mọi kiểu hoán đổi)
+ */
+static inline void swap_rhs(LinearSystem *sys, int r1, int r2) {
+    double tmp_b = sys->b[r1];
+    sys->b[r1] = sys->b[r2];
+    sys->b[r2] = tmp_b;
+
+    int tmp_origin = sys->origin[r1];
+    sys->origin[r1] = sys->origin[r2];
+    sys->origin[r2] = tmp_origin;
+}
+
+/**
+ * Hoán đổi hai hàng logic trong O(1): chỉ đổi chỉ số hoán vị và b
+ */
+static inline void swap_rows(LinearSystem *sys, int r1, int r2) {
+    int tmp_perm = sys->perm[r1];
+    sys->perm[r1] = sys->perm[r2];
+    sys->perm[r2] = tmp_perm;
+
+    swap_rhs(sys, r1, r2);
+}
+
+/**
+ * Tile thực dùng cho ma trận n x n: nới tile để có tối đa TILE_MAX_COUNT tile
+ * mỗi chiều (n lớn với tile nhỏ làm DAG phình theo nt²)
+ */
+static inline int tile_size_clamp(int n, int tile_size) {
+    int min_tile = (n + TILE_MAX_COUNT - 1) / TILE_MAX_COUNT;
+    return (tile_size < min_tile) ? min_tile : tile_size;
+}
+
+/* ============ Lõi dùng chung (gauss_core.c) ============ */
+
+LinearSystem* create_system(int n);
+void free_system(LinearSystem *sys);
+LinearSystem* map_system(GaussFile *file);
+int wrap_system(LinearSystem *sys, int n, double *A, int lda, double *b, double *x, int *perm);
+void unwrap_system(LinearSystem *sys, const int *perm);
+void fill_test_rhs(LinearSystem *sys);
+
+void solve_lower(LinearSystem *sys, double *y);
+void solve_upper(LinearSystem *sys, const double *y, double *x);
+void update_row_block(LinearSystem *sys, int k0, int kb, int col_begin, int col_end);
+void update_tile(LinearSystem *sys, int k0, int kb, int row_begin, int row_end,
+                 int col_begin, int col_end);
+void update_trailing(LinearSystem *sys, int k0, int kb, int row_begin, int row_end);
+void lu_solve(LinearSystem *sys, const double *rhs, double *x);
+void trsm_lower_diag(LinearSystem *sys, int k0, int k1,
+                     double *X, int ldx, int c0, int c1);
+void trsm_upper_diag(LinearSystem *sys, int k0, int k1,
+                     double *X, int ldx, int c0, int c1);
+void gemm_update_rhs(LinearSystem *sys, int k0, int k1, int r0, int r1,
+                     double *X, int ldx, int c0, int c1);
+void lu_solve_multi(LinearSystem *sys, const double *B, int ldb, double *X, int ldx, int m);
+
+double* generate_extra_rhs(LinearSystem *sys, int count);
+void solve_extra_rhs(LinearSystem *sys, const double *rhs, double *X, int count);
+double extra_rhs_error(const double *X, int n, int count);
+
+/* ============ Engine tuần tự (gauss_sequential.c) ============ */
+
+void generate_test_system(LinearSystem *sys);
+double verify_solution(const VerifySource *src, const double *x);
+int lu_factor(LinearSystem *sys, int block_size);
+int gaussian_elimination(LinearSystem *sys, int block_size);
+int gaussian_elimination_mixed(LinearSystem *sys, int block_size, int *iterations, int *fallback);
+int block_tridiag_solve(BlockTridiag *bt, int block_size);
+
+/* ============ Engine OpenMP (gauss_openmp.c) ============ */
+
+void generate_test_system_openmp(LinearSystem *sys, int num_threads);
+double verify_solution_openmp(const VerifySource *src, const double *x, int num_threads);
+int lu_factor_openmp(LinearSystem *sys, int num_threads, int block_size,
+                     int tile_size, int lookahead);
+void lu_solve_multi_openmp(LinearSystem *sys, const double *B, int ldb, double *X, int ldx, int m);
+int gaussian_elimination_openmp(LinearSystem *sys, int num_threads, int block_size,
+                                int tile_size, int lookahead);
+int gaussian_elimination_mixed_openmp(LinearSystem *sys, int num_threads, int block_size,
+                                      int tile_size, int lookahead,
+                                      int *iterations, int *fallback);
+int tridiag_solve_openmp(TridiagSystem *ts, int num_threads);
+int sparse_factor_openmp(SparseLU *lu, int num_threads);
+int ooc_factor_openmp(OocMatrix *m, int num_threads);
+int block_tridiag_solve_openmp(BlockTridiag *bt, int block_size, int num_threads);
+int band_factor_openmp(BandSystem *bs, int num_threads);
+int mtx_read_openmp(const MtxFile *f, LinearSystem *sys, int *rows, int *cols, double *vals,
+                    int num_threads);
+void fill_test_rhs_openmp(LinearSystem *sys, int num_threads);
+void batch_solve_openmp(BatchSystem *bs, int num_threads);
+
+/* ============ Engine Pthread (gauss_pthread.c) ============ */
+
+// Thống kê chi phí của pool (báo cáo --breakdown)
+typedef struct {
+    double spawn_time;      // Tạo + join pool (một lần cho mỗi lần giải)
+    double barrier_time;    // Thời gian chờ barrier trung bình mỗi luồng
+    long barrier_count;     // Số lần qua barrier mỗi luồng
+    int num_threads;        // Số luồng thực tế
+} PoolStats;
+
+void generate_test_system_pthread(LinearSystem *sys, int num_threads);
+double verify_solution_pthread(const VerifySource *src, const double *x, int num_threads);
+int lu_factor_pthread(LinearSystem *sys, int num_threads, int block_size,
+                      int fused_pivot, PoolStats *stats);
+void lu_solve_multi_pthread(LinearSystem *sys, int num_threads,
+                            const double *B, int ldb, double *X, int ldx, int m);
+int gaussian_elimination_pthread(LinearSystem *sys, int num_threads, int block_size,
+                                 int fused_pivot, PoolStats *stats);
+int gaussian_elimination_mixed_pthread(LinearSystem *sys, int num_threads, int block_size,
+                                       int fused_pivot, int *iterations, int *fallback);
+int tridiag_solve_pthread(TridiagSystem *ts, int num_threads);
+int sparse_factor_pthread(SparseLU *lu, int num_threads);
+int ooc_factor_pthread(OocMatrix *m, int num_threads);
+int block_tridiag_solve_pthread(BlockTridiag *bt, int block_size, int num_threads);
+int band_factor_pthread(BandSystem *bs, int num_threads);
+int mtx_read_pthread(const MtxFile *f, LinearSystem *sys, int *rows, int *cols, double *vals,
+                     int num_threads);
+void batch_solve_pthread(BatchSystem *bs, int num_threads);
+
+/**
+ * Đo chi phí tạo rồi join num_threads luồng rounds lần (cách cũ mỗi cột)
+ */
+double measure_legacy_spawn_cost(int num_threads, int rounds);
+
+#endif /* GAUSS_CORE_H */
@@ -0,0 +1,95 @@
+/**
+ * GAUSS DRIVER - PHẦN DÙNG CHUNG CỦA CÁC CHƯƠNG TRÌNH BỘ NHỚ CHUNG
+ * In ma trận / vector nhỏ và đọc ghi file --input / --output / --save-input
+ * cho sequential.c, openmp.c, pthread.c (phần in ấn không nằm trong libgauss)
+ */
+
+#ifndef GAUSS_DRIVER_H
+#define GAUSS_DRIVER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "gauss_core.h"
+
+/**
+ * In ma trận (chỉ khi n <= 10)
+ */
+static inline void print_matrix(LinearSystem *sys) {
+    int n = sys->n;
+    if (n > 10) return;
+
+    printf("Ma trận A:\n");
+    for (int i = 0; i < n; i++) {
+        double *row = row_ptr(sys, i);
+        for (int j = 0; j < n; j++) {
+            printf("%8.2f ", row[j]);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * In vector (chỉ khi n <= 10)
+ */
+static inline void print_vector(double *v, int n, const char *name) {
+    if (n > 10) return;
+
+    printf("%s: ", name);
+    for (int i = 0; i < n; i++) {
+        printf("%.2f ", v[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * Map file --input (gauss_io.h): cần có A và b, chưa phân tích
+ */
+static inline GaussFile* open_input(const char *path) {
+    GaussFile *file = malloc(sizeof(GaussFile));
+    int rc = gauss_io_map(path, file);
+    uint32_t need = GAUSS_IO_HAS_A | GAUSS_IO_HAS_B;
+    if (rc == GAUSS_IO_OK &&
+        ((file->hdr.flags & need) != need || (file->hdr.flags & GAUSS_IO_FACTORED) ||
+         file->hdr.lda > INT_MAX)) {
+        gauss_io_unmap(file);
+        rc = GAUSS_IO_EFORMAT;
+    }
+    if (rc != GAUSS_IO_OK) {
+        printf("Lỗi: Không nạp được %s: %s\n", path, gauss_io_strerror(rc));
+        free(file);
+        return NULL;
+    }
+    return file;
+}
+
+/**
+ * Ghi nghiệm x ra file --output; factors != NULL: kèm hệ số L\U của hệ đó
+ * (hàng theo thứ tự sau pivot), hoán vị hàng và hàng gốc
+ */
+static inline int save_output(const char *path, int n, const double *x, LinearSystem *factors) {
+    int rc = factors
+           ? gauss_io_write(path, n, factors->A, factors->lda, factors->perm, factors->origin, NULL, x)
+           : gauss_io_write(path, n, NULL, 0, NULL, NULL, NULL, x);
+    if (rc != GAUSS_IO_OK) {
+        printf("❌ Không ghi được %s: %s\n", path, gauss_io_strerror(rc));
+        return 0;
+    }
+    printf("💾 Đã ghi nghiệm%s → %s\n", factors ? " + hệ số L\\U" : "", path);
+    return 1;
+}
+
+/**
+ * Ghi hệ A, b (trước LU) ra file --save-input để nạp lại bằng --input
+ */
+static inline int save_input(const char *path, LinearSystem *sys) {
+    int rc = gauss_io_write(path, sys->n, sys->A, sys->lda, sys->perm, NULL, sys->b, NULL);
+    if (rc != GAUSS_IO_OK) {
+        printf("❌ Không ghi được %s: %s\n", path, gauss_io_strerror(rc));
+        return 0;
+    }
+    printf("💾 Đã ghi hệ A, b → %s\n", path);
+    return 1;
+}
+
+#endif /* GAUSS_DRIVER_H */
@@ -0,0 +1,312 @@
+/**
+ * GAUSS IO - ĐỊNH DẠNG FILE NHỊ PHÂN CHO HỆ Ax = b
+ * File gồm header 80 byte rồi các payload căn lề:
+ *   A: n hàng row-major, bước lda double (n <= lda <= INT_MAX, lda bội số
+ *      8), bắt đầu ở GAUSS_IO_ALIGN byte (trang) nên mmap cả file cho A căn
+ *      lề 64 byte
+ *   b, x: n double; perm: n int32 (hàng gốc của hàng thứ i trong L\U),
+ *      mỗi payload căn lề 64 byte
+ * Bố cục A trùng với LinearSystem (khối liên tục, hàng căn lề, lda có
+ * padding) nên nạp chỉ là mmap: sys->A trỏ thẳng vào vùng map, không parse
+ * hay sao chép. Map MAP_PRIVATE nên LU ghi đè tại chỗ (copy-on-write) mà file
+ * không đổi. Số nguyên và double theo thứ tự byte của máy ghi (little-endian
+ * trên x86/ARM).
+ *
+ * Checksum (tùy chọn) là FNV-1a 64 bit theo từng word 8 byte trên n phần tử
+ * đầu mỗi hàng của A, rồi b, x, perm (bỏ qua padding).
+ */
+
+#ifndef GAUSS_IO_H
+#define GAUSS_IO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define GAUSS_IO_MAGIC "GAUSSMAT"
+#define GAUSS_IO_VERSION 1
+
+// Payload đầu tiên bắt đầu ở biên trang
+#define GAUSS_IO_ALIGN 4096
+
+// Kiểu phần tử và bố cục
+#define GAUSS_IO_F64 1
+#define GAUSS_IO_ROW_MAJOR 1
+
+// Cờ trong header
+#define GAUSS_IO_HAS_A     0x01u
+#define GAUSS_IO_HAS_B     0x02u
+#define GAUSS_IO_HAS_X     0x04u
+#define GAUSS_IO_FACTORED  0x08u    // A chứa L\U (L đơn vị), hàng theo thứ tự sau pivot
+#define GAUSS_IO_CHECKSUM  0x10u
+#define GAUSS_IO_HAS_PERM  0x20u    // Hoán vị hàng của L\U: P*A = L*U
+
+// Mã lỗi của gauss_io_map / gauss_io_write
+enum {
+    GAUSS_IO_OK = 0,
+    GAUSS_IO_EOPEN,         // Không mở/tạo được file
+    GAUSS_IO_EFORMAT,       // Sai magic/phiên bản/kiểu/bố cục hoặc header hỏng
+    GAUSS_IO_ETRUNC,        // File ngắn hơn các payload header khai báo
+    GAUSS_IO_ECHECKSUM,     // Checksum không khớp
+    GAUSS_IO_EMAP           // mmap thất bại
+};
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t dtype;
+    uint32_t layout;
+    uint32_t flags;
+    uint64_t n;
+    uint64_t lda;
+    uint64_t a_offset;      // Byte offset của từng payload (0 nếu không có)
+    uint64_t b_offset;
+    uint64_t x_offset;
+    uint64_t perm_offset;
+    uint64_t checksum;
+} GaussFileHeader;
+
+// File đã map: các con trỏ trỏ vào vùng map, NULL nếu payload không có
+typedef struct {
+    GaussFileHeader hdr;
+    void *map;
+    size_t size;
+    double *A;
+    double *b;
+    double *x;
+    int32_t *perm;
+} GaussFile;
+
+static inline const char* gauss_io_strerror(int code) {
+    switch (code) {
+        case GAUSS_IO_OK:        return "thành công";
+        case GAUSS_IO_EOPEN:     return "không mở được file";
+        case GAUSS_IO_EFORMAT:   return "sai định dạng (magic, phiên bản, kiểu hoặc bố cục)";
+        case GAUSS_IO_ETRUNC:    return "file bị cắt cụt";
+        case GAUSS_IO_ECHECKSUM: return "checksum không khớp";
+        case GAUSS_IO_EMAP:      return "mmap thất bại";
+    }
+    return "lỗi không xác định";
+}
+
+/**
+ * Leading dimension khi ghi A: bội số 8 double, tránh bước hàng bội số 4KB
+ * (giống create_system)
+ */
+static inline uint64_t gauss_io_lda(uint64_t n) {
+    uint64_t lda = (n + 7) & ~(uint64_t)7;
+    return (lda % 512 == 0) ? lda + 8 : lda;
+}
+
+static inline uint64_t gauss_io_round(uint64_t bytes) {
+    return (bytes + 63) & ~(uint64_t)63;
+}
+
+static inline uint64_t gauss_io_fnv(uint64_t h, const void *data, uint64_t bytes) {
+    const unsigned char *p = data;
+    uint64_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t word;
+        memcpy(&word, p + i, sizeof(word));
+        h = (h ^ word) * 1099511628211ull;
+    }
+    for (; i < bytes; i++) {
+        h = (h ^ p[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+/**
+ * Checksum các payload có trong header (A theo bước h->lda)
+ */
+static inline uint64_t gauss_io_checksum(const GaussFileHeader *h, const double *A,
+                                         const double *b, const double *x, const int32_t *perm) {
+    uint64_t sum = 14695981039346656037ull;
+    uint64_t vec_bytes = h->n * sizeof(double);
+    if (h->flags & GAUSS_IO_HAS_A) {
+        for (uint64_t i = 0; i < h->n; i++) {
+            sum = gauss_io_fnv(sum, A + i * h->lda, vec_bytes);
+        }
+    }
+    if (h->flags & GAUSS_IO_HAS_B) {
+        sum = gauss_io_fnv(sum, b, vec_bytes);
+    }
+    if (h->flags & GAUSS_IO_HAS_X) {
+        sum = gauss_io_fnv(sum, x, vec_bytes);
+    }
+    if (h->flags & GAUSS_IO_HAS_PERM) {
+        sum = gauss_io_fnv(sum, perm, h->n * sizeof(int32_t));
+    }
+    return sum;
+}
+
+/**
+ * Kiểm tra payload [offset, offset + bytes) nằm trong file và căn lề 64 byte
+ */
+static inline int gauss_io_payload_ok(uint64_t offset, uint64_t bytes, uint64_t size) {
+    return offset >= sizeof(GaussFileHeader) && offset % 64 == 0 &&
+           offset <= size && bytes <= size - offset;
+}
+
+/**
+ * Map cả file path (MAP_PRIVATE, đọc/ghi copy-on-write) và gán con trỏ tới
+ * các payload; kiểm tra checksum nếu header có. Trả về GAUSS_IO_OK hoặc mã lỗi.
+ */
+static inline int gauss_io_map(const char *path, GaussFile *f) {
+    memset(f, 0, sizeof(GaussFile));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return GAUSS_IO_EOPEN;
+    }
+
+    struct stat st;
+    GaussFileHeader h;
+    if (fstat(fd, &st) != 0 || pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h)) {
+        close(fd);
+        return GAUSS_IO_ETRUNC;
+    }
+    if (memcmp(h.magic, GAUSS_IO_MAGIC, 8) != 0 || h.version != GAUSS_IO_VERSION ||
+        h.dtype != GAUSS_IO_F64 || h.layout != GAUSS_IO_ROW_MAJOR ||
+        h.n == 0 || h.n > INT_MAX || h.lda < h.n || h.lda > INT_MAX || h.lda % 8 != 0) {
+        close(fd);
+        return GAUSS_IO_EFORMAT;
+    }
+    // Kích thước A ((n - 1) * lda + n double) phải biểu diễn được bằng size_t
+    if (h.n > 1 && h.lda > (SIZE_MAX / sizeof(double) - h.n) / (h.n - 1)) {
+        close(fd);
+        return GAUSS_IO_EFORMAT;
+    }
+
+    uint64_t size = (uint64_t)st.st_size;
+    uint64_t vec_bytes = h.n * sizeof(double);
+    if (((h.flags & GAUSS_IO_HAS_A) &&
+         !gauss_io_payload_ok(h.a_offset, ((h.n - 1) * h.lda + h.n) * sizeof(double), size)) ||
+        ((h.flags & GAUSS_IO_HAS_B) && !gauss_io_payload_ok(h.b_offset, vec_bytes, size)) ||
+        ((h.flags & GAUSS_IO_HAS_X) && !gauss_io_payload_ok(h.x_offset, vec_bytes, size)) ||
+        ((h.flags & GAUSS_IO_HAS_PERM) &&
+         !gauss_io_payload_ok(h.perm_offset, h.n * sizeof(int32_t), size))) {
+        close(fd);
+        return GAUSS_IO_ETRUNC;
+    }
+
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return GAUSS_IO_EMAP;
+    }
+
+    char *base = map;
+    f->hdr = h;
+    f->map = map;
+    f->size = size;
+    f->A = (h.flags & GAUSS_IO_HAS_A) ? (double*)(base + h.a_offset) : NULL;
+    f->b = (h.flags & GAUSS_IO_HAS_B) ? (double*)(base + h.b_offset) : NULL;
+    f->x = (h.flags & GAUSS_IO_HAS_X) ? (double*)(base + h.x_offset) : NULL;
+    f->perm = (h.flags & GAUSS_IO_HAS_PERM) ? (int32_t*)(base + h.perm_offset) : NULL;
+
+    if ((h.flags & GAUSS_IO_CHECKSUM) &&
+        gauss_io_checksum(&h, f->A, f->b, f->x, f->perm) != h.checksum) {
+        munmap(map, size);
+        memset(f, 0, sizeof(GaussFile));
+        return GAUSS_IO_ECHECKSUM;
+    }
+    return GAUSS_IO_OK;
+}
+
+static inline void gauss_io_unmap(GaussFile *f) {
+    if (f->map) {
+        munmap(f->map, f->size);
+    }
+    memset(f, 0, sizeof(GaussFile));
+}
+
+/**
+ * Ghi file chứa các payload khác NULL: A n x n bước lda (hàng thứ i lấy từ
+ * hàng vật lý row_map[i] nếu row_map khác NULL), b, x, và perm (khi có perm,
+ * A là hệ số L\U: cờ GAUSS_IO_FACTORED). Ghi qua mmap MAP_SHARED của file
+ * mới, kèm checksum.
+ */
+static inline int gauss_io_write(const char *path, int n, const double *A, int lda,
+                                 const int *row_map, const int *perm, const double *b,
+                                 const double *x) {
+    GaussFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, GAUSS_IO_MAGIC, 8);
+    h.version = GAUSS_IO_VERSION;
+    h.dtype = GAUSS_IO_F64;
+    h.layout = GAUSS_IO_ROW_MAJOR;
+    h.n = (uint64_t)n;
+    h.lda = gauss_io_lda(h.n);
+    h.flags = GAUSS_IO_CHECKSUM;
+
+    uint64_t end = GAUSS_IO_ALIGN;
+    if (A) {
+        h.flags |= GAUSS_IO_HAS_A;
+        h.a_offset = end;
+        end = gauss_io_round(end + h.n * h.lda * sizeof(double));
+    }
+    if (b) {
+        h.flags |= GAUSS_IO_HAS_B;
+        h.b_offset = end;
+        end = gauss_io_round(end + h.n * sizeof(double));
+    }
+    if (x) {
+        h.flags |= GAUSS_IO_HAS_X;
+        h.x_offset = end;
+        end = gauss_io_round(end + h.n * sizeof(double));
+    }
+    if (perm) {
+        h.flags |= GAUSS_IO_HAS_PERM | (A ? GAUSS_IO_FACTORED : 0);
+        h.perm_offset = end;
+        end = gauss_io_round(end + h.n * sizeof(int32_t));
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return GAUSS_IO_EOPEN;
+    }
+    if (ftruncate(fd, (off_t)end) != 0) {
+        close(fd);
+        return GAUSS_IO_EOPEN;
+    }
+    char *base = mmap(NULL, end, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return GAUSS_IO_EMAP;
+    }
+
+    // File mới từ ftruncate đã toàn 0 nên padding không cần ghi
+    if (A) {
+        double *dst = (double*)(base + h.a_offset);
+        for (int i = 0; i < n; i++) {
+            size_t row = row_map ? (size_t)row_map[i] : (size_t)i;
+            memcpy(dst + (size_t)i * h.lda, A + row * lda, (size_t)n * sizeof(double));
+        }
+    }
+    if (b) {
+        memcpy(base + h.b_offset, b, (size_t)n * sizeof(double));
+    }
+    if (x) {
+        memcpy(base + h.x_offset, x, (size_t)n * sizeof(double));
+    }
+    if (perm) {
+        int32_t *dst = (int32_t*)(base + h.perm_offset);
+        for (int i = 0; i < n; i++) {
+            dst[i] = perm[i];
+        }
+    }
+    h.checksum = gauss_io_checksum(&h, (double*)(base + h.a_offset), (double*)(base + h.b_offset),
+                                   (double*)(base + h.x_offset), (int32_t*)(base + h.perm_offset));
+    memcpy(base, &h, sizeof(h));
+
+    int ok = msync(base, end, MS_SYNC) == 0;
+    munmap(base, end);
+    return ok ? GAUSS_IO_OK : GAUSS_IO_EOPEN;
+}
+
+#endif /* GAUSS_IO_H */
@@ -0,0 +1,276 @@
+/**
+ * GAUSS MIXED - LU ĐỘ CHÍNH XÁC ĐƠN + TINH CHỈNH LẶP ĐỘ CHÍNH XÁC KÉP
+ * Phân tích PA = LU trên bản float của A (vector gấp đôi số phần tử, nửa
+ * lưu lượng bộ nhớ), rồi tinh chỉnh nghiệm bằng double:
+ *     r = b - A*x (double),  d = U^-1 L^-1 P r (hệ số float),  x += d
+ * cho tới khi sai số ngược đạt mức double. Nếu tinh chỉnh không hội tụ
+ * (A quá xấu so với độ chính xác float) thì trả về 0 để backend giải lại
+ * hoàn toàn bằng double.
+ *
+ * Các bước panel / khối hàng / ma trận con tách riêng như LU khối double để
+ * mỗi backend song song theo cách của nó; mixed_factor là bản tuần tự.
+ */
+
+#ifndef GAUSS_MIXED_H
+#define GAUSS_MIXED_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "gauss_simd.h"
+
+// Số lần tinh chỉnh tối đa (như LAPACK dsgesv)
+#define MIXED_MAX_ITER 30
+
+// Cột mỗi lát khi cập nhật ma trận con float (cùng số byte với bản double)
+#define MIXED_COL_CHUNK 512
+
+// Hệ số LU float, hàng vật lý cố định, hoán vị hàng qua perm (giống LinearSystem)
+typedef struct {
+    float *A;       // Ma trận float, một khối liên tục row-major
+    int lda;        // Leading dimension (bội số 16 float = 64 byte)
+    int *perm;      // Hàng logic i nằm ở hàng vật lý perm[i]; cũng là hàng gốc
+    int n;
+} MixedLU;
+
+static inline float* mixed_row(MixedLU *m, int i) {
+    return m->A + (size_t)m->perm[i] * m->lda;
+}
+
+static inline MixedLU* mixed_create(int n) {
+    MixedLU *m = malloc(sizeof(MixedLU));
+    m->n = n;
+    m->lda = (n + 15) & ~15;
+    if (m->lda % 1024 == 0) {
+        m->lda += 16;   // Tránh bước hàng bội số 4KB
+    }
+    if (posix_memalign((void**)&m->A, 64, (size_t)n * m->lda * sizeof(float)) != 0) {
+        free(m);
+        return NULL;
+    }
+    m->perm = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        m->perm[i] = i;
+    }
+    return m;
+}
+
+static inline void mixed_free(MixedLU *m) {
+    if (!m) return;
+
+    free(m->A);
+    free(m->perm);
+    free(m);
+}
+
+/**
+ * Chép (làm tròn xuống float) các hàng row_begin .. row_end-1 của A double
+ * (bước lda, thứ tự hàng gốc). Trả về 0 nếu có phần tử vượt miền float.
+ */
+static inline int mixed_load(MixedLU *m, const double *A, int lda, int row_begin, int row_end) {
+    int ok = 1;
+    for (int i = row_begin; i < row_end; i++) {
+        const double *src = A + (size_t)i * lda;
+        float *dst = m->A + (size_t)i * m->lda;
+        for (int j = 0; j < m->n; j++) {
+            if (fabs(src[j]) > FLT_MAX) {
+                ok = 0;
+            }
+            dst[j] = (float)src[j];
+        }
+    }
+    return ok;
+}
+
+/**
+ * Phân tích panel cột k0 .. k0+kb-1 (chọn pivot theo cột, đổi hàng qua perm).
+ * Trả về 0 nếu pivot ≈ 0 hoặc không hữu hạn: float không đủ, cần double.
+ */
+static inline int mixed_factor_panel(MixedLU *m, int k0, int kb) {
+    int n = m->n;
+    int k_end = k0 + kb;
+
+    for (int k = k0; k < k_end; k++) {
+        int max_row = k;
+        float max_val = fabsf(mixed_row(m, k)[k]);
+        for (int i = k + 1; i < n; i++) {
+            float val = fabsf(mixed_row(m, i)[k]);
+            if (val > max_val) {
+                max_val = val;
+                max_row = i;
+            }
+        }
+        if (!(max_val > 1e-30f) || !isfinite(max_val)) {
+            return 0;
+        }
+        if (max_row != k) {
+            int tmp = m->perm[k];
+            m->perm[k] = m->perm[max_row];
+            m->perm[max_row] = tmp;
+        }
+
+        float *row_k = mixed_row(m, k);
+        for (int i = k + 1; i < n; i++) {
+            float *row_i = mixed_row(m, i);
+            float factor = row_i[k] / row_k[k];
+            row_i[k] = factor;
+            simd_axpyf(k_end - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+        }
+    }
+    return 1;
+}
+
+/**
+ * U12 = L11^-1 * A12 trên cột col_begin .. col_end-1
+ */
+static inline void mixed_update_row_block(MixedLU *m, int k0, int kb, int col_begin, int col_end) {
+    for (int i = k0 + 1; i < k0 + kb; i++) {
+        float *row_i = mixed_row(m, i);
+        for (int p = k0; p < i; p++) {
+            simd_axpyf(col_end - col_begin, -row_i[p], mixed_row(m, p) + col_begin, row_i + col_begin);
+        }
+    }
+}
+
+/**
+ * A22 -= L21 * U12 cho các hàng row_begin .. row_end-1 (lát cột, gộp 4 hàng U)
+ */
+static inline void mixed_update_trailing(MixedLU *m, int k0, int kb, int row_begin, int row_end) {
+    int n = m->n;
+    int k_end = k0 + kb;
+
+    for (int jc = k_end; jc < n; jc += MIXED_COL_CHUNK) {
+        int jc_end = (jc + MIXED_COL_CHUNK < n) ? jc + MIXED_COL_CHUNK : n;
+        for (int i = row_begin; i < row_end; i++) {
+            float *row_i = mixed_row(m, i);
+            int p = k0;
+            for (; p + 3 < k_end; p += 4) {
+                float l[4] = { -row_i[p], -row_i[p+1], -row_i[p+2], -row_i[p+3] };
+                simd_axpy4f(jc_end - jc, l,
+                            mixed_row(m, p) + jc, mixed_row(m, p+1) + jc,
+                            mixed_row(m, p+2) + jc, mixed_row(m, p+3) + jc, row_i + jc);
+            }
+            for (; p < k_end; p++) {
+                simd_axpyf(jc_end - jc, -row_i[p], mixed_row(m, p) + jc, row_i + jc);
+            }
+        }
+    }
+}
+
+/**
+ * LU khối float tuần tự (block_size > 0)
+ */
+static inline int mixed_factor(MixedLU *m, int block_size) {
+    int n = m->n;
+    for (int k0 = 0; k0 < n; k0 += block_size) {
+        int kb = (k0 + block_size < n) ? block_size : n - k0;
+        if (!mixed_factor_panel(m, k0, kb)) {
+            return 0;
+        }
+        mixed_update_row_block(m, k0, kb, k0 + kb, n);
+        mixed_update_trailing(m, k0, kb, k0 + kb, n);
+    }
+    return 1;
+}
+
+/**
+ * d = U^-1 * L^-1 * P * r với hệ số float, cộng dồn bằng double
+ */
+static inline void mixed_solve(MixedLU *m, const double *r, double *d) {
+    int n = m->n;
+    for (int i = 0; i < n; i++) {
+        d[i] = r[m->perm[i]];
+    }
+    for (int i = 1; i < n; i++) {
+        const float *row_i = mixed_row(m, i);
+        double sum = d[i];
+        for (int j = 0; j < i; j++) {
+            sum -= row_i[j] * d[j];
+        }
+        d[i] = sum;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        const float *row_i = mixed_row(m, i);
+        double sum = d[i];
+        for (int j = i + 1; j < n; j++) {
+            sum -= row_i[j] * d[j];
+        }
+        d[i] = sum / row_i[i];
+    }
+}
+
+/**
+ * Tinh chỉnh lặp: A (double, bước lda) và b theo thứ tự hàng gốc, không bị
+ * sửa. Hội tụ khi ||r|| <= eps * ||A|| * ||x|| hoặc hiệu chỉnh ||d|| <= eps * ||x||
+ * (x không còn đổi ở độ chính xác double). Trả về 1 nếu hội tụ; 0 nếu chững
+ * lại (||d|| không giảm ít nhất một nửa) hoặc quá MIXED_MAX_ITER lần.
+ * *iterations nhận số lần tính phần dư.
+ */
+static inline int mixed_refine(MixedLU *m, const double *A, int lda, const double *b,
+                               double *x, int *iterations) {
+    int n = m->n;
+    double *r = calloc(n, sizeof(double));
+    double *d = malloc(n * sizeof(double));
+
+    double norm_a = 0.0;
+    for (int i = 0; i < n; i++) {
+        double row_sum = 0.0;
+        for (int j = 0; j < n; j++) {
+            row_sum += fabs(A[(size_t)i * lda + j]);
+        }
+        if (row_sum > norm_a) {
+            norm_a = row_sum;
+        }
+    }
+    double tol = DBL_EPSILON * norm_a;
+
+    mixed_solve(m, b, x);
+
+    int converged = 0;
+    double prev_norm_d = INFINITY;
+    *iterations = 0;
+    while (*iterations < MIXED_MAX_ITER) {
+        (*iterations)++;
+
+        // Phần dư bằng double
+        double norm_r = 0.0, norm_x = 0.0;
+        for (int i = 0; i < n; i++) {
+            r[i] = b[i] - simd_dot(n, A + (size_t)i * lda, x);
+            if (fabs(r[i]) > norm_r) {
+                norm_r = fabs(r[i]);
+            }
+            if (fabs(x[i]) > norm_x) {
+                norm_x = fabs(x[i]);
+            }
+        }
+        if (norm_r <= tol * norm_x) {
+            converged = 1;
+            break;
+        }
+
+        // Hiệu chỉnh bằng hệ số float
+        mixed_solve(m, r, d);
+        double norm_d = 0.0;
+        for (int i = 0; i < n; i++) {
+            x[i] += d[i];
+            if (fabs(d[i]) > norm_d) {
+                norm_d = fabs(d[i]);
+            }
+        }
+        if (norm_d <= DBL_EPSILON * norm_x) {
+            converged = 1;
+            break;
+        }
+        if (!(norm_d < 0.5 * prev_norm_d)) {
+            break;
+        }
+        prev_norm_d = norm_d;
+    }
+
+    free(r);
+    free(d);
+    return converged;
+}
+
+#endif /* GAUSS_MIXED_H */
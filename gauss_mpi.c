@@ -0,0 +1,1051 @@
+/**
+ * GAUSSIAN ELIMINATION - ENGINE MPI (libgauss)
+ * Giải hệ phương trình tuyến tính với distributed memory parallelism
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include "gauss_mpi.h"
+
+
+/**
+ * Tạo lưới P x Q và hai communicator con theo hàng/cột bằng MPI_Comm_split
+ */
+void grid_init(ProcessGrid *grid, int P, int Q) {
+    MPI_Comm_rank(MPI_COMM_WORLD, &grid->rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &grid->size);
+    grid->P = P;
+    grid->Q = Q;
+    grid->prow = grid->rank / Q;
+    grid->pcol = grid->rank % Q;
+    
+    MPI_Comm_split(MPI_COMM_WORLD, grid->prow, grid->pcol, &grid->row_comm);
+    MPI_Comm_split(MPI_COMM_WORLD, grid->pcol, grid->prow, &grid->col_comm);
+}
+
+/**
+ * Giải phóng các communicator của lưới
+ */
+void grid_free(ProcessGrid *grid) {
+    MPI_Comm_free(&grid->row_comm);
+    MPI_Comm_free(&grid->col_comm);
+}
+
+/**
+ * Chọn lưới gần vuông nhất cho size process (P <= Q)
+ */
+void grid_default_shape(int size, int *P, int *Q) {
+    *P = 1;
+    for (int p = 1; p * p <= size; p++) {
+        if (size % p == 0) {
+            *P = p;
+        }
+    }
+    *Q = size / *P;
+}
+
+/**
+ * Tạo phần cục bộ của hệ n x n theo lưới grid, khối nb: bộ nhớ ma trận mỗi
+ * process là O(n²/(P*Q)), chỉ perm/b/x có kích thước n
+ */
+LinearSystem* create_system_mpi(int n, ProcessGrid *grid, int nb) {
+    LinearSystem *sys = malloc(sizeof(LinearSystem));
+    sys->n = n;
+    sys->nb = nb;
+    sys->grid = grid;
+    sys->local_rows = local_index(n, nb, grid->P, grid->prow);
+    sys->local_cols = local_index(n, nb, grid->Q, grid->pcol);
+    sys->lda = padded_lda(sys->local_cols);
+    
+    // Luôn cấp ít nhất một hàng để process không sở hữu hàng nào vẫn có con trỏ hợp lệ
+    size_t rows = (sys->local_rows > 0) ? sys->local_rows : 1;
+    if (posix_memalign((void**)&sys->A, MATRIX_ALIGN,
+                       rows * sys->lda * sizeof(double)) != 0) {
+        free(sys);
+        return NULL;
+    }
+    
+    sys->perm = malloc(n * sizeof(int));
+    sys->local_row = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        sys->perm[i] = i;
+        sys->local_row[i] = (block_owner(i, nb, grid->P) == grid->prow)
+                          ? local_index(i, nb, grid->P, grid->prow) : -1;
+    }
+    
+    sys->b = malloc(n * sizeof(double));
+    sys->x = malloc(n * sizeof(double));
+    
+    return sys;
+}
+
+/**
+ * Giải phóng bộ nhớ
+ */
+void free_system_mpi(LinearSystem *sys) {
+    if (!sys) return;
+    
+    free(sys->A);
+    free(sys->perm);
+    free(sys->local_row);
+    free(sys->b);
+    free(sys->x);
+    free(sys);
+}
+
+/**
+ * Tích ma trận-vector phân tán y = A * x (x, y đủ n trên mọi process, theo
+ * hàng logic): tổng riêng trên các cột sở hữu, cộng dồn bằng MPI_Allreduce.
+ * Chỉ có nghĩa trước khi A bị ghi đè bởi LU.
+ */
+void matvec_mpi(LinearSystem *sys, const double *x, double *y) {
+    int n = sys->n;
+    ProcessGrid *grid = sys->grid;
+    
+    // x thu gọn theo các cột sở hữu
+    double *x_local = malloc((sys->local_cols + 1) * sizeof(double));
+    for (int c = 0; c < sys->local_cols; c++) {
+        x_local[c] = x[global_index(c, sys->nb, grid->Q, grid->pcol)];
+    }
+    
+    for (int i = 0; i < n; i++) {
+        y[i] = row_owned(sys, i) ? simd_dot(sys->local_cols, row_ptr(sys, i), x_local) : 0.0;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, y, n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    
+    free(x_local);
+}
+
+/**
+ * Tạo hệ phương trình test ngay trên phần sở hữu của từng process, không cần
+ * bản sao đầy đủ: A theo công thức đóng (gauss_verify.h, từng khối nb cột
+ * liền nhau), b = A * x (x[i] = i + 1) bằng tích ma trận-vector phân tán
+ */
+void generate_test_system_mpi(LinearSystem *sys) {
+    int n = sys->n;
+    int nb = sys->nb;
+    ProcessGrid *grid = sys->grid;
+    
+    // Ban đầu perm là đơn vị nên hàng logic = hàng vật lý
+    for (int i = 0; i < n; i++) {
+        if (!row_owned(sys, i)) {
+            continue;
+        }
+        double *row = row_ptr(sys, i);
+        for (int c0 = 0; c0 < sys->local_cols; c0 += nb) {
+            int len = (c0 + nb < sys->local_cols) ? nb : sys->local_cols - c0;
+            verify_test_row(n, i, global_index(c0, nb, grid->Q, grid->pcol), len, row + c0);
+        }
+    }
+    
+    // Tạo vector nghiệm x cố định: x[i] = i + 1
+    double *true_x = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        true_x[i] = i + 1.0;
+    }
+    matvec_mpi(sys, true_x, sys->b);
+    
+    free(true_x);
+}
+
+/**
+ * Nạp hệ đầy đủ mà mọi process đều thấy (file --input đã map, bộ đệm của
+ * caller libgauss): mỗi process chỉ chép các khối mình sở hữu vào ma trận cục
+ * bộ, không qua process 0 (với file map, trang không đụng tới không được đọc)
+ */
+void load_system(LinearSystem *sys, const double *A, size_t lda, const double *b) {
+    int n = sys->n;
+    int nb = sys->nb;
+    ProcessGrid *grid = sys->grid;
+    
+    for (int i = 0; i < n; i++) {
+        if (!row_owned(sys, i)) {
+            continue;
+        }
+        double *row = row_ptr(sys, i);
+        const double *src = A + (size_t)i * lda;
+        for (int c0 = 0; c0 < sys->local_cols; c0 += nb) {
+            int j0 = global_index(c0, nb, grid->Q, grid->pcol);
+            int len = (c0 + nb < sys->local_cols) ? nb : sys->local_cols - c0;
+            memcpy(row + c0, src + j0, len * sizeof(double));
+        }
+    }
+    memcpy(sys->b, b, n * sizeof(double));
+}
+
+/**
+ * Phân phối hệ đầy đủ full_A (n x n, leading dimension n) và full_b từ
+ * process 0: mỗi process nhận thẳng từ full_A qua một kiểu dữ liệu
+ * block-cyclic (MPI_Type_create_darray) vào bố cục cục bộ có padding
+ * (MPI_Type_vector), không đóng gói thêm bản sao nào ở process 0 và không có
+ * mảng count/displacement int. Dùng khi dữ liệu chỉ có ở process 0 (ví dụ
+ * đọc từ file); full_A/full_b chỉ cần hợp lệ ở process 0.
+ */
+void scatter_system(LinearSystem *sys, const double *full_A, const double *full_b) {
+    int n = sys->n;
+    int nb = sys->nb;
+    ProcessGrid *grid = sys->grid;
+    
+    if (grid->rank == 0) {
+        int gsizes[2] = { n, n };
+        int distribs[2] = { MPI_DISTRIBUTE_CYCLIC, MPI_DISTRIBUTE_CYCLIC };
+        int dargs[2] = { nb, nb };
+        int psizes[2] = { grid->P, grid->Q };
+        MPI_Request *req = malloc(grid->size * sizeof(MPI_Request));
+        
+        // rank = prow * Q + pcol khớp thứ tự process của darray (MPI_ORDER_C)
+        req[0] = MPI_REQUEST_NULL;
+        for (int r = 1; r < grid->size; r++) {
+            MPI_Datatype part;
+            MPI_Type_create_darray(grid->size, r, 2, gsizes, distribs, dargs, psizes,
+                                   MPI_ORDER_C, MPI_DOUBLE, &part);
+            MPI_Type_commit(&part);
+            MPI_Isend(full_A, 1, part, r, 0, MPI_COMM_WORLD, &req[r]);
+            MPI_Type_free(&part);
+        }
+        load_system(sys, full_A, n, full_b);
+        MPI_Waitall(grid->size, req, MPI_STATUSES_IGNORE);
+        free(req);
+    } else {
+        MPI_Datatype local;
+        MPI_Type_vector(sys->local_rows, sys->local_cols, sys->lda, MPI_DOUBLE, &local);
+        MPI_Type_commit(&local);
+        MPI_Recv(sys->A, 1, local, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        MPI_Type_free(&local);
+    }
+    MPI_Bcast(sys->b, n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+}
+
+/**
+ * Khởi động cộng dồn tổng riêng của khối hàng K (MPI_Ireduce trong hàng lưới,
+ * gốc là cột lưới sở hữu khối cột K). Hàng lưới không giữ hàng nào của khối
+ * thì bỏ qua (mọi process trong hàng lưới thấy cùng perm nên cùng quyết định).
+ */
+static void post_partial_reduce(LinearSystem *sys, const double *partial, int K,
+                                double *pack, double *sums, MPI_Request *req) {
+    int nb = sys->nb;
+    int k0 = K * nb;
+    int kb = (k0 + nb < sys->n) ? nb : sys->n - k0;
+    int owned = 0;
+    
+    for (int r = 0; r < kb; r++) {
+        pack[r] = row_owned(sys, k0 + r) ? partial[k0 + r] : 0.0;
+        owned |= row_owned(sys, k0 + r);
+    }
+    if (owned) {
+        MPI_Ireduce(pack, sums, kb, MPI_DOUBLE, MPI_SUM, block_owner(k0, nb, sys->grid->Q),
+                    sys->grid->row_comm, req);
+    }
+}
+
+/**
+ * Giải tam giác phân tán trên ma trận đã phân tích (L đơn vị hoặc U), theo
+ * từng khối nb hàng (từ trên xuống với L, từ dưới lên với U):
+ *   - mỗi process giữ tổng riêng partial[i] = Σ A[i][j]*sol[j] trên các hàng
+ *     và cột nó sở hữu, với các khối nghiệm đã biết
+ *   - tổng riêng của khối K được cộng dồn trong từng hàng lưới (row_comm) về
+ *     process thuộc cột lưới sở hữu khối cột K
+ *   - cột lưới đó giải khối đường chéo tại chỗ: mỗi đoạn hàng liền nhau do
+ *     cùng một hàng lưới giữ được chủ của nó giải rồi broadcast trong col_comm
+ *     (không pivot chéo hàng lưới thì cả khối là một đoạn)
+ *   - cột lưới đó cộng phần đóng góp của khối nghiệm vào các hàng của khối kế
+ *     tiếp trước, khởi động cộng dồn của khối đó, rồi mới tới các hàng còn lại
+ * Ma trận không rời khỏi chủ sở hữu; mỗi khối nghiệm chỉ đi dọc cột lưới của
+ * nó, sol được ghép đủ n trên mọi process một lần ở cuối (row_comm).
+ * upper = 0: L*sol = rhs; upper = 1: U*sol = rhs. rhs (đủ n trên mọi process)
+ * và sol có thể trùng nhau.
+ */
+static void triangular_solve_mpi(LinearSystem *sys, const double *rhs, double *sol, int upper) {
+    int n = sys->n;
+    int nb = sys->nb;
+    ProcessGrid *grid = sys->grid;
+    int num_blocks = (n + nb - 1) / nb;
+    
+    double *partial = calloc(n, sizeof(double));
+    double *pack = malloc(nb * sizeof(double));
+    double *sums = malloc(nb * sizeof(double));
+    MPI_Request req = MPI_REQUEST_NULL;
+    
+    post_partial_reduce(sys, partial, upper ? num_blocks - 1 : 0, pack, sums, &req);
+    
+    for (int step = 0; step < num_blocks; step++) {
+        int K = upper ? num_blocks - 1 - step : step;
+        int k0 = K * nb;
+        int k_end = (k0 + nb < n) ? k0 + nb : n;
+        int kb = k_end - k0;
+        int diag_col = (block_owner(k0, nb, grid->Q) == grid->pcol);
+        int lk0 = local_col(sys, k0);
+        int has_next = (step + 1 < num_blocks);
+        int next_K = upper ? K - 1 : K + 1;
+        
+        MPI_Wait(&req, MPI_STATUS_IGNORE);
+        
+        if (!diag_col) {
+            // Phần đóng góp của process vào khối kế tiếp đã đủ
+            if (has_next) {
+                post_partial_reduce(sys, partial, next_K, pack, sums, &req);
+            }
+            continue;
+        }
+        
+        // Khối đường chéo theo từng đoạn hàng cùng chủ, theo thứ tự thế
+        int r = upper ? kb - 1 : 0;
+        while (r >= 0 && r < kb) {
+            int owner = block_owner(sys->perm[k0 + r], nb, grid->P);
+            int lo = r, hi = r;
+            if (upper) {
+                while (lo > 0 && block_owner(sys->perm[k0 + lo - 1], nb, grid->P) == owner) {
+                    lo--;
+                }
+                r = lo - 1;
+            } else {
+                while (hi + 1 < kb && block_owner(sys->perm[k0 + hi + 1], nb, grid->P) == owner) {
+                    hi++;
+                }
+                r = hi + 1;
+            }
+            
+            if (grid->prow == owner) {
+                for (int t = 0; t <= hi - lo; t++) {
+                    int rr = upper ? hi - t : lo + t;
+                    const double *row = row_ptr(sys, k0 + rr) + lk0;
+                    double s = rhs[k0 + rr] - sums[rr];
+                    if (upper) {
+                        s -= simd_dot(kb - rr - 1, row + rr + 1, sol + k0 + rr + 1);
+                        sol[k0 + rr] = s / row[rr];
+                    } else {
+                        sol[k0 + rr] = s - simd_dot(rr, row, sol + k0);
+                    }
+                }
+            }
+            MPI_Bcast(sol + k0 + lo, hi - lo + 1, MPI_DOUBLE, owner, grid->col_comm);
+        }
+        
+        // Đóng góp của khối nghiệm vừa có: hàng của khối kế tiếp trước (để
+        // khởi động cộng dồn của nó sớm), các hàng còn lại trong lúc nó đang bay
+        int first = upper ? 0 : k_end;
+        int last = upper ? k0 : n;
+        int next_begin = upper ? ((k0 - nb > 0) ? k0 - nb : 0) : k_end;
+        int next_end = upper ? k0 : ((k_end + nb < n) ? k_end + nb : n);
+        for (int i = next_begin; i < next_end; i++) {
+            if (row_owned(sys, i)) {
+                partial[i] += simd_dot(kb, row_ptr(sys, i) + lk0, sol + k0);
+            }
+        }
+        if (has_next) {
+            post_partial_reduce(sys, partial, next_K, pack, sums, &req);
+        }
+        for (int i = first; i < last; i++) {
+            if ((i < next_begin || i >= next_end) && row_owned(sys, i)) {
+                partial[i] += simd_dot(kb, row_ptr(sys, i) + lk0, sol + k0);
+            }
+        }
+    }
+    
+    // Mỗi cột lưới giữ các khối nghiệm của cột mình: ghép đủ n dọc hàng lưới
+    for (int k0 = 0; k0 < n; k0 += nb) {
+        if (block_owner(k0, nb, grid->Q) != grid->pcol) {
+            int kb = (k0 + nb < n) ? nb : n - k0;
+            memset(sol + k0, 0, kb * sizeof(double));
+        }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, sol, n, MPI_DOUBLE, MPI_SUM, grid->row_comm);
+    
+    free(partial);
+    free(pack);
+    free(sums);
+}
+
+/**
+ * Sai số ngược ||b - A*x|| / (||A|| * ||x|| + ||b||) trên hệ gốc
+ * (gauss_verify.h), không dùng A đã bị LU ghi đè. Mỗi process lấy lại phần
+ * tử gốc của các khối mình sở hữu theo hàng vật lý (= hàng gốc): sinh lại
+ * hệ test hoặc đọc từ file --input map lại. Tích và tổng |a| từng hàng trên
+ * các cột sở hữu tính bằng simd_gemv4, cộng dồn về process 0; kết quả chỉ có
+ * nghĩa ở process 0.
+ */
+double verify_solution_mpi(LinearSystem *sys, const VerifySource *src) {
+    int n = sys->n;
+    int nb = sys->nb;
+    int lc = sys->local_cols;
+    ProcessGrid *grid = sys->grid;
+    
+    // Nghiệm thu gọn theo các cột sở hữu
+    double *x_local = malloc((lc + 1) * sizeof(double));
+    for (int c = 0; c < lc; c++) {
+        x_local[c] = sys->x[global_index(c, nb, grid->Q, grid->pcol)];
+    }
+    
+    // partial[i] = (A*x)_i, partial[n + i] = tổng |a_ij| trên các cột sở hữu
+    double *partial = calloc(2 * (size_t)n, sizeof(double));
+    double *buf = malloc((size_t)VERIFY_ROWS * (lc + 1) * sizeof(double));
+    int rows[VERIFY_ROWS];
+    int count = 0;
+    for (int i = 0; i <= n; i++) {
+        if (i < n && sys->local_row[i] >= 0) {
+            rows[count++] = i;
+        }
+        if (count == VERIFY_ROWS || (i == n && count > 0)) {
+            const double *a[VERIFY_ROWS];
+            for (int r = 0; r < VERIFY_ROWS; r++) {
+                double *row = buf + (size_t)r * (lc + 1);
+                a[r] = (r < count) ? row : a[0];
+                for (int c0 = 0; c0 < lc && r < count; c0 += nb) {
+                    int j0 = global_index(c0, nb, grid->Q, grid->pcol);
+                    int len = (c0 + nb < lc) ? nb : lc - c0;
+                    if (src->A) {
+                        memcpy(row + c0, src->A + (size_t)rows[r] * src->lda + j0,
+                               len * sizeof(double));
+                    } else {
+                        verify_test_row(n, rows[r], j0, len, row + c0);
+                    }
+                }
+            }
+            double d[VERIFY_ROWS] = {0.0}, s[VERIFY_ROWS] = {0.0};
+            simd_gemv4(lc, a[0], a[1], a[2], a[3], x_local, d, s);
+            for (int r = 0; r < count; r++) {
+                partial[rows[r]] = d[r];
+                partial[n + rows[r]] = s[r];
+            }
+            count = 0;
+        }
+    }
+    free(buf);
+    free(x_local);
+    MPI_Reduce(grid->rank == 0 ? MPI_IN_PLACE : partial, partial, 2 * n, MPI_DOUBLE, MPI_SUM,
+               0, MPI_COMM_WORLD);
+    
+    double error = 0.0;
+    if (grid->rank == 0) {
+        VerifyNorms acc;
+        verify_norms_init(&acc);
+        for (int i = 0; i < n; i++) {
+            verify_norms_row(&acc, src->b[i], partial[i], partial[n + i]);
+        }
+        error = verify_backward_error(&acc, n, sys->x, src->b);
+    }
+    free(partial);
+    return error;
+}
+
+/**
+ * Cấp phát bảng thời gian cho n/nb bước
+ */
+void timing_init(StepTiming *timing, int n, int nb) {
+    timing->steps = (n + nb - 1) / nb;
+    timing->factor = calloc(timing->steps, sizeof(double));
+    timing->in_flight = calloc(timing->steps, sizeof(double));
+    timing->exposed = calloc(timing->steps, sizeof(double));
+}
+
+/**
+ * Giải phóng bảng thời gian
+ */
+void timing_free(StepTiming *timing) {
+    free(timing->factor);
+    free(timing->in_flight);
+    free(timing->exposed);
+}
+
+/**
+ * Phân tích panel k0..k0+kb-1 trên cột lưới sở hữu nó: tìm pivot bằng MAXLOC
+ * trong col_comm, broadcast đoạn panel của hàng pivot xuống cột lưới, tính hệ
+ * số L. Cột kế tiếp được cập nhật trước và MAXLOC của nó (MPI_Iallreduce)
+ * bay trong lúc cập nhật các cột còn lại của panel. Ghi ipiv vào
+ * pivots[0..kb-1], trạng thái vào pivots[kb] và các hàng pivot (L11\U11,
+ * bước nb) vào lpanel.
+ */
+static void factor_panel(LinearSystem *sys, int k0, int kb, double *lpanel, int *pivots) {
+    int n = sys->n;
+    int nb = sys->nb;
+    ProcessGrid *grid = sys->grid;
+    int k_end = k0 + kb;
+    int lk0 = local_col(sys, k0);
+    
+    struct {
+        double value;
+        int index;
+    } local_max, global_max;
+    MPI_Request req;
+    
+    // Pivot của cột đầu tiên
+    local_max.value = -1.0;
+    local_max.index = n;
+    for (int i = k0; i < n; i++) {
+        if (row_owned(sys, i) && fabs(row_ptr(sys, i)[lk0]) > local_max.value) {
+            local_max.value = fabs(row_ptr(sys, i)[lk0]);
+            local_max.index = i;
+        }
+    }
+    MPI_Iallreduce(&local_max, &global_max, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
+                   grid->col_comm, &req);
+    
+    pivots[kb] = 1;
+    for (int k = k0; k < k_end; k++) {
+        int lk = lk0 + (k - k0);
+        MPI_Wait(&req, MPI_STATUS_IGNORE);
+        
+        if (global_max.value < 1e-12) {
+            pivots[kb] = 0;
+            return;
+        }
+        
+        pivots[k - k0] = global_max.index;
+        if (global_max.index != k) {
+            swap_rows(sys, k, global_max.index);
+        }
+        
+        // Đoạn panel của hàng pivot (gồm cả hệ số L đã tính ở các cột trước)
+        double *pivot_seg = lpanel + (size_t)(k - k0) * nb;
+        int root = block_owner(sys->perm[k], nb, grid->P);
+        if (grid->prow == root) {
+            memcpy(pivot_seg, row_ptr(sys, k) + lk0, kb * sizeof(double));
+        }
+        MPI_Bcast(pivot_seg, kb, MPI_DOUBLE, root, grid->col_comm);
+        
+        // Hệ số L và cột k+1 trước, tìm luôn pivot cục bộ của cột k+1
+        int has_next = (k + 1 < k_end);
+        local_max.value = -1.0;
+        local_max.index = n;
+        for (int i = k + 1; i < n; i++) {
+            if (!row_owned(sys, i)) {
+                continue;
+            }
+            double *row_i = row_ptr(sys, i);
+            double factor = row_i[lk] / pivot_seg[k - k0];
+            row_i[lk] = factor;
+            if (has_next) {
+                row_i[lk + 1] -= factor * pivot_seg[k - k0 + 1];
+                if (fabs(row_i[lk + 1]) > local_max.value) {
+                    local_max.value = fabs(row_i[lk + 1]);
+                    local_max.index = i;
+                }
+            }
+        }
+        if (!has_next) {
+            break;
+        }
+        MPI_Iallreduce(&local_max, &global_max, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
+                       grid->col_comm, &req);
+        
+        // Các cột còn lại của panel trong lúc MAXLOC của cột k+1 đang bay
+        for (int i = k + 1; i < n; i++) {
+            if (row_owned(sys, i)) {
+                double *row_i = row_ptr(sys, i);
+                simd_axpy(k_end - k - 2, -row_i[lk], pivot_seg + (k - k0) + 2, row_i + lk + 2);
+            }
+        }
+    }
+}
+
+/**
+ * Khởi động broadcast pivot và panel L của panel k0 dọc hàng lưới
+ * (MPI_Ibcast, gốc là cột lưới panel_col). Cột sở hữu panel đóng gói L21 của
+ * các hàng sở hữu từ k0+kb trở đi ngay sau L11. Số phần tử phải khớp trên mọi
+ * process trong hàng lưới trước khi biết pivot, nên dùng cận trên rows_left
+ * (số hàng sở hữu từ k0 trở đi): thừa tối đa kb hàng.
+ */
+static void post_panel_bcast(LinearSystem *sys, int k0, int kb, int rows_left,
+                             double *lpanel, int *pivots, MPI_Request req[2]) {
+    int nb = sys->nb;
+    ProcessGrid *grid = sys->grid;
+    int panel_col = block_owner(k0, nb, grid->Q);
+    
+    if (grid->pcol == panel_col && pivots[kb]) {
+        int lk0 = local_col(sys, k0);
+        double *l21 = lpanel + (size_t)kb * nb;
+        int r_local = 0;
+        for (int i = k0 + kb; i < sys->n; i++) {
+            if (row_owned(sys, i)) {
+                memcpy(l21 + (size_t)r_local * kb, row_ptr(sys, i) + lk0, kb * sizeof(double));
+                r_local++;
+            }
+        }
+    }
+    MPI_Ibcast(pivots, kb + 1, MPI_INT, panel_col, grid->row_comm, &req[0]);
+    MPI_Ibcast(lpanel, kb * nb + rows_left * kb, MPI_DOUBLE, panel_col, grid->row_comm, &req[1]);
+}
+
+/**
+ * A22 -= L21 * U12 trên các cột cục bộ [col_begin, col_end) của đoạn U12
+ * (upanel, kb hàng, bước ldu), cho các hàng cục bộ targets[0..rows-1].
+ * Làm theo từng đoạn nb cột để U12 nằm trong cache; giữa các đoạn gọi
+ * MPI_Testall để thư viện MPI tiến hành broadcast đang bay (nếu có) và ghi
+ * lại thời điểm nó xong vào *done_time.
+ */
+static void update_trailing(LinearSystem *sys, int kb, const double *l21,
+                            const int *targets, int rows, const double *upanel, int ldu,
+                            int col_begin, int col_end, int c_base,
+                            MPI_Request *pending, double *done_time) {
+    int nb = sys->nb;
+    for (int offset = col_begin; offset < col_end; offset += nb) {
+        int len = (col_end - offset < nb) ? col_end - offset : nb;
+        for (int r = 0; r < rows; r++) {
+            const double *l = l21 + (size_t)r * kb;
+            double *row_i = sys->A + (size_t)targets[r] * sys->lda + c_base + offset;
+            
+            int p = 0;
+            for (; p + 3 < kb; p += 4) {
+                double neg_l[4] = { -l[p], -l[p+1], -l[p+2], -l[p+3] };
+                simd_axpy4(len, neg_l,
+                           upanel + (size_t)p * ldu + offset,
+                           upanel + (size_t)(p+1) * ldu + offset,
+                           upanel + (size_t)(p+2) * ldu + offset,
+                           upanel + (size_t)(p+3) * ldu + offset, row_i);
+            }
+            for (; p < kb; p++) {
+                simd_axpy(len, -l[p], upanel + (size_t)p * ldu + offset, row_i);
+            }
+        }
+        
+        if (pending && *done_time == 0.0) {
+            int flag;
+            MPI_Testall(2, pending, &flag, MPI_STATUSES_IGNORE);
+            if (flag) {
+                *done_time = MPI_Wtime();
+            }
+        }
+    }
+}
+
+/**
+ * Phân tích PA = LU phân tán: LU khối right-looking trên lưới
+ * P x Q, phân phối 2D block-cyclic (khối nb x nb, cũng là độ rộng panel).
+ * Mỗi panel:
+ *   1. Cột lưới sở hữu panel phân tích nó (factor_panel)
+ *   2. Broadcast pivot và panel L dọc hàng lưới (row_comm, MPI_Ibcast)
+ *   3. Ghép U12 trong từng cột lưới (allreduce trong col_comm), giải tam giác
+ *   4. Cập nhật cục bộ A22 -= L21 * U12 trên phần sở hữu
+ * Với lookahead, cột lưới sở hữu panel kế tiếp cập nhật các cột panel đó
+ * trước, phân tích nó và khởi động broadcast ngay; phần còn lại của bước 4
+ * (ở mọi process) chạy trong khi broadcast đang bay. Không có barrier giữa
+ * các bước: mỗi process chỉ chờ đúng dữ liệu panel nó cần.
+ * Hoán đổi hàng chỉ đổi perm/b trên mọi process (quyền sở hữu theo hàng vật lý),
+ * nên lượng dữ liệu mỗi process gửi/nhận là O(n²/P + n²/Q) thay vì O(n²).
+ * Kết quả giữ tại chỗ (L đơn vị dưới đường chéo, U từ đường chéo trở lên, P
+ * trong perm) để giải nhiều vế phải bằng lu_solve_mpi.
+ * timing (có thể NULL) nhận thời gian từng bước, lấy max trên các process.
+ */
+int lu_factor_mpi(LinearSystem *sys, int lookahead, StepTiming *timing) {
+    int n = sys->n;
+    int nb = sys->nb;
+    ProcessGrid *grid = sys->grid;
+    int Q = grid->Q;
+    int pcol = grid->pcol;
+    
+    // Hai bộ đệm pivot/panel L: panel kế tiếp được broadcast khi panel hiện tại còn dùng.
+    // lpanel: nb hàng pivot (L11\U11, bước nb) rồi tới L21 của các hàng sở hữu
+    double *lpanel[2];
+    int *pivots[2];                                                 // ipiv của panel + trạng thái
+    for (int s = 0; s < 2; s++) {
+        lpanel[s] = malloc((size_t)(sys->local_rows + nb) * nb * sizeof(double));
+        pivots[s] = malloc((nb + 1) * sizeof(int));
+    }
+    double *upanel = malloc(((size_t)sys->local_cols * nb + 1) * sizeof(double));   // U12 các cột sở hữu
+    int *targets = malloc((sys->local_rows + 1) * sizeof(int));     // Hàng cục bộ cần cập nhật
+    MPI_Request req[2];
+    
+    double *t_factor = calloc((n + nb - 1) / nb + 1, sizeof(double));
+    double *t_in_flight = calloc((n + nb - 1) / nb + 1, sizeof(double));
+    double *t_exposed = calloc((n + nb - 1) / nb + 1, sizeof(double));
+    double post_time = 0.0, done_time = 0.0;
+    
+    // Panel đầu tiên
+    int cur = 0;
+    int first_kb = (nb < n) ? nb : n;
+    double t0 = MPI_Wtime();
+    if (pcol == block_owner(0, nb, Q)) {
+        factor_panel(sys, 0, first_kb, lpanel[cur], pivots[cur]);
+        t_factor[0] = MPI_Wtime() - t0;
+    }
+    post_time = MPI_Wtime();
+    post_panel_bcast(sys, 0, first_kb, sys->local_rows, lpanel[cur], pivots[cur], req);
+    
+    int ok = 1;
+    for (int k0 = 0; k0 < n; k0 += nb) {
+        int step = k0 / nb;
+        int k_end = (k0 + nb < n) ? k0 + nb : n;
+        int kb = k_end - k0;
+        int panel_col = block_owner(k0, nb, Q);
+        
+        // 2. Nhận pivot và panel L (phần chưa che được bởi tính toán)
+        double wait_start = MPI_Wtime();
+        MPI_Waitall(2, req, MPI_STATUSES_IGNORE);
+        double wait_end = MPI_Wtime();
+        if (done_time == 0.0) {
+            done_time = wait_end;
+        }
+        t_in_flight[step] = done_time - post_time;
+        t_exposed[step] = wait_end - wait_start;
+        
+        if (!pivots[cur][kb]) {
+            ok = 0;
+            break;
+        }
+        
+        if (pcol != panel_col) {
+            for (int k = k0; k < k_end; k++) {
+                if (pivots[cur][k - k0] != k) {
+                    swap_rows(sys, k, pivots[cur][k - k0]);
+                }
+            }
+        }
+        
+        // Mọi process cùng hàng lưới duyệt cùng tập hàng (perm giống nhau).
+        // Ghi lại hàng cục bộ vì lookahead sẽ hoán vị perm trước khi cập nhật xong.
+        int rows = 0;
+        for (int i = k_end; i < n; i++) {
+            if (row_owned(sys, i)) {
+                targets[rows++] = sys->local_row[sys->perm[i]];
+            }
+        }
+        double *l21 = lpanel[cur] + (size_t)kb * nb;
+        
+        if (k_end >= n) {
+            break;
+        }
+        
+        // Các cột sở hữu bên phải panel nằm liền nhau trong ma trận cục bộ
+        int c_begin = local_col(sys, k_end);
+        int local_cols = sys->local_cols - c_begin;
+        
+        if (local_cols > 0) {
+            // 3. Ghép các hàng k0..k_end-1 (nằm rải rác trên các hàng lưới) rồi
+            //    giải U12 = L11^-1 * A12; mọi process trong cột lưới cùng giải
+            for (int r = 0; r < kb; r++) {
+                double *dst = upanel + (size_t)r * local_cols;
+                if (row_owned(sys, k0 + r)) {
+                    memcpy(dst, row_ptr(sys, k0 + r) + c_begin, local_cols * sizeof(double));
+                } else {
+                    memset(dst, 0, local_cols * sizeof(double));
+                }
+            }
+            MPI_Allreduce(MPI_IN_PLACE, upanel, kb * local_cols, MPI_DOUBLE, MPI_SUM,
+                          grid->col_comm);
+            
+            for (int r = 1; r < kb; r++) {
+                double *u_r = upanel + (size_t)r * local_cols;
+                for (int p = 0; p < r; p++) {
+                    simd_axpy(local_cols, -lpanel[cur][(size_t)r * nb + p],
+                              upanel + (size_t)p * local_cols, u_r);
+                }
+            }
+            
+            // Hàng sở hữu giữ U12 cho bước thế ngược
+            for (int r = 0; r < kb; r++) {
+                if (row_owned(sys, k0 + r)) {
+                    memcpy(row_ptr(sys, k0 + r) + c_begin, upanel + (size_t)r * local_cols,
+                           local_cols * sizeof(double));
+                }
+            }
+        }
+        
+        // Panel kế tiếp
+        int nk_end = (k_end + nb < n) ? k_end + nb : n;
+        int nkb = nk_end - k_end;
+        int next = cur ^ 1;
+        int next_owner = (pcol == block_owner(k_end, nb, Q));
+        
+        // 4. A22 -= L21 * U12 trên phần sở hữu
+        int first = 0;
+        if (lookahead) {
+            // Cột panel kế tiếp trước, rồi phân tích và broadcast nó ngay
+            if (next_owner) {
+                first = nkb;
+                update_trailing(sys, kb, l21, targets, rows, upanel, local_cols,
+                                0, first, c_begin, NULL, NULL);
+                double tf = MPI_Wtime();
+                factor_panel(sys, k_end, nkb, lpanel[next], pivots[next]);
+                t_factor[step + 1] = MPI_Wtime() - tf;
+            }
+            post_time = MPI_Wtime();
+            done_time = 0.0;
+            post_panel_bcast(sys, k_end, nkb, rows, lpanel[next], pivots[next], req);
+            update_trailing(sys, kb, l21, targets, rows, upanel, local_cols,
+                            first, local_cols, c_begin, req, &done_time);
+        } else {
+            update_trailing(sys, kb, l21, targets, rows, upanel, local_cols,
+                            0, local_cols, c_begin, NULL, NULL);
+            if (next_owner) {
+                double tf = MPI_Wtime();
+                factor_panel(sys, k_end, nkb, lpanel[next], pivots[next]);
+                t_factor[step + 1] = MPI_Wtime() - tf;
+            }
+            post_time = MPI_Wtime();
+            done_time = 0.0;
+            post_panel_bcast(sys, k_end, nkb, rows, lpanel[next], pivots[next], req);
+        }
+        cur = next;
+    }
+    
+    if (timing) {
+        int steps = timing->steps;
+        MPI_Reduce(t_factor, timing->factor, steps, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(t_in_flight, timing->in_flight, steps, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(t_exposed, timing->exposed, steps, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    }
+    
+    for (int s = 0; s < 2; s++) {
+        free(lpanel[s]);
+        free(pivots[s]);
+    }
+    free(upanel);
+    free(targets);
+    free(t_factor);
+    free(t_in_flight);
+    free(t_exposed);
+    
+    return ok;
+}
+
+/**
+ * Giải A*x = rhs trong O(n²/(P*Q)) tính toán mỗi process bằng LU đã phân
+ * tích. rhs theo thứ tự hàng gốc, đủ n trên mọi process; x nhận nghiệm trên
+ * mọi process (có thể trùng rhs). Hàng vật lý không bao giờ di chuyển nên
+ * perm[i] cũng là hàng gốc của hàng logic i.
+ */
+void lu_solve_mpi(LinearSystem *sys, const double *rhs, double *x) {
+    int n = sys->n;
+    double *y = malloc(n * sizeof(double));
+    
+    for (int i = 0; i < n; i++) {
+        y[i] = rhs[sys->perm[i]];
+    }
+    triangular_solve_mpi(sys, y, y, 0);
+    triangular_solve_mpi(sys, y, x, 1);
+    
+    free(y);
+}
+
+/**
+ * Thuật toán Gaussian Elimination sử dụng MPI: lu_factor_mpi rồi thế xuôi
+ * L*y = P*b (b đã được hoán vị cùng các hàng, ghi đè b) và thế ngược U*x = y
+ * ngay trên dữ liệu phân tán
+ */
+int gaussian_elimination_mpi(LinearSystem *sys, int lookahead, StepTiming *timing) {
+    if (!lu_factor_mpi(sys, lookahead, timing)) {
+        return 0;
+    }
+    
+    triangular_solve_mpi(sys, sys->b, sys->b, 0);
+    triangular_solve_mpi(sys, sys->b, sys->x, 1);
+    
+    return 1;
+}
+
+/**
+ * Nghiệm đúng thứ j của các vế phải thêm (--rhs)
+ */
+static inline double extra_solution(int i, int j) {
+    return 1.0 + (i + j) % 10;
+}
+
+/**
+ * Tạo count vế phải b_j = A * x_j (tích phân tán) để thử giải nhiều lần với
+ * cùng A. Gọi trên mọi process, trước khi A bị ghi đè bởi LU.
+ */
+double* generate_extra_rhs_mpi(LinearSystem *sys, int count) {
+    int n = sys->n;
+    double *rhs = malloc((size_t)count * n * sizeof(double));
+    double *x_j = malloc(n * sizeof(double));
+    
+    for (int j = 0; j < count; j++) {
+        for (int i = 0; i < n; i++) {
+            x_j[i] = extra_solution(i, j);
+        }
+        matvec_mpi(sys, x_j, rhs + (size_t)j * n);
+    }
+    
+    free(x_j);
+    return rhs;
+}
+
+/**
+ * Giải count vế phải bằng LU đã có (gọi trên mọi process), trả về sai số
+ * lớn nhất so với nghiệm đúng
+ */
+double solve_extra_rhs_mpi(LinearSystem *sys, const double *rhs, int count) {
+    int n = sys->n;
+    double max_error = 0.0;
+    double *x = malloc(n * sizeof(double));
+    
+    for (int j = 0; j < count; j++) {
+        lu_solve_mpi(sys, rhs + (size_t)j * n, x);
+        for (int i = 0; i < n; i++) {
+            double error = fabs(x[i] - extra_solution(i, j));
+            if (error > max_error) {
+                max_error = error;
+            }
+        }
+    }
+    
+    free(x);
+    return max_error;
+}
+
+/**
+ * Hệ ba đường chéo phân hoạch theo các process của comm: mỗi process giữ
+ * các hàng [begin, begin + ts->n) và khử phần của mình độc lập, process 0
+ * giải hệ rút gọn 2*size ẩn từ hai hàng biên của mọi process (chỉ 6 số mỗi
+ * process), rồi trả lại x ở hai biên để mỗi process tự tính phần bên trong
+ */
+int tridiag_solve_mpi(TridiagSystem *ts, MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    int last = ts->n - 1;
+    const double *aa = ts->work;
+    const double *cc = ts->work + ts->n;
+    
+    int ok = tridiag_partition_reduce(ts, 0, ts->n);
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+    if (!ok) {
+        return 0;
+    }
+    
+    // Hai hàng biên: (aa, cc, dd) của hàng đầu và hàng cuối
+    double edge[6] = { aa[0], cc[0], ts->x[0], aa[last], cc[last], ts->x[last] };
+    double *edges = NULL, *reduced = NULL;
+    if (rank == 0) {
+        edges = malloc(6 * (size_t)size * sizeof(double));
+        reduced = malloc(8 * (size_t)size * sizeof(double));
+    }
+    MPI_Gather(edge, 6, MPI_DOUBLE, edges, 6, MPI_DOUBLE, 0, comm);
+    
+    if (rank == 0) {
+        int m = 2 * size;
+        double *sub = reduced, *sup = reduced + m;
+        double *rhs = reduced + 2 * m, *scratch = reduced + 3 * m;
+        for (int i = 0; i < m; i++) {
+            sub[i] = edges[3 * i];
+            sup[i] = edges[3 * i + 1];
+            rhs[i] = edges[3 * i + 2];
+        }
+        ok = tridiag_unit_thomas(m, sub, sup, rhs, scratch);
+    }
+    MPI_Bcast(&ok, 1, MPI_INT, 0, comm);
+    
+    double x_edge[2];
+    MPI_Scatter(rank == 0 ? reduced + 4 * size : NULL, 2, MPI_DOUBLE,
+                x_edge, 2, MPI_DOUBLE, 0, comm);
+    free(edges);
+    free(reduced);
+    if (!ok) {
+        return 0;
+    }
+    
+    ts->x[0] = x_edge[0];
+    ts->x[last] = x_edge[1];
+    tridiag_partition_finish(ts, 0, ts->n);
+    return 1;
+}
+
+/**
+ * Sai số ngược của hệ ba đường chéo phân tán: trao đổi một phần tử x với mỗi
+ * process kề (halo), chuẩn vô cùng gộp bằng MPI_Allreduce
+ */
+double tridiag_backward_error_mpi(const TridiagSystem *ts, MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    int last = ts->n - 1;
+    int prev = (rank > 0) ? rank - 1 : MPI_PROC_NULL;
+    int next = (rank < size - 1) ? rank + 1 : MPI_PROC_NULL;
+    double x_prev = 0.0, x_next = 0.0;
+    
+    MPI_Sendrecv(&ts->x[last], 1, MPI_DOUBLE, next, 0,
+                 &x_prev, 1, MPI_DOUBLE, prev, 0, comm, MPI_STATUS_IGNORE);
+    MPI_Sendrecv(&ts->x[0], 1, MPI_DOUBLE, prev, 1,
+                 &x_next, 1, MPI_DOUBLE, next, 1, comm, MPI_STATUS_IGNORE);
+    
+    // norms = {||A||, ||x||, ||b||, ||r||}
+    double norms[4] = { 0.0, 0.0, 0.0, 0.0 };
+    for (int i = 0; i <= last; i++) {
+        double left = (i > 0) ? ts->x[i - 1] : x_prev;
+        double right = (i < last) ? ts->x[i + 1] : x_next;
+        double r = ts->a[i] * left + ts->d[i] * ts->x[i] + ts->c[i] * right - ts->b[i];
+        double row_sum = fabs(ts->a[i]) + fabs(ts->d[i]) + fabs(ts->c[i]);
+        
+        if (row_sum > norms[0]) norms[0] = row_sum;
+        if (fabs(ts->x[i]) > norms[1]) norms[1] = fabs(ts->x[i]);
+        if (fabs(ts->b[i]) > norms[2]) norms[2] = fabs(ts->b[i]);
+        if (fabs(r) > norms[3]) norms[3] = fabs(r);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, norms, 4, MPI_DOUBLE, MPI_MAX, comm);
+    return norms[3] / (norms[0] * norms[1] + norms[2]);
+}
+
+// MPI do gauss_mpi_init khởi tạo (gauss_mpi_finalize mới kết thúc)
+static int gauss_mpi_owned = 0;
+
+int gauss_mpi_init(int *argc, char ***argv, int *rank) {
+    int initialized;
+    MPI_Initialized(&initialized);
+    if (!initialized) {
+        if (MPI_Init(argc, argv) != MPI_SUCCESS) {
+            *rank = 0;
+            return GAUSS_EENGINE;
+        }
+        gauss_mpi_owned = 1;
+    }
+    MPI_Comm_rank(MPI_COMM_WORLD, rank);
+    return GAUSS_OK;
+}
+
+void gauss_mpi_finalize(void) {
+    if (gauss_mpi_owned) {
+        MPI_Finalize();
+        gauss_mpi_owned = 0;
+    }
+}
+
+int gauss_mpi_processes(void) {
+    int initialized, size;
+    MPI_Initialized(&initialized);
+    if (!initialized) {
+        return 0;
+    }
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    return size;
+}
+
+/**
+ * Engine MPI của libgauss (gauss.h): mọi process của MPI_COMM_WORLD cùng gọi
+ * với hệ đầy đủ, mỗi process chỉ chép khối mình sở hữu (load_system) trên
+ * lưới gần vuông; nghiệm được broadcast nên x đủ n trên mọi process
+ */
+int gauss_solve_mpi(int n, const double *A, int lda, const double *b, double *x,
+                    int block_size) {
+    if (n <= 0 || lda < n || !A || !b || !x) {
+        return GAUSS_EINVAL;
+    }
+    if (gauss_mpi_processes() == 0) {
+        return GAUSS_EENGINE;
+    }
+    
+    int size, P, Q;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    grid_default_shape(size, &P, &Q);
+    ProcessGrid grid;
+    grid_init(&grid, P, Q);
+    
+    LinearSystem *sys = create_system_mpi(n, &grid, (block_size <= 0) ? DEFAULT_BLOCK_SIZE : block_size);
+    int all_ok = (sys != NULL);
+    MPI_Allreduce(MPI_IN_PLACE, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (!all_ok) {
+        free_system_mpi(sys);
+        grid_free(&grid);
+        return GAUSS_ENOMEM;
+    }
+    
+    load_system(sys, A, lda, b);
+    int ok = gaussian_elimination_mpi(sys, 1, NULL);
+    if (ok) {
+        memcpy(x, sys->x, n * sizeof(double));
+    }
+    
+    free_system_mpi(sys);
+    grid_free(&grid);
+    return ok ? GAUSS_OK : GAUSS_ESINGULAR;
+}
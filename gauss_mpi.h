@@ -0,0 +1,163 @@
+/**
+ * GAUSS MPI - PHẦN NỘI BỘ CỦA ENGINE MPI (libgauss) DÙNG CHUNG VỚI mpi.c
+ * Lưới process, hệ phân tán 2D block-cyclic (LinearSystem ở đây là phần cục
+ * bộ của mỗi process, khác LinearSystem dense của gauss_core.h) và các hàm
+ * của gauss_mpi.c; chương trình mpi.c chỉ giữ main, đọc tham số và in kết quả.
+ *
+ * Hàm của thư viện không in gì: lỗi báo qua giá trị trả về.
+ */
+
+#ifndef GAUSS_MPI_H
+#define GAUSS_MPI_H
+
+#include <stddef.h>
+#include <mpi.h>
+#include "gauss_simd.h"
+#include "gauss_tridiag.h"
+#include "gauss_io.h"
+#include "gauss_verify.h"
+#include "gauss.h"
+
+// Căn lề khối ma trận theo cache line (đủ cho cả AVX-512)
+#define MATRIX_ALIGN 64
+
+// Khối phân phối 2D block-cyclic, cũng là độ rộng panel. Nhỏ hơn bản shared
+// memory để các process lệch tải tối đa một khối ở cuối quá trình khử.
+#define DEFAULT_BLOCK_SIZE 32
+
+// Lưới process P x Q cho phân phối 2D block-cyclic
+typedef struct {
+    int rank, size;
+    int P, Q;               // Số hàng / cột của lưới
+    int prow, pcol;         // Tọa độ của process trong lưới (rank = prow * Q + pcol)
+    MPI_Comm row_comm;      // Các process cùng hàng lưới (rank trong comm = pcol)
+    MPI_Comm col_comm;      // Các process cùng cột lưới (rank trong comm = prow)
+} ProcessGrid;
+
+/**
+ * Tọa độ lưới sở hữu chỉ số idx (hàng vật lý hoặc cột) theo khối nb, vòng qua count process
+ */
+static inline int block_owner(int idx, int nb, int count) {
+    return (idx / nb) % count;
+}
+
+/**
+ * Số chỉ số < idx mà tọa độ coord sở hữu. Với idx thuộc coord đây chính là
+ * chỉ số cục bộ của nó; với idx = n là tổng số chỉ số sở hữu.
+ */
+static inline int local_index(int idx, int nb, int count, int coord) {
+    int blk = idx / nb;
+    int local = (blk / count) * nb;
+    if (blk % count > coord) {
+        local += nb;
+    } else if (blk % count == coord) {
+        local += idx % nb;
+    }
+    return local;
+}
+
+/**
+ * Chỉ số toàn cục của chỉ số cục bộ local thuộc tọa độ coord
+ */
+static inline int global_index(int local, int nb, int count, int coord) {
+    return ((local / nb) * count + coord) * nb + local % nb;
+}
+
+/**
+ * Leading dimension cho cols cột: pad lên bội số 8 double để đầu mọi hàng
+ * đều căn lề 64 byte, tránh bước hàng là bội số 4KB gây xung đột cache set
+ */
+static inline int padded_lda(int cols) {
+    int lda = (cols + 7) & ~7;
+    if (lda % 512 == 0) {
+        lda += 8;
+    }
+    return lda;
+}
+
+// Cấu trúc lưu trữ hệ phương trình: mỗi process chỉ giữ các khối nb x nb nó
+// sở hữu, xếp liền nhau thành ma trận cục bộ local_rows x local_cols
+typedef struct {
+    double *A;      // Ma trận cục bộ, một khối liên tục row-major
+    int lda;        // Leading dimension: khoảng cách (phần tử) giữa 2 hàng cục bộ
+    int *perm;      // Hoán vị hàng: hàng logic i nằm ở hàng vật lý perm[i] (giống nhau mọi process)
+    int *local_row; // Hàng vật lý -> hàng cục bộ, -1 nếu không sở hữu
+    double *b;      // Vector hằng số (theo thứ tự hàng logic, đủ n trên mọi process)
+    double *x;      // Vector nghiệm
+    int n;          // Kích thước ma trận
+    int nb;         // Khối phân phối
+    int local_rows; // Số hàng vật lý sở hữu
+    int local_cols; // Số cột sở hữu
+    ProcessGrid *grid;
+} LinearSystem;
+
+/**
+ * Con trỏ tới đầu hàng cục bộ của hàng logic i (chỉ hợp lệ khi row_owned);
+ * cột toàn cục j nằm ở vị trí local_col(sys, j)
+ */
+static inline double* row_ptr(LinearSystem *sys, int i) {
+    return sys->A + (size_t)sys->local_row[sys->perm[i]] * sys->lda;
+}
+
+/**
+ * Process có giữ hàng logic i không
+ */
+static inline int row_owned(LinearSystem *sys, int i) {
+    return sys->local_row[sys->perm[i]] >= 0;
+}
+
+/**
+ * Vị trí cục bộ của cột j; với j bất kỳ, các cột sở hữu >= j nằm liền nhau
+ * trong [local_col(sys, j), local_cols)
+ */
+static inline int local_col(LinearSystem *sys, int j) {
+    return local_index(j, sys->nb, sys->grid->Q, sys->grid->pcol);
+}
+
+/**
+ * Hoán đổi hai hàng logic trong O(1): chỉ đổi chỉ số hoán vị và b
+ */
+static inline void swap_rows(LinearSystem *sys, int r1, int r2) {
+    int tmp_perm = sys->perm[r1];
+    sys->perm[r1] = sys->perm[r2];
+    sys->perm[r2] = tmp_perm;
+
+    double tmp_b = sys->b[r1];
+    sys->b[r1] = sys->b[r2];
+    sys->b[r2] = tmp_b;
+}
+
+// Thời gian từng bước khử (mỗi bước một panel), lấy max trên các process
+typedef struct {
+    int steps;
+    double *factor;     // Phân tích panel (cột lưới sở hữu)
+    double *in_flight;  // Từ lúc khởi động broadcast pivot/panel L tới lúc nhận xong
+    double *exposed;    // Phần trong đó process bị chặn chờ (giao tiếp không che được)
+} StepTiming;
+
+/* ============ Engine MPI (gauss_mpi.c) ============ */
+
+void grid_init(ProcessGrid *grid, int P, int Q);
+void grid_free(ProcessGrid *grid);
+void grid_default_shape(int size, int *P, int *Q);
+
+LinearSystem* create_system_mpi(int n, ProcessGrid *grid, int nb);
+void free_system_mpi(LinearSystem *sys);
+void matvec_mpi(LinearSystem *sys, const double *x, double *y);
+void generate_test_system_mpi(LinearSystem *sys);
+void load_system(LinearSystem *sys, const double *A, size_t lda, const double *b);
+void scatter_system(LinearSystem *sys, const double *full_A, const double *full_b);
+double verify_solution_mpi(LinearSystem *sys, const VerifySource *src);
+
+void timing_init(StepTiming *timing, int n, int nb);
+void timing_free(StepTiming *timing);
+int lu_factor_mpi(LinearSystem *sys, int lookahead, StepTiming *timing);
+void lu_solve_mpi(LinearSystem *sys, const double *rhs, double *x);
+int gaussian_elimination_mpi(LinearSystem *sys, int lookahead, StepTiming *timing);
+double* generate_extra_rhs_mpi(LinearSystem *sys, int count);
+double solve_extra_rhs_mpi(LinearSystem *sys, const double *rhs, int count);
+
+int tridiag_solve_mpi(TridiagSystem *ts, MPI_Comm comm);
+double tridiag_backward_error_mpi(const TridiagSystem *ts, MPI_Comm comm);
+
+#endif /* GAUSS_MPI_H */
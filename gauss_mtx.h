@@ -0,0 +1,498 @@
+/**
+ * GAUSS MTX - ĐỌC MATRIX MARKET (.mtx) SONG SONG
+ * File được mmap, phần dữ liệu sau dòng kích thước chia thành các đoạn byte
+ * cắt ở đầu dòng; mỗi đoạn đếm số dòng dữ liệu (pha 1), tổng tiền tố cho vị
+ * trí phần tử đầu của từng đoạn, rồi parse độc lập (pha 2) ghi thẳng vào
+ * ma trận dense hoặc mảng toạ độ. Backend chia các đoạn cho luồng; header chỉ
+ * cung cấp các bước trên một đoạn.
+ *
+ * Hỗ trợ: matrix coordinate (real/integer/pattern; general/symmetric/
+ * skew-symmetric) và matrix array real/integer general; ma trận phải vuông.
+ * Số thực parse bằng tay (không strtod/scanf): tối đa 19 chữ số có nghĩa,
+ * đúng tuyệt đối khi mantissa <= 2^53 và |số mũ| <= 22 (fast path Clinger),
+ * ngoài ra sai số vài ulp. Phần tử trùng trong coordinate được cộng dồn khi
+ * tạo CSR; khi ghi dense giả định không trùng (như chuẩn quy định).
+ */
+
+#ifndef GAUSS_MTX_H
+#define GAUSS_MTX_H
+
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "gauss_sparse.h"
+
+// Mã lỗi
+enum {
+    MTX_OK = 0,
+    MTX_EOPEN,          // Không mở/map được file
+    MTX_EFORMAT,        // Thiếu banner hoặc dòng kích thước
+    MTX_EUNSUPPORTED,   // complex/hermitian, array đối xứng, vector...
+    MTX_ESHAPE,         // Ma trận không vuông
+    MTX_EPARSE          // Số hỏng, chỉ số ngoài phạm vi, sai số phần tử
+};
+
+enum { MTX_GENERAL, MTX_SYMMETRIC, MTX_SKEW };
+
+typedef struct {
+    const char *data;   // Vùng map của cả file
+    size_t size;
+    size_t body;        // Byte đầu tiên sau dòng kích thước
+    int n;
+    long nnz;           // Số dòng dữ liệu cần có
+    int coordinate;     // 1: coordinate, 0: array
+    int pattern;        // Không có giá trị (= 1.0)
+    int symmetry;
+} MtxFile;
+
+static inline const char* mtx_strerror(int code) {
+    switch (code) {
+        case MTX_OK:           return "thành công";
+        case MTX_EOPEN:        return "không mở được file";
+        case MTX_EFORMAT:      return "thiếu banner %%MatrixMarket hoặc dòng kích thước";
+        case MTX_EUNSUPPORTED: return "kiểu Matrix Market chưa hỗ trợ";
+        case MTX_ESHAPE:       return "ma trận không vuông";
+        case MTX_EPARSE:       return "dữ liệu hỏng (số, chỉ số hoặc số phần tử)";
+    }
+    return "lỗi không xác định";
+}
+
+/**
+ * Tên file kết thúc bằng .mtx
+ */
+static inline int mtx_is_path(const char *path) {
+    size_t len = strlen(path);
+    return len >= 4 && strcmp(path + len - 4, ".mtx") == 0;
+}
+
+static inline int mtx_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * So khớp từ khoá không phân biệt hoa thường, tiến p qua từ đó
+ */
+static inline int mtx_keyword(const char **p, const char *end, const char *word) {
+    const char *q = *p;
+    while (q < end && mtx_space(*q)) q++;
+    size_t len = strlen(word);
+    if ((size_t)(end - q) < len) {
+        return 0;
+    }
+    for (size_t i = 0; i < len; i++) {
+        char c = q[i];
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        if (c != word[i]) {
+            return 0;
+        }
+    }
+    if (q + len < end && !mtx_space(q[len]) && q[len] != '\n') {
+        return 0;
+    }
+    *p = q + len;
+    return 1;
+}
+
+/**
+ * Số nguyên không dấu; trả về NULL nếu không có chữ số hoặc tràn long
+ */
+static inline const char* mtx_parse_long(const char *p, const char *end, long *out) {
+    while (p < end && mtx_space(*p)) p++;
+    if (p >= end || *p < '0' || *p > '9') {
+        return NULL;
+    }
+    long v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        int d = *p++ - '0';
+        if (v > (LONG_MAX - d) / 10) {
+            return NULL;
+        }
+        v = v * 10 + d;
+    }
+    *out = v;
+    return p;
+}
+
+/**
+ * Số thực dạng [+-]digits[.digits][(e|E)[+-]digits]; trả về NULL nếu hỏng
+ * hoặc tràn double (1e400 không được thành inf)
+ */
+static inline const char* mtx_parse_double(const char *p, const char *end, double *out) {
+    static const double pow10[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    while (p < end && mtx_space(*p)) p++;
+    int negative = 0;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p++ == '-');
+    }
+
+    uint64_t mant = 0;
+    int digits = 0, exp10 = 0, any = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (digits < 19) {
+            mant = mant * 10 + (uint64_t)(*p - '0');
+            digits += (mant != 0);
+        } else {
+            exp10++;
+        }
+        p++;
+        any = 1;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (digits < 19) {
+                mant = mant * 10 + (uint64_t)(*p - '0');
+                digits += (mant != 0);
+                exp10--;
+            }
+            p++;
+            any = 1;
+        }
+    }
+    if (!any) {
+        return NULL;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        int exp_negative = 0;
+        if (p < end && (*p == '-' || *p == '+')) {
+            exp_negative = (*p++ == '-');
+        }
+        if (p >= end || *p < '0' || *p > '9') {
+            return NULL;
+        }
+        int e = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (e < 100000) {
+                e = e * 10 + (*p - '0');
+            }
+            p++;
+        }
+        exp10 += exp_negative ? -e : e;
+    }
+
+    double v = (double)mant;
+    if (mant != 0) {
+        if (exp10 > 0) {
+            for (; exp10 > 22 && v < 1e308; exp10 -= 22) v *= 1e22;
+            v *= pow10[exp10 > 22 ? 22 : exp10];
+        } else if (exp10 < 0) {
+            for (; exp10 < -22 && v > 0.0; exp10 += 22) v /= 1e22;
+            v /= pow10[exp10 < -22 ? 22 : -exp10];
+        }
+    }
+    if (!isfinite(v)) {
+        return NULL;
+    }
+    *out = negative ? -v : v;
+    return p;
+}
+
+/**
+ * Đầu dòng kế tiếp sau p (hoặc end)
+ */
+static inline const char* mtx_next_line(const char *p, const char *end) {
+    const char *nl = memchr(p, '\n', end - p);
+    return nl ? nl + 1 : end;
+}
+
+/**
+ * Dòng bắt đầu ở p là dòng dữ liệu (không trống, không phải chú thích)
+ */
+static inline int mtx_data_line(const char *p, const char *end) {
+    while (p < end && mtx_space(*p)) p++;
+    return p < end && *p != '\n' && *p != '%';
+}
+
+static inline void mtx_close(MtxFile *f) {
+    if (f->data) {
+        munmap((void*)f->data, f->size);
+    }
+    memset(f, 0, sizeof(MtxFile));
+}
+
+/**
+ * Map file, đọc banner và dòng kích thước. Trả về MTX_OK hoặc mã lỗi.
+ */
+static inline int mtx_open(const char *path, MtxFile *f) {
+    memset(f, 0, sizeof(MtxFile));
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+        if (fd >= 0) close(fd);
+        return MTX_EOPEN;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return MTX_EOPEN;
+    }
+    f->data = map;
+    f->size = st.st_size;
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+    const char *p = f->data, *end = f->data + f->size;
+    if ((size_t)(end - p) < 14 || memcmp(p, "%%MatrixMarket", 14) != 0) {
+        mtx_close(f);
+        return MTX_EFORMAT;
+    }
+    p += 14;
+    if (!mtx_keyword(&p, end, "matrix")) {
+        mtx_close(f);
+        return MTX_EUNSUPPORTED;
+    }
+    if (mtx_keyword(&p, end, "coordinate")) {
+        f->coordinate = 1;
+    } else if (!mtx_keyword(&p, end, "array")) {
+        mtx_close(f);
+        return MTX_EUNSUPPORTED;
+    }
+    if (f->coordinate && mtx_keyword(&p, end, "pattern")) {
+        f->pattern = 1;
+    } else if (!mtx_keyword(&p, end, "real") && !mtx_keyword(&p, end, "integer")) {
+        mtx_close(f);
+        return MTX_EUNSUPPORTED;
+    }
+    if (mtx_keyword(&p, end, "symmetric")) {
+        f->symmetry = MTX_SYMMETRIC;
+    } else if (mtx_keyword(&p, end, "skew-symmetric")) {
+        f->symmetry = MTX_SKEW;
+    } else if (!mtx_keyword(&p, end, "general")) {
+        mtx_close(f);
+        return MTX_EUNSUPPORTED;
+    }
+    if (!f->coordinate && f->symmetry != MTX_GENERAL) {
+        mtx_close(f);
+        return MTX_EUNSUPPORTED;
+    }
+
+    // Bỏ qua chú thích tới dòng kích thước
+    p = mtx_next_line(p, end);
+    while (p < end && !mtx_data_line(p, end)) {
+        p = mtx_next_line(p, end);
+    }
+    long rows, cols, count = 0;
+    const char *q = mtx_parse_long(p, end, &rows);
+    q = q ? mtx_parse_long(q, end, &cols) : NULL;
+    if (q && f->coordinate) {
+        q = mtx_parse_long(q, end, &count);
+    }
+    if (!q || rows <= 0 || cols <= 0) {
+        mtx_close(f);
+        return MTX_EFORMAT;
+    }
+    if (rows != cols || rows > INT32_MAX) {
+        mtx_close(f);
+        return MTX_ESHAPE;
+    }
+    f->n = (int)rows;
+    f->nnz = f->coordinate ? count : rows * cols;
+    f->body = mtx_next_line(q, end) - f->data;
+    return MTX_OK;
+}
+
+/**
+ * Chia phần dữ liệu thành parts đoạn cắt ở đầu dòng: đoạn t là
+ * [bounds[t], bounds[t+1])
+ */
+static inline void mtx_split(const MtxFile *f, int parts, size_t *bounds) {
+    const char *end = f->data + f->size;
+    size_t len = f->size - f->body;
+    bounds[0] = f->body;
+    for (int t = 1; t < parts; t++) {
+        size_t pos = f->body + len / parts * t;
+        if (pos <= bounds[t - 1]) {
+            pos = bounds[t - 1];
+        } else if (f->data[pos - 1] != '\n') {
+            pos = mtx_next_line(f->data + pos, end) - f->data;
+        }
+        bounds[t] = pos;
+    }
+    bounds[parts] = f->size;
+}
+
+/**
+ * Số dòng dữ liệu trong đoạn [begin, end)
+ */
+static inline long mtx_count(const MtxFile *f, size_t begin, size_t end) {
+    const char *p = f->data + begin, *stop = f->data + end;
+    long lines = 0;
+    while (p < stop) {
+        lines += mtx_data_line(p, stop);
+        p = mtx_next_line(p, stop);
+    }
+    return lines;
+}
+
+/**
+ * Parse một dòng dữ liệu: chỉ số (0-based) và giá trị. Với array, phần tử
+ * thứ k (theo cột) nằm ở hàng k % n, cột k / n.
+ */
+static inline const char* mtx_parse_entry(const MtxFile *f, const char *p, const char *end,
+                                          long k, int *row, int *col, double *val) {
+    if (f->coordinate) {
+        long i, j;
+        p = mtx_parse_long(p, end, &i);
+        p = p ? mtx_parse_long(p, end, &j) : NULL;
+        if (!p || i < 1 || i > f->n || j < 1 || j > f->n) {
+            return NULL;
+        }
+        *row = (int)(i - 1);
+        *col = (int)(j - 1);
+    } else {
+        *row = (int)(k % f->n);
+        *col = (int)(k / f->n);
+    }
+    if (f->pattern) {
+        *val = 1.0;
+        return p;
+    }
+    return mtx_parse_double(p, end, val);
+}
+
+/**
+ * Parse đoạn [begin, end) vào ma trận dense row-major A (bước lda, đã điền
+ * 0); first là số thứ tự dòng dữ liệu đầu đoạn (tổng tiền tố của mtx_count).
+ * Đối xứng / phản đối xứng ghi thêm phần tử đối diện. Trả về số phần tử đã
+ * đọc, -1 nếu lỗi.
+ */
+static inline long mtx_parse_dense(const MtxFile *f, size_t begin, size_t end, long first,
+                                  double *A, int lda) {
+    const char *p = f->data + begin, *stop = f->data + end;
+    long k = first;
+    while (p < stop) {
+        if (mtx_data_line(p, stop)) {
+            int i, j;
+            double v;
+            if (k >= f->nnz || !mtx_parse_entry(f, p, stop, k, &i, &j, &v)) {
+                return -1;
+            }
+            A[(size_t)i * lda + j] = v;
+            if (f->symmetry != MTX_GENERAL && i != j) {
+                A[(size_t)j * lda + i] = (f->symmetry == MTX_SKEW) ? -v : v;
+            }
+            k++;
+        }
+        p = mtx_next_line(p, stop);
+    }
+    return k - first;
+}
+
+/**
+ * Parse đoạn [begin, end) của file coordinate vào mảng toạ độ ở vị trí
+ * first .. (rows, cols 0-based). Trả về số phần tử đã đọc, -1 nếu lỗi.
+ */
+static inline long mtx_parse_coo(const MtxFile *f, size_t begin, size_t end, long first,
+                                int *rows, int *cols, double *vals) {
+    const char *p = f->data + begin, *stop = f->data + end;
+    long k = first;
+    while (p < stop) {
+        if (mtx_data_line(p, stop)) {
+            if (k >= f->nnz || !mtx_parse_entry(f, p, stop, k, &rows[k], &cols[k], &vals[k])) {
+                return -1;
+            }
+            k++;
+        }
+        p = mtx_next_line(p, stop);
+    }
+    return k - first;
+}
+
+/**
+ * Tạo CSR từ mảng toạ độ (nnz phần tử, đã đủ), mở rộng phần đối xứng, sắp
+ * cột tăng dần trong mỗi hàng và cộng dồn phần tử trùng
+ */
+static inline SparseMatrix* mtx_coo_to_csr(const MtxFile *f, const int *rows, const int *cols,
+                                           const double *vals) {
+    int n = f->n;
+    long nnz = f->nnz;
+    int *count = calloc((size_t)n + 1, sizeof(int));
+    long total = 0;
+    for (long k = 0; k < nnz; k++) {
+        count[rows[k] + 1]++;
+        total++;
+        if (f->symmetry != MTX_GENERAL && rows[k] != cols[k]) {
+            count[cols[k] + 1]++;
+            total++;
+        }
+    }
+    if (total > INT32_MAX) {
+        free(count);
+        return NULL;
+    }
+    SparseMatrix *A = sparse_create(n, (int)total);
+    if (!A) {
+        free(count);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        count[i + 1] += count[i];
+    }
+    memcpy(A->p, count, ((size_t)n + 1) * sizeof(int));
+    for (long k = 0; k < nnz; k++) {
+        int pos = count[rows[k]]++;
+        A->j[pos] = cols[k];
+        A->x[pos] = vals[k];
+        if (f->symmetry != MTX_GENERAL && rows[k] != cols[k]) {
+            pos = count[cols[k]]++;
+            A->j[pos] = rows[k];
+            A->x[pos] = (f->symmetry == MTX_SKEW) ? -vals[k] : vals[k];
+        }
+    }
+    free(count);
+
+    // Sắp chèn theo cột (hàng thưa ngắn), gộp trùng rồi nén lại
+    int out = 0;
+    for (int i = 0; i < n; i++) {
+        int begin = A->p[i], end = A->p[i + 1];
+        for (int a = begin + 1; a < end; a++) {
+            int c = A->j[a];
+            double v = A->x[a];
+            int b = a - 1;
+            while (b >= begin && A->j[b] > c) {
+                A->j[b + 1] = A->j[b];
+                A->x[b + 1] = A->x[b];
+                b--;
+            }
+            A->j[b + 1] = c;
+            A->x[b + 1] = v;
+        }
+        A->p[i] = out;
+        for (int a = begin; a < end; a++) {
+            if (out > A->p[i] && A->j[out - 1] == A->j[a]) {
+                A->x[out - 1] += A->x[a];
+            } else {
+                A->j[out] = A->j[a];
+                A->x[out] = A->x[a];
+                out++;
+            }
+        }
+    }
+    A->p[n] = out;
+    A->nnz = out;
+    return A;
+}
+
+/**
+ * Vế phải b = A * x với nghiệm của hệ test thưa (sparse_test_solution)
+ */
+static inline void mtx_test_rhs(const SparseMatrix *A, double *b) {
+    for (int i = 0; i < A->n; i++) {
+        double sum = 0.0;
+        for (int q = A->p[i]; q < A->p[i + 1]; q++) {
+            sum += A->x[q] * sparse_test_solution(A->j[q]);
+        }
+        b[i] = sum;
+    }
+}
+
+#endif /* GAUSS_MTX_H */
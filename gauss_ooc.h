@@ -0,0 +1,642 @@
+/**
+ * GAUSS OOC - LU NGOÀI BỘ NHỚ (OUT-OF-CORE) THEO PANEL CỘT
+ * Ma trận n x n nằm trong file trên đĩa cục bộ, chia thành các panel w cột
+ * (mỗi panel n x w row-major liên tục, mỗi khối w x w của panel là một tile).
+ * Bộ nhớ chỉ cần OOC_BUFFERS panel nên n bị giới hạn bởi dung lượng đĩa
+ * thay vì RAM.
+ *
+ * LU left-looking: panel j được đọc vào bộ nhớ, nhận lần lượt cập nhật từ
+ * các panel 0 .. j-1 đã phân tích (đổi hàng, U_kj = L_kk^-1 * A_kj,
+ * A_j -= L_k * U_kj), rồi phân tích với pivot theo cột và ghi lại file. Các
+ * lần đổi hàng của panel sau không áp dụng ngược lên L của panel trước (như
+ * LAPACK khi giải theo từng panel), nên lúc giải b cũng được đổi hàng theo
+ * từng panel.
+ *
+ * Chuỗi các lần đọc biết trước (OocStream), nên một luồng I/O đọc trước
+ * bằng pread vào buffer trống trong khi luồng tính toán xử lý panel hiện tại
+ * (đệm kép cho panel L_k, thêm một buffer cho panel đang phân tích). Thống kê
+ * lưu lượng I/O, thời gian đọc và thời gian phải chờ đọc để báo cáo mức che
+ * được I/O.
+ *
+ * Các bước trên một dải hàng (ooc_update_rows, ooc_update_panel_rows) tách
+ * riêng để backend song song chia hàng cho các luồng; ooc_factor là bản tuần tự.
+ */
+
+#ifndef GAUSS_OOC_H
+#define GAUSS_OOC_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+#include "gauss_simd.h"
+
+// Số buffer panel: panel đang phân tích + đệm kép cho các panel L_k
+#define OOC_BUFFERS 3
+
+// Độ rộng khối cột khi phân tích trong một panel
+#define OOC_SUB_BLOCK 64
+
+// Bộ nhớ mặc định cho các buffer panel (MB)
+#define OOC_DEFAULT_MB 256
+
+// Ma trận trong file: panel j bắt đầu ở phần tử j*w*n, hàng r của panel ở
+// j*w*n + r*wj (wj = độ rộng panel j, panel cuối có thể hẹp hơn)
+typedef struct {
+    int fd;
+    char path[4096];
+    int n;
+    int w;              // Độ rộng panel
+    int npanels;
+    int *ipiv;          // Cột g đã đổi hàng g với hàng ipiv[g] (cùng thời điểm)
+    double *b;          // Vế phải (không bị sửa khi giải)
+    double *x;          // Nghiệm
+
+    // Thống kê I/O
+    double bytes_read;
+    double bytes_written;
+    double read_time;   // Thời gian luồng I/O nằm trong pread
+    double write_time;  // Thời gian ghi panel (luồng tính toán chờ)
+    double wait_time;   // Thời gian luồng tính toán chờ panel chưa đọc xong
+} OocMatrix;
+
+// Một lần đọc trong chuỗi: hàng row0 .. row1-1 của panel, chỉ được đọc khi
+// đã ghi xong after panel đầu (panel L phải đọc sau khi phân tích xong)
+typedef struct {
+    int panel;
+    int row0, row1;
+    int after;
+} OocRead;
+
+// Luồng đọc trước: đọc chuỗi plan theo thứ tự vào các buffer trống
+typedef struct {
+    OocMatrix *m;
+    OocRead *plan;
+    int len;
+    double *buf[OOC_BUFFERS];
+    int *entry_buf;     // Buffer của lần đọc thứ e
+    int free_list[OOC_BUFFERS];
+    int nfree;
+    int issued;         // Số lần đọc đã giao cho luồng I/O
+    int done;           // Số lần đọc đã xong
+    int consumed;       // Số lần đọc luồng tính toán đã nhận
+    int written;        // Số panel đầu đã ghi xong về file
+    int quit;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} OocStream;
+
+static inline double ooc_now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static inline int ooc_panel_width(const OocMatrix *m, int j) {
+    return (m->n - j * m->w < m->w) ? m->n - j * m->w : m->w;
+}
+
+static inline off_t ooc_offset(const OocMatrix *m, int j, int row) {
+    return ((off_t)j * m->w * m->n + (off_t)row * ooc_panel_width(m, j)) * (off_t)sizeof(double);
+}
+
+/**
+ * pread / pwrite đủ số byte (một lần gọi có thể trả về ít hơn yêu cầu)
+ */
+static inline int ooc_io(int fd, void *buf, size_t bytes, off_t off, int write_mode) {
+    char *p = buf;
+    while (bytes > 0) {
+        ssize_t r = write_mode ? pwrite(fd, p, bytes, off) : pread(fd, p, bytes, off);
+        if (r <= 0) {
+            return 0;
+        }
+        p += r;
+        off += r;
+        bytes -= r;
+    }
+    return 1;
+}
+
+/**
+ * Độ rộng panel để OOC_BUFFERS panel vừa mem_mb MB (bội số 8, 8 .. n)
+ */
+static inline int ooc_choose_width(int n, double mem_mb) {
+    double w = mem_mb * 1e6 / ((double)OOC_BUFFERS * n * sizeof(double));
+    int width = (w >= n) ? n : ((int)w & ~7);
+    return (width < 8) ? ((n < 8) ? n : 8) : width;
+}
+
+/**
+ * Tạo file ma trận (mkstemp trong thư mục dir, xóa tên ngay để file tự mất
+ * khi đóng) cho ma trận n x n với panel w cột. Trả về NULL nếu lỗi.
+ */
+static inline OocMatrix* ooc_create(int n, int w, const char *dir) {
+    OocMatrix *m = calloc(1, sizeof(OocMatrix));
+    m->n = n;
+    m->w = w;
+    m->npanels = (n + w - 1) / w;
+    snprintf(m->path, sizeof(m->path), "%s/gauss_ooc_XXXXXX", dir);
+    m->fd = mkstemp(m->path);
+    if (m->fd < 0) {
+        free(m);
+        return NULL;
+    }
+    unlink(m->path);
+    if (ftruncate(m->fd, (off_t)n * n * (off_t)sizeof(double)) != 0) {
+        close(m->fd);
+        free(m);
+        return NULL;
+    }
+    m->ipiv = malloc((size_t)n * sizeof(int));
+    m->b = calloc((size_t)n, sizeof(double));
+    m->x = calloc((size_t)n, sizeof(double));
+    return m;
+}
+
+static inline void ooc_free(OocMatrix *m) {
+    if (!m) return;
+
+    close(m->fd);
+    free(m->ipiv);
+    free(m->b);
+    free(m->x);
+    free(m);
+}
+
+/**
+ * Phần tử (i, j) của hệ test: ngẫu nhiên giả trong [-0.5, 0.5), không trội
+ * chéo nên phải đổi hàng thật
+ */
+static inline double ooc_test_entry(int i, int j) {
+    uint32_t h = ((uint32_t)i * 40503u + (uint32_t)j * 9973u + 11u) * 2654435761u;
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    return h / 4294967296.0 - 0.5;
+}
+
+static inline double ooc_test_solution(int i) {
+    return 1.0 + i % 10;
+}
+
+/**
+ * Ghi hệ test vào file từng panel (buf cần n * w phần tử), b = A * x_đúng
+ */
+static inline int ooc_fill_test(OocMatrix *m, double *buf) {
+    int n = m->n;
+    memset(m->b, 0, (size_t)n * sizeof(double));
+    for (int j = 0; j < m->npanels; j++) {
+        int wj = ooc_panel_width(m, j);
+        int j0 = j * m->w;
+        for (int i = 0; i < n; i++) {
+            double *row = buf + (size_t)i * wj;
+            for (int c = 0; c < wj; c++) {
+                row[c] = ooc_test_entry(i, j0 + c);
+                m->b[i] += row[c] * ooc_test_solution(j0 + c);
+            }
+        }
+        if (!ooc_io(m->fd, buf, (size_t)n * wj * sizeof(double), ooc_offset(m, j, 0), 1)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Ghi panel j (đủ n hàng) về file
+ */
+static inline int ooc_write_panel(OocMatrix *m, int j, const double *panel) {
+    size_t bytes = (size_t)m->n * ooc_panel_width(m, j) * sizeof(double);
+    double t0 = ooc_now();
+    int ok = ooc_io(m->fd, (void*)panel, bytes, ooc_offset(m, j, 0), 1);
+    m->write_time += ooc_now() - t0;
+    m->bytes_written += bytes;
+    return ok;
+}
+
+/**
+ * Luồng I/O: đọc lần lượt các mục của plan vào buffer đã gán
+ */
+static inline void* ooc_stream_main(void *arg) {
+    OocStream *st = arg;
+    OocMatrix *m = st->m;
+
+    pthread_mutex_lock(&st->lock);
+    for (;;) {
+        while (!st->quit && st->done == st->issued) {
+            pthread_cond_wait(&st->cond, &st->lock);
+        }
+        if (st->quit) {
+            break;
+        }
+        int e = st->done;
+        OocRead r = st->plan[e];
+        double *dst = st->buf[st->entry_buf[e]];
+        pthread_mutex_unlock(&st->lock);
+
+        size_t bytes = (size_t)(r.row1 - r.row0) * ooc_panel_width(m, r.panel) * sizeof(double);
+        double t0 = ooc_now();
+        ooc_io(m->fd, dst, bytes, ooc_offset(m, r.panel, r.row0), 0);
+        double elapsed = ooc_now() - t0;
+
+        pthread_mutex_lock(&st->lock);
+        m->read_time += elapsed;
+        m->bytes_read += bytes;
+        st->done++;
+        pthread_cond_broadcast(&st->cond);
+    }
+    pthread_mutex_unlock(&st->lock);
+    return NULL;
+}
+
+/**
+ * Giao các lần đọc kế tiếp cho luồng I/O khi còn buffer trống (giữ lock)
+ */
+static inline void ooc_stream_issue(OocStream *st) {
+    while (st->nfree > 0 && st->issued < st->len && st->plan[st->issued].after <= st->written) {
+        st->entry_buf[st->issued++] = st->free_list[--st->nfree];
+    }
+    pthread_cond_broadcast(&st->cond);
+}
+
+/**
+ * Mở luồng đọc trước cho plan (len mục); mỗi buffer chứa một panel đầy đủ
+ */
+static inline OocStream* ooc_stream_open(OocMatrix *m, OocRead *plan, int len) {
+    OocStream *st = calloc(1, sizeof(OocStream));
+    st->m = m;
+    st->plan = plan;
+    st->len = len;
+    st->entry_buf = malloc(((size_t)len + 1) * sizeof(int));
+    for (int t = 0; t < OOC_BUFFERS; t++) {
+        if (posix_memalign((void**)&st->buf[t], 64, (size_t)m->n * m->w * sizeof(double)) != 0) {
+            for (int u = 0; u < t; u++) {
+                free(st->buf[u]);
+            }
+            free(st->entry_buf);
+            free(st);
+            return NULL;
+        }
+        st->free_list[st->nfree++] = OOC_BUFFERS - 1 - t;
+    }
+    pthread_mutex_init(&st->lock, NULL);
+    pthread_cond_init(&st->cond, NULL);
+    if (pthread_create(&st->thread, NULL, ooc_stream_main, st) != 0) {
+        for (int t = 0; t < OOC_BUFFERS; t++) {
+            free(st->buf[t]);
+        }
+        free(st->entry_buf);
+        free(st);
+        return NULL;
+    }
+    pthread_mutex_lock(&st->lock);
+    ooc_stream_issue(st);
+    pthread_mutex_unlock(&st->lock);
+    return st;
+}
+
+/**
+ * Nhận buffer của lần đọc kế tiếp trong plan (chờ nếu chưa đọc xong)
+ */
+static inline double* ooc_stream_next(OocStream *st) {
+    pthread_mutex_lock(&st->lock);
+    int e = st->consumed++;
+    if (st->done <= e) {
+        double t0 = ooc_now();
+        while (st->done <= e) {
+            pthread_cond_wait(&st->cond, &st->lock);
+        }
+        st->m->wait_time += ooc_now() - t0;
+    }
+    double *buf = st->buf[st->entry_buf[e]];
+    pthread_mutex_unlock(&st->lock);
+    return buf;
+}
+
+/**
+ * Trả buffer đã dùng xong; luồng I/O đọc tiếp mục kế vào đó
+ */
+static inline void ooc_stream_release(OocStream *st, const double *buf) {
+    pthread_mutex_lock(&st->lock);
+    for (int t = 0; t < OOC_BUFFERS; t++) {
+        if (st->buf[t] == buf) {
+            st->free_list[st->nfree++] = t;
+        }
+    }
+    ooc_stream_issue(st);
+    pthread_mutex_unlock(&st->lock);
+}
+
+/**
+ * Báo panel 0 .. count-1 đã ghi xong để luồng I/O được đọc lại chúng
+ */
+static inline void ooc_stream_written(OocStream *st, int count) {
+    pthread_mutex_lock(&st->lock);
+    st->written = count;
+    ooc_stream_issue(st);
+    pthread_mutex_unlock(&st->lock);
+}
+
+static inline void ooc_stream_close(OocStream *st) {
+    pthread_mutex_lock(&st->lock);
+    st->quit = 1;
+    pthread_cond_broadcast(&st->cond);
+    pthread_mutex_unlock(&st->lock);
+    pthread_join(st->thread, NULL);
+
+    pthread_mutex_destroy(&st->lock);
+    pthread_cond_destroy(&st->cond);
+    for (int t = 0; t < OOC_BUFFERS; t++) {
+        free(st->buf[t]);
+    }
+    free(st->entry_buf);
+    free(st);
+}
+
+/**
+ * Chuỗi đọc của LU left-looking: panel j đủ n hàng, rồi phần L (từ hàng
+ * k*w) của các panel k < j. Trả về số mục.
+ */
+static inline int ooc_factor_plan(const OocMatrix *m, OocRead **plan) {
+    int np = m->npanels;
+    int len = np + np * (np - 1) / 2;
+    OocRead *p = malloc(((size_t)len + 1) * sizeof(OocRead));
+    int e = 0;
+    for (int j = 0; j < np; j++) {
+        p[e++] = (OocRead){ j, 0, m->n, 0 };
+        for (int k = 0; k < j; k++) {
+            p[e++] = (OocRead){ k, k * m->w, m->n, k + 1 };
+        }
+    }
+    *plan = p;
+    return len;
+}
+
+/**
+ * Áp dụng panel k (buffer Lk, hàng từ k*w) lên panel hiện tại cur (n hàng,
+ * bước wj): đổi hàng của panel k rồi U_kj = L_kk^-1 * A_kj
+ */
+static inline void ooc_apply_panel(const OocMatrix *m, double *cur, int wj, const double *Lk, int k) {
+    int k0 = k * m->w;
+    int wk = m->w;
+    for (int r = k0; r < k0 + wk; r++) {
+        int p = m->ipiv[r];
+        if (p != r) {
+            double *r1 = cur + (size_t)r * wj, *r2 = cur + (size_t)p * wj;
+            for (int c = 0; c < wj; c++) {
+                double tmp = r1[c];
+                r1[c] = r2[c];
+                r2[c] = tmp;
+            }
+        }
+    }
+    for (int i = 1; i < wk; i++) {
+        const double *l_row = Lk + (size_t)i * wk;
+        double *row_i = cur + (size_t)(k0 + i) * wj;
+        for (int p = 0; p < i; p++) {
+            simd_axpy(wj, -l_row[p], cur + (size_t)(k0 + p) * wj, row_i);
+        }
+    }
+}
+
+/**
+ * A_j -= L_k * U_kj cho các hàng row_begin .. row_end-1 (>= (k+1)*w), gộp 4
+ * hàng U mỗi lượt
+ */
+static inline void ooc_update_rows(const OocMatrix *m, double *cur, int wj, const double *Lk, int k,
+                                   int row_begin, int row_end) {
+    int k0 = k * m->w;
+    int wk = m->w;
+    for (int i = row_begin; i < row_end; i++) {
+        const double *l_row = Lk + (size_t)(i - k0) * wk;
+        double *row_i = cur + (size_t)i * wj;
+        int p = 0;
+        for (; p + 3 < wk; p += 4) {
+            double l[4] = { -l_row[p], -l_row[p+1], -l_row[p+2], -l_row[p+3] };
+            simd_axpy4(wj, l, cur + (size_t)(k0 + p) * wj, cur + (size_t)(k0 + p + 1) * wj,
+                       cur + (size_t)(k0 + p + 2) * wj, cur + (size_t)(k0 + p + 3) * wj, row_i);
+        }
+        for (; p < wk; p++) {
+            simd_axpy(wj, -l_row[p], cur + (size_t)(k0 + p) * wj, row_i);
+        }
+    }
+}
+
+/**
+ * Phân tích khối cột c0 .. c0+cb-1 của panel j (cột toàn cục j0 + c) trên
+ * mọi hàng từ đường chéo xuống, chọn pivot theo cột; rồi khối hàng U của
+ * các cột còn lại trong panel. Trả về 0 nếu pivot ≈ 0.
+ */
+static inline int ooc_factor_block(OocMatrix *m, double *cur, int wj, int j0, int c0, int cb) {
+    int n = m->n;
+    int c_end = c0 + cb;
+
+    for (int c = c0; c < c_end; c++) {
+        int g = j0 + c;
+        int max_row = g;
+        double max_val = fabs(cur[(size_t)g * wj + c]);
+        for (int i = g + 1; i < n; i++) {
+            double val = fabs(cur[(size_t)i * wj + c]);
+            if (val > max_val) {
+                max_val = val;
+                max_row = i;
+            }
+        }
+        if (max_val < 1e-12) {
+            return 0;
+        }
+        m->ipiv[g] = max_row;
+        if (max_row != g) {
+            double *r1 = cur + (size_t)g * wj, *r2 = cur + (size_t)max_row * wj;
+            for (int t = 0; t < wj; t++) {
+                double tmp = r1[t];
+                r1[t] = r2[t];
+                r2[t] = tmp;
+            }
+        }
+
+        double *row_g = cur + (size_t)g * wj;
+        for (int i = g + 1; i < n; i++) {
+            double *row_i = cur + (size_t)i * wj;
+            double factor = row_i[c] / row_g[c];
+            row_i[c] = factor;
+            simd_axpy(c_end - c - 1, -factor, row_g + c + 1, row_i + c + 1);
+        }
+    }
+
+    for (int i = 1; i < cb; i++) {
+        double *row_i = cur + (size_t)(j0 + c0 + i) * wj;
+        for (int p = 0; p < i; p++) {
+            simd_axpy(wj - c_end, -row_i[c0 + p], cur + (size_t)(j0 + c0 + p) * wj + c_end,
+                      row_i + c_end);
+        }
+    }
+    return 1;
+}
+
+/**
+ * Cập nhật phần còn lại của panel sau khối cột c0 .. c0+cb-1 cho các hàng
+ * row_begin .. row_end-1 (>= j0 + c0 + cb)
+ */
+static inline void ooc_update_panel_rows(double *cur, int wj, int j0, int c0, int cb,
+                                         int row_begin, int row_end) {
+    int c_end = c0 + cb;
+    const double *u = cur + (size_t)(j0 + c0) * wj + c_end;
+    for (int i = row_begin; i < row_end; i++) {
+        double *row_i = cur + (size_t)i * wj;
+        int p = 0;
+        for (; p + 3 < cb; p += 4) {
+            double l[4] = { -row_i[c0+p], -row_i[c0+p+1], -row_i[c0+p+2], -row_i[c0+p+3] };
+            simd_axpy4(wj - c_end, l, u + (size_t)p * wj, u + (size_t)(p+1) * wj,
+                       u + (size_t)(p+2) * wj, u + (size_t)(p+3) * wj, row_i + c_end);
+        }
+        for (; p < cb; p++) {
+            simd_axpy(wj - c_end, -row_i[c0 + p], u + (size_t)p * wj, row_i + c_end);
+        }
+    }
+}
+
+/**
+ * LU ngoài bộ nhớ tuần tự (luồng I/O vẫn đọc trước song song)
+ */
+static inline int ooc_factor(OocMatrix *m) {
+    OocRead *plan;
+    int len = ooc_factor_plan(m, &plan);
+    OocStream *st = ooc_stream_open(m, plan, len);
+    if (!st) {
+        free(plan);
+        return 0;
+    }
+
+    int ok = 1;
+    for (int j = 0; j < m->npanels && ok; j++) {
+        int wj = ooc_panel_width(m, j);
+        int j0 = j * m->w;
+        double *cur = ooc_stream_next(st);
+
+        for (int k = 0; k < j; k++) {
+            const double *Lk = ooc_stream_next(st);
+            ooc_apply_panel(m, cur, wj, Lk, k);
+            ooc_update_rows(m, cur, wj, Lk, k, (k + 1) * m->w, m->n);
+            ooc_stream_release(st, Lk);
+        }
+        for (int c0 = 0; c0 < wj && ok; c0 += OOC_SUB_BLOCK) {
+            int cb = (c0 + OOC_SUB_BLOCK < wj) ? OOC_SUB_BLOCK : wj - c0;
+            ok = ooc_factor_block(m, cur, wj, j0, c0, cb);
+            if (ok) {
+                ooc_update_panel_rows(cur, wj, j0, c0, cb, j0 + c0 + cb, m->n);
+            }
+        }
+        ok = ok && ooc_write_panel(m, j, cur);
+        ooc_stream_written(st, j + 1);
+        ooc_stream_release(st, cur);
+    }
+
+    ooc_stream_close(st);
+    free(plan);
+    return ok;
+}
+
+/**
+ * Giải sau khi phân tích, đọc mỗi panel hai lần qua luồng đọc trước: thế
+ * xuôi (đổi hàng theo panel, L_jj, rồi trừ L dưới panel) với panel tăng dần,
+ * thế ngược (U_jj, rồi trừ U phía trên panel) với panel giảm dần
+ */
+static inline int ooc_solve(OocMatrix *m) {
+    int n = m->n, np = m->npanels;
+    OocRead *plan = malloc(2 * (size_t)np * sizeof(OocRead));
+    for (int j = 0; j < np; j++) {
+        plan[j] = (OocRead){ j, j * m->w, n, 0 };
+        int jb = np - 1 - j;
+        plan[np + j] = (OocRead){ jb, 0, jb * m->w + ooc_panel_width(m, jb), 0 };
+    }
+    OocStream *st = ooc_stream_open(m, plan, 2 * np);
+    if (!st) {
+        free(plan);
+        return 0;
+    }
+
+    double *y = m->x;
+    memcpy(y, m->b, (size_t)n * sizeof(double));
+    for (int j = 0; j < np; j++) {
+        int wj = ooc_panel_width(m, j);
+        int j0 = j * m->w;
+        const double *L = ooc_stream_next(st);     // Hàng j0 .. n-1
+        double *yj = y + j0;
+
+        for (int r = j0; r < j0 + wj; r++) {
+            double tmp = y[r];
+            y[r] = y[m->ipiv[r]];
+            y[m->ipiv[r]] = tmp;
+        }
+        for (int i = 1; i < wj; i++) {
+            yj[i] -= simd_dot(i, L + (size_t)i * wj, yj);
+        }
+        for (int i = j0 + wj; i < n; i++) {
+            y[i] -= simd_dot(wj, L + (size_t)(i - j0) * wj, yj);
+        }
+        ooc_stream_release(st, L);
+    }
+
+    for (int j = np - 1; j >= 0; j--) {
+        int wj = ooc_panel_width(m, j);
+        int j0 = j * m->w;
+        const double *U = ooc_stream_next(st);     // Hàng 0 .. j0+wj-1
+        double *xj = y + j0;
+
+        for (int i = wj - 1; i >= 0; i--) {
+            const double *row = U + (size_t)(j0 + i) * wj;
+            xj[i] = (xj[i] - simd_dot(wj - i - 1, row + i + 1, xj + i + 1)) / row[i];
+        }
+        for (int i = 0; i < j0; i++) {
+            y[i] -= simd_dot(wj, U + (size_t)i * wj, xj);
+        }
+        ooc_stream_release(st, U);
+    }
+
+    ooc_stream_close(st);
+    free(plan);
+    return 1;
+}
+
+/**
+ * Tỷ lệ thời gian đọc được che bởi tính toán: 1 - chờ/đọc, kẹp trong [0, 1]
+ * (chờ gồm cả độ trễ đánh thức nên có thể lớn hơn thời gian đọc)
+ */
+static inline double ooc_overlap(const OocMatrix *m) {
+    if (m->read_time <= 0.0 || m->wait_time >= m->read_time) {
+        return (m->read_time <= 0.0) ? 1.0 : 0.0;
+    }
+    return 1.0 - m->wait_time / m->read_time;
+}
+
+/**
+ * Sai số ngược chuẩn hóa của nghiệm, sinh lại A theo công thức của hệ test
+ * (file đã bị ghi đè bởi L và U)
+ */
+static inline double ooc_backward_error(const OocMatrix *m) {
+    int n = m->n;
+    double norm_a = 0.0, norm_x = 0.0, norm_b = 0.0, norm_r = 0.0;
+    for (int i = 0; i < n; i++) {
+        double r = -m->b[i], row_sum = 0.0;
+        for (int j = 0; j < n; j++) {
+            double a = ooc_test_entry(i, j);
+            r += a * m->x[j];
+            row_sum += fabs(a);
+        }
+        if (row_sum > norm_a) norm_a = row_sum;
+        if (fabs(m->x[i]) > norm_x) norm_x = fabs(m->x[i]);
+        if (fabs(m->b[i]) > norm_b) norm_b = fabs(m->b[i]);
+        if (fabs(r) > norm_r) norm_r = fabs(r);
+    }
+    return norm_r / (norm_a * norm_x + norm_b);
+}
+
+#endif /* GAUSS_OOC_H */
@@ -0,0 +1,1054 @@
+/**
+ * GAUSSIAN ELIMINATION - ENGINE OPENMP (libgauss)
+ * Giải hệ phương trình tuyến tính với shared memory parallelism
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "gauss_core.h"
+
+
+/**
+ * Tạo hệ phương trình test với ma trận dominant diagonal (gauss_verify.h),
+ * mỗi luồng một dải hàng; b = A * x với x[i] = i + 1 tính ngay khi hàng còn
+ * trong cache
+ */
+void generate_test_system_openmp(LinearSystem *sys, int num_threads) {
+    int n = sys->n;
+    
+    double *true_x = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        true_x[i] = i + 1.0;
+    }
+    
+    omp_set_num_threads(num_threads);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        double *row = row_ptr(sys, i);
+        verify_test_row(n, i, 0, n, row);
+        sys->b[i] = simd_dot(n, row, true_x);
+    }
+    
+    free(true_x);
+}
+
+/**
+ * Sai số ngược ||b - A*x|| / (||A|| * ||x|| + ||b||) của nghiệm x trên hệ gốc
+ * (gauss_verify.h): các luồng lấy từng nhóm VERIFY_ROWS hàng, gộp chuẩn cuối
+ * vùng song song
+ */
+double verify_solution_openmp(const VerifySource *src, const double *x, int num_threads) {
+    int groups = (src->n + VERIFY_ROWS - 1) / VERIFY_ROWS;
+    VerifyNorms acc;
+    verify_norms_init(&acc);
+    
+    omp_set_num_threads(num_threads);
+    #pragma omp parallel
+    {
+        VerifyNorms part;
+        verify_norms_init(&part);
+        
+        #pragma omp for schedule(dynamic, 16) nowait
+        for (int g = 0; g < groups; g++) {
+            int i1 = (g + 1) * VERIFY_ROWS;
+            verify_rows(src, x, g * VERIFY_ROWS, (i1 < src->n) ? i1 : src->n, &part);
+        }
+        
+        #pragma omp critical
+        verify_norms_merge(&acc, &part);
+    }
+    return verify_backward_error(&acc, src->n, x, src->b);
+}
+
+/**
+ * Thế xuôi L*y = b rồi thế ngược U*x = y (b đã được hoán vị cùng các hàng)
+ * theo khối cột SOLVE_BLOCK trong một vùng song song duy nhất: một luồng
+ * giải khối đường chéo nhỏ, sau đó cả nhóm trừ đóng góp của khối nghiệm
+ * vừa có khỏi các hàng còn lại (mỗi hàng một dot độ dài SOLVE_BLOCK)
+ */
+static void substitution_openmp(LinearSystem *sys) {
+    int n = sys->n;
+    double *y = sys->b;
+    double *x = sys->x;
+    
+    #pragma omp parallel
+    {
+        for (int k0 = 0; k0 < n; k0 += SOLVE_BLOCK) {
+            int k1 = (k0 + SOLVE_BLOCK < n) ? k0 + SOLVE_BLOCK : n;
+            
+            #pragma omp single
+            for (int i = k0 + 1; i < k1; i++) {
+                y[i] -= simd_dot(i - k0, row_ptr(sys, i) + k0, y + k0);
+            }
+            
+            #pragma omp for schedule(static)
+            for (int i = k1; i < n; i++) {
+                y[i] -= simd_dot(k1 - k0, row_ptr(sys, i) + k0, y + k0);
+            }
+        }
+        
+        #pragma omp for schedule(static)
+        for (int i = 0; i < n; i++) {
+            x[i] = y[i];
+        }
+        
+        for (int k1 = n; k1 > 0; k1 -= SOLVE_BLOCK) {
+            int k0 = (k1 - SOLVE_BLOCK > 0) ? k1 - SOLVE_BLOCK : 0;
+            
+            #pragma omp single
+            for (int i = k1 - 1; i >= k0; i--) {
+                double *row_i = row_ptr(sys, i);
+                x[i] = (x[i] - simd_dot(k1 - i - 1, row_i + i + 1, x + i + 1)) / row_i[i];
+            }
+            
+            #pragma omp for schedule(static)
+            for (int i = 0; i < k0; i++) {
+                x[i] -= simd_dot(k1 - k0, row_ptr(sys, i) + k0, x + k0);
+            }
+        }
+    }
+}
+
+// Ứng viên pivot: giá trị |A[i][k]| và hàng tương ứng
+typedef struct {
+    double value;
+    int row;
+} PivotCandidate;
+
+/**
+ * Chọn ứng viên tốt hơn: |giá trị| lớn hơn, bằng nhau thì lấy hàng nhỏ hơn
+ * (thứ tự gộp của reduction không xác định, cần tie-break để kết quả ổn định)
+ */
+static inline PivotCandidate pivot_better(PivotCandidate a, PivotCandidate b) {
+    if (b.value > a.value || (b.value == a.value && b.row >= 0 && b.row < a.row)) {
+        return b;
+    }
+    return a;
+}
+
+// Reduction argmax (giá trị + chỉ số) cho tìm pivot song song
+#pragma omp declare reduction(pivot_max : PivotCandidate : \
+        omp_out = pivot_better(omp_out, omp_in)) \
+        initializer(omp_priv = (PivotCandidate){ -1.0, -1 })
+
+/**
+ * LU cổ điển (rank-1, giữ hệ số L) trong một vùng song song duy nhất.
+ * Mỗi cột: tìm pivot (reduction) -> single hoán đổi -> khử (nowait).
+ * Vòng khử bước k và vòng tìm pivot bước k+1 cùng duyệt [k+1, n) với
+ * schedule(static) nên mỗi luồng nhận đúng các hàng nó vừa cập nhật:
+ * không cần barrier sau khử, chỉ còn 2 barrier mỗi cột.
+ */
+static int lu_factor_unblocked_openmp(LinearSystem *sys) {
+    int n = sys->n;
+    int ok = 1;
+    PivotCandidate pivot = { -1.0, -1 };
+    
+    #pragma omp parallel
+    {
+        for (int k = 0; k < n - 1; k++) {
+            #pragma omp for schedule(static) reduction(pivot_max:pivot)
+            for (int i = k; i < n; i++) {
+                double val = fabs(row_ptr(sys, i)[k]);
+                if (val > pivot.value) {
+                    pivot.value = val;
+                    pivot.row = i;
+                }
+            }
+            
+            // Kiểm tra suy biến và hoán đổi hàng (O(1) qua perm); barrier
+            // ngầm cuối single công bố kết quả cho mọi luồng
+            #pragma omp single
+            {
+                if (pivot.value < 1e-12) {
+                    ok = 0;
+                } else if (pivot.row != k) {
+                    swap_rows(sys, k, pivot.row);
+                }
+                pivot.value = -1.0;
+                pivot.row = -1;
+            }
+            if (!ok) {
+                break;
+            }
+            
+            double *row_k = row_ptr(sys, k);
+            #pragma omp for schedule(static) nowait
+            for (int i = k + 1; i < n; i++) {
+                double *row_i = row_ptr(sys, i);
+                double factor = row_i[k] / row_k[k];
+                row_i[k] = factor;
+                
+                // Cập nhật hàng i
+                simd_axpy(n - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+            }
+        }
+    }
+    
+    return ok;
+}
+
+/**
+ * LU khối right-looking với OpenMP, toàn bộ trong một vùng song song.
+ * Panel phân tích song song theo cột như bản khử từng cột (hệ số L giữ lại);
+ * giải khối hàng U12 chia theo lát cột, cập nhật ma trận con chia theo dải
+ * hàng liên tục cho từng luồng
+ */
+static int lu_factor_blocked_openmp(LinearSystem *sys, int block_size) {
+    int n = sys->n;
+    int ok = 1;
+    PivotCandidate pivot = { -1.0, -1 };
+    
+    #pragma omp parallel
+    {
+        int tid = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        
+        for (int k0 = 0; k0 < n; k0 += block_size) {
+            int kb = (k0 + block_size < n) ? block_size : n - k0;
+            int k_end = k0 + kb;
+            
+            for (int k = k0; k < k_end; k++) {
+                #pragma omp for schedule(static) reduction(pivot_max:pivot)
+                for (int i = k; i < n; i++) {
+                    double val = fabs(row_ptr(sys, i)[k]);
+                    if (val > pivot.value) {
+                        pivot.value = val;
+                        pivot.row = i;
+                    }
+                }
+                
+                // Đổi cả hàng qua perm: tương đương áp dụng lô hoán vị cho mọi cột
+                #pragma omp single
+                {
+                    if (pivot.value < 1e-12) {
+                        ok = 0;
+                    } else if (pivot.row != k) {
+                        swap_rows(sys, k, pivot.row);
+                    }
+                    pivot.value = -1.0;
+                    pivot.row = -1;
+                }
+                if (!ok) {
+                    break;
+                }
+                
+                double *row_k = row_ptr(sys, k);
+                #pragma omp for schedule(static) nowait
+                for (int i = k + 1; i < n; i++) {
+                    double *row_i = row_ptr(sys, i);
+                    double factor = row_i[k] / row_k[k];
+                    row_i[k] = factor;
+                    
+                    simd_axpy(k_end - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+                }
+            }
+            if (!ok || k_end >= n) {
+                break;
+            }
+            
+            // U12 đọc hệ số L11 do các luồng khác vừa ghi
+            #pragma omp barrier
+            
+            #pragma omp for schedule(static)
+            for (int jc = k_end; jc < n; jc += UPDATE_COL_CHUNK) {
+                int jc_end = (jc + UPDATE_COL_CHUNK < n) ? jc + UPDATE_COL_CHUNK : n;
+                update_row_block(sys, k0, kb, jc, jc_end);
+            }
+            
+            // Mỗi luồng một dải hàng liên tục để tái sử dụng U12 trong cache
+            int rows = n - k_end;
+            int row_begin = k_end + (int)((long)rows * tid / nt);
+            int row_end = k_end + (int)((long)rows * (tid + 1) / nt);
+            update_trailing(sys, k0, kb, row_begin, row_end);
+            
+            // Panel kế tiếp tìm pivot trên các hàng của luồng khác
+            #pragma omp barrier
+        }
+    }
+    
+    return ok;
+}
+
+/**
+ * Đổi chỗ đoạn cột [col_begin, col_end) giữa hai hàng logic (đổi dữ liệu thật).
+ * Chế độ task không đổi perm: mọi task đang chạy trên các cột khác vẫn
+ * phải thấy đúng hàng của mình.
+ */
+static inline void swap_row_segment(LinearSystem *sys, int r1, int r2, int col_begin, int col_end) {
+    double *row1 = row_ptr(sys, r1);
+    double *row2 = row_ptr(sys, r2);
+    for (int j = col_begin; j < col_end; j++) {
+        double tmp = row1[j];
+        row1[j] = row2[j];
+        row2[j] = tmp;
+    }
+}
+
+/**
+ * Task panel: phân tích cột k0 .. k_end-1 (mọi hàng từ k0) với partial pivoting.
+ * Chỉ đổi hàng trong phạm vi panel; các cột khác áp dụng ipiv trong task riêng.
+ */
+static int factor_panel_tile(LinearSystem *sys, int *ipiv, int k0, int k_end) {
+    int n = sys->n;
+    
+    for (int k = k0; k < k_end; k++) {
+        int max_row = k;
+        double max_val = fabs(row_ptr(sys, k)[k]);
+        for (int i = k + 1; i < n; i++) {
+            double val = fabs(row_ptr(sys, i)[k]);
+            if (val > max_val) {
+                max_val = val;
+                max_row = i;
+            }
+        }
+        
+        if (max_val < 1e-12) {
+            return 0;
+        }
+        
+        ipiv[k] = max_row;
+        if (max_row != k) {
+            swap_row_segment(sys, k, max_row, k0, k_end);
+            swap_rhs(sys, k, max_row);
+        }
+        
+        double *row_k = row_ptr(sys, k);
+        for (int i = k + 1; i < n; i++) {
+            double *row_i = row_ptr(sys, i);
+            double factor = row_i[k] / row_k[k];
+            row_i[k] = factor;
+            
+            simd_axpy(k_end - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * LU dạng tile với DAG task OpenMP (depend trên sentinel của từng tile).
+ * Bước K gồm: panel cột tile K -> (đổi hàng + giải U_KJ) cho từng cột tile J
+ * -> GEMM cho từng tile (I, J). Panel K+1 chỉ chờ các tile của cột K+1 nên
+ * có thể chạy trong khi cập nhật phần còn lại của bước K chưa xong.
+ * lookahead: panel K chờ toàn bộ bước K-lookahead-1 (0 = đồng bộ từng bước);
+ * task trên đường găng (panel, cột trong tầm lookahead) được ưu tiên.
+ * Mốc done[K] chờ mọi task GEMM của bước K qua sentinel riêng của bước
+ * (vòng lookahead+2 bước), không qua tile nên không chặn task của bước sau.
+ */
+static int lu_factor_tiled_openmp(LinearSystem *sys, int tile_size, int lookahead) {
+    int n = sys->n;
+    tile_size = tile_size_clamp(n, tile_size);
+    int nt = (n + tile_size - 1) / tile_size;
+    int error = 0;
+    if (lookahead > nt) {
+        lookahead = nt;
+    }
+    int ring = lookahead + 2;
+    
+    int *ipiv = malloc(n * sizeof(int));
+    char *tiles = malloc((size_t)nt * nt);      // Sentinel phụ thuộc tile (I, J)
+    char *done = malloc(nt + 1);                // done[K]: xong toàn bộ bước K
+    char *marks = malloc((size_t)ring * nt * nt);  // Sentinel GEMM (I, J) của bước K % ring
+    if (!ipiv || !tiles || !done || !marks) {
+        free(ipiv);
+        free(tiles);
+        free(done);
+        free(marks);
+        return 0;
+    }
+    
+    #pragma omp parallel
+    {
+        #pragma omp single
+        {
+            for (int K = 0; K < nt; K++) {
+                int k0 = K * tile_size;
+                int k_end = (k0 + tile_size < n) ? k0 + tile_size : n;
+                
+                // done[nt] không có task nào ghi: phụ thuộc rỗng cho các bước đầu
+                int wait_step = (K > lookahead) ? K - lookahead - 1 : nt;
+                char *mark = marks + (size_t)(K % ring) * nt * nt;
+                
+                #pragma omp task depend(iterator(i = K:nt), inout: tiles[i * nt + K]) \
+                                 depend(in: done[wait_step]) priority(1)
+                {
+                    int failed;
+                    #pragma omp atomic read
+                    failed = error;
+                    
+                    if (!failed && !factor_panel_tile(sys, ipiv, k0, k_end)) {
+                        #pragma omp atomic write
+                        error = 1;
+                    }
+                }
+                
+                for (int J = K + 1; J < nt; J++) {
+                    int j0 = J * tile_size;
+                    int j_end = (j0 + tile_size < n) ? j0 + tile_size : n;
+                    int prio = (J <= K + lookahead) ? 1 : 0;
+                    
+                    // Đổi hàng theo ipiv của panel K rồi giải U_KJ = L_KK^-1 * A_KJ
+                    #pragma omp task depend(in: tiles[K * nt + K]) \
+                                     depend(iterator(i = K:nt), inout: tiles[i * nt + J]) \
+                                     priority(prio)
+                    {
+                        int failed;
+                        #pragma omp atomic read
+                        failed = error;
+                        
+                        if (!failed) {
+                            for (int k = k0; k < k_end; k++) {
+                                if (ipiv[k] != k) {
+                                    swap_row_segment(sys, k, ipiv[k], j0, j_end);
+                                }
+                            }
+                            update_row_block(sys, k0, k_end - k0, j0, j_end);
+                        }
+                    }
+                    
+                    for (int I = K + 1; I < nt; I++) {
+                        int i0 = I * tile_size;
+                        int i_end = (i0 + tile_size < n) ? i0 + tile_size : n;
+                        
+                        // A_IJ -= L_IK * U_KJ
+                        #pragma omp task depend(in: tiles[I * nt + K], tiles[K * nt + J]) \
+                                         depend(inout: tiles[I * nt + J]) \
+                                         depend(out: mark[I * nt + J]) priority(prio)
+                        {
+                            int failed;
+                            #pragma omp atomic read
+                            failed = error;
+                            
+                            if (!failed) {
+                                update_tile(sys, k0, k_end - k0, i0, i_end, j0, j_end);
+                            }
+                        }
+                    }
+                }
+                
+                // Mốc cho panel K+lookahead+1: mọi task GEMM của bước K đã xong.
+                // Chờ qua mark chứ không qua tiles: phụ thuộc in trên tile sẽ
+                // bắt mọi task của bước K+1 chờ mốc này (tức chờ cả bước K).
+                // Slot mark được dùng lại sau ring bước, khi panel ghi lại nó
+                // đã chờ done[K+1] nên không phải chờ thêm
+                if (K + lookahead + 1 < nt) {
+                    #pragma omp task depend(iterator(i = K+1:nt, j = K+1:nt), in: mark[i * nt + j]) \
+                                     depend(out: done[K])
+                    {
+                    }
+                }
+            }
+        }
+        
+        // Áp dụng các hoán vị của panel sau lên phần L bên trái (chạy sau toàn bộ DAG)
+        if (!error) {
+            #pragma omp for schedule(dynamic)
+            for (int J = 0; J < nt - 1; J++) {
+                int j0 = J * tile_size;
+                int j_end = j0 + tile_size;
+                for (int k = j_end; k < n; k++) {
+                    if (ipiv[k] != k) {
+                        swap_row_segment(sys, k, ipiv[k], j0, j_end);
+                    }
+                }
+            }
+        }
+    }
+    
+    free(ipiv);
+    free(tiles);
+    free(done);
+    free(marks);
+    return !error;
+}
+
+/**
+ * Phân tích PA = LU một lần (L đơn vị dưới đường chéo, U từ đường chéo trở
+ * lên, P trong origin) để sau đó giải nhiều vế phải bằng lu_solve.
+ * tile_size > 0: LU tile theo DAG task (lookahead bước);
+ * ngược lại block_size > 0: LU khối; block_size = 0: từng cột (rank-1)
+ */
+int lu_factor_openmp(LinearSystem *sys, int num_threads, int block_size,
+                     int tile_size, int lookahead) {
+    int n = sys->n;
+    int ok;
+    
+    // Thiết lập số luồng
+    omp_set_num_threads(num_threads);
+    
+    if (tile_size > 0) {
+        ok = lu_factor_tiled_openmp(sys, tile_size, lookahead);
+    } else if (block_size > 0) {
+        ok = lu_factor_blocked_openmp(sys, block_size);
+    } else {
+        ok = lu_factor_unblocked_openmp(sys);
+    }
+    
+    // Bản không khối dừng ở cột n-2: kiểm tra nốt phần tử chéo cuối
+    if (ok && fabs(row_ptr(sys, n-1)[n-1]) < 1e-12) {
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * Giải A*X = B cho m vế phải cùng lúc bằng LU đã phân tích. B, X là ma trận
+ * n x m row-major (bước ldb, ldx, không trùng nhau), B theo thứ tự hàng gốc.
+ * Thế xuôi/ngược theo khối: mỗi hệ số L/U được đọc một lần cho cả lát cột
+ * thay vì một lần cho mỗi vế phải. Song song theo lát cột khi giải khối đường
+ * chéo và theo cặp (khối hàng, lát cột) khi cập nhật dạng GEMM.
+ */
+void lu_solve_multi_openmp(LinearSystem *sys, const double *B, int ldb, double *X, int ldx, int m) {
+    int n = sys->n;
+    int nblk = (n + SOLVE_BLOCK - 1) / SOLVE_BLOCK;
+    int nchunk = (m + UPDATE_COL_CHUNK - 1) / UPDATE_COL_CHUNK;
+    
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(static)
+        for (int i = 0; i < n; i++) {
+            memcpy(X + (size_t)i * ldx, B + (size_t)sys->origin[i] * ldb, m * sizeof(double));
+        }
+        
+        // Thế xuôi L*Y = P*B
+        for (int K = 0; K < nblk; K++) {
+            int k0 = K * SOLVE_BLOCK;
+            int k1 = (k0 + SOLVE_BLOCK < n) ? k0 + SOLVE_BLOCK : n;
+            
+            #pragma omp for schedule(static)
+            for (int C = 0; C < nchunk; C++) {
+                int c0 = C * UPDATE_COL_CHUNK;
+                int c1 = (c0 + UPDATE_COL_CHUNK < m) ? c0 + UPDATE_COL_CHUNK : m;
+                trsm_lower_diag(sys, k0, k1, X, ldx, c0, c1);
+            }
+            
+            #pragma omp for collapse(2) schedule(dynamic)
+            for (int I = K + 1; I < nblk; I++) {
+                for (int C = 0; C < nchunk; C++) {
+                    int r0 = I * SOLVE_BLOCK;
+                    int r1 = (r0 + SOLVE_BLOCK < n) ? r0 + SOLVE_BLOCK : n;
+                    int c0 = C * UPDATE_COL_CHUNK;
+                    int c1 = (c0 + UPDATE_COL_CHUNK < m) ? c0 + UPDATE_COL_CHUNK : m;
+                    gemm_update_rhs(sys, k0, k1, r0, r1, X, ldx, c0, c1);
+                }
+            }
+        }
+        
+        // Thế ngược U*X = Y
+        for (int K = nblk - 1; K >= 0; K--) {
+            int k0 = K * SOLVE_BLOCK;
+            int k1 = (k0 + SOLVE_BLOCK < n) ? k0 + SOLVE_BLOCK : n;
+            
+            #pragma omp for schedule(static)
+            for (int C = 0; C < nchunk; C++) {
+                int c0 = C * UPDATE_COL_CHUNK;
+                int c1 = (c0 + UPDATE_COL_CHUNK < m) ? c0 + UPDATE_COL_CHUNK : m;
+                trsm_upper_diag(sys, k0, k1, X, ldx, c0, c1);
+            }
+            
+            #pragma omp for collapse(2) schedule(dynamic)
+            for (int I = 0; I < K; I++) {
+                for (int C = 0; C < nchunk; C++) {
+                    int r0 = I * SOLVE_BLOCK;
+                    int c0 = C * UPDATE_COL_CHUNK;
+                    int c1 = (c0 + UPDATE_COL_CHUNK < m) ? c0 + UPDATE_COL_CHUNK : m;
+                    gemm_update_rhs(sys, k0, k1, r0, r0 + SOLVE_BLOCK, X, ldx, c0, c1);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Thuật toán Gaussian Elimination với OpenMP
+ * tile_size > 0: LU tile theo DAG task (lookahead bước);
+ * ngược lại block_size > 0: LU khối; block_size = 0: khử từng cột (rank-1)
+ */
+int gaussian_elimination_openmp(LinearSystem *sys, int num_threads, int block_size,
+                                int tile_size, int lookahead) {
+    // Giai đoạn 1: Khử xuôi (Forward Elimination), đã kiểm tra pivot cuối
+    if (!lu_factor_openmp(sys, num_threads, block_size, tile_size, lookahead)) {
+        return 0;
+    }
+    
+    // Giai đoạn 2: Thế xuôi + thế ngược khối song song
+    substitution_openmp(sys);
+    return 1;
+}
+
+/**
+ * LU khối float song song: panel do một luồng phân tích, khối hàng U12 chia
+ * theo lát cột, ma trận con chia theo dải hàng (như lu_factor_blocked_openmp)
+ */
+static int lu_factor_mixed_openmp(MixedLU *m, int block_size) {
+    int n = m->n;
+    int ok = 1;
+    
+    #pragma omp parallel
+    {
+        int tid = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        
+        for (int k0 = 0; k0 < n; k0 += block_size) {
+            int kb = (k0 + block_size < n) ? block_size : n - k0;
+            int k_end = k0 + kb;
+            
+            #pragma omp single
+            ok = mixed_factor_panel(m, k0, kb);
+            
+            if (!ok || k_end >= n) {
+                break;
+            }
+            
+            #pragma omp for schedule(static)
+            for (int jc = k_end; jc < n; jc += MIXED_COL_CHUNK) {
+                int jc_end = (jc + MIXED_COL_CHUNK < n) ? jc + MIXED_COL_CHUNK : n;
+                mixed_update_row_block(m, k0, kb, jc, jc_end);
+            }
+            
+            int rows = n - k_end;
+            int row_begin = k_end + (int)((long)rows * tid / nt);
+            int row_end = k_end + (int)((long)rows * (tid + 1) / nt);
+            mixed_update_trailing(m, k0, kb, row_begin, row_end);
+            
+            #pragma omp barrier
+        }
+    }
+    
+    return ok;
+}
+
+/**
+ * LU float + tinh chỉnh lặp double (gauss_mixed.h). Cần hệ vừa tạo (A, b chưa
+ * bị khử, perm đơn vị); A, b không bị sửa nếu tinh chỉnh hội tụ. Nếu LU float
+ * thất bại hoặc tinh chỉnh chững lại thì giải lại bằng double (*fallback = 1).
+ */
+int gaussian_elimination_mixed_openmp(LinearSystem *sys, int num_threads, int block_size,
+                                      int tile_size, int lookahead,
+                                      int *iterations, int *fallback) {
+    int n = sys->n;
+    MixedLU *m = mixed_create(n);
+    *iterations = 0;
+    *fallback = 0;
+    omp_set_num_threads(num_threads);
+    
+    int ok = (m != NULL);
+    if (ok) {
+        #pragma omp parallel for schedule(static) reduction(&&:ok)
+        for (int i = 0; i < n; i++) {
+            ok = mixed_load(m, sys->A, sys->lda, i, i + 1) && ok;
+        }
+    }
+    
+    // LU float luôn theo khối (không có bản tile / khử từng cột)
+    ok = ok && lu_factor_mixed_openmp(m, (block_size > 0) ? block_size : DEFAULT_BLOCK_SIZE) &&
+         mixed_refine(m, sys->A, sys->lda, sys->b, sys->x, iterations);
+    mixed_free(m);
+    
+    if (!ok) {
+        *fallback = 1;
+        return gaussian_elimination_openmp(sys, num_threads, block_size, tile_size, lookahead);
+    }
+    return 1;
+}
+
+/**
+ * Giải phân hoạch hệ ba đường chéo (gauss_tridiag.h) trong một vùng song
+ * song: mỗi luồng khử một phần liên tục, một luồng giải hệ rút gọn 2P ẩn,
+ * rồi mỗi luồng tính nghiệm bên trong phần của mình. Hệ nhỏ dùng Thomas.
+ */
+int tridiag_solve_openmp(TridiagSystem *ts, int num_threads) {
+    int n = ts->n;
+    int parts = (num_threads < n / TRIDIAG_MIN_ROWS) ? num_threads : n / TRIDIAG_MIN_ROWS;
+    if (n < TRIDIAG_PARALLEL_MIN || parts < 2) {
+        return tridiag_thomas(ts);
+    }
+    
+    int *bounds = malloc((parts + 1) * sizeof(int));
+    for (int p = 0; p <= parts; p++) {
+        bounds[p] = (int)((long)n * p / parts);
+    }
+    int ok = 1;
+    omp_set_num_threads(num_threads);
+    
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(static)
+        for (int p = 0; p < parts; p++) {
+            if (!tridiag_partition_reduce(ts, bounds[p], bounds[p + 1])) {
+                #pragma omp atomic write
+                ok = 0;
+            }
+        }
+        
+        #pragma omp single
+        {
+            if (ok) {
+                ok = tridiag_reduced_solve(ts, bounds, parts);
+            }
+        }
+        
+        if (ok) {
+            #pragma omp for schedule(static)
+            for (int p = 0; p < parts; p++) {
+                tridiag_partition_finish(ts, bounds[p], bounds[p + 1]);
+            }
+        }
+    }
+    
+    free(bounds);
+    return ok;
+}
+
+/**
+ * Phân tích cây con gốc s: cây con nhỏ chạy tuần tự trong một task, cây con
+ * lớn tạo task cho từng con rồi phân tích s sau taskwait
+ */
+static void sparse_subtree_openmp(SparseLU *lu, int s, double **fronts, int *ok) {
+    if (lu->subtree_work[s] < SPARSE_TASK_MIN) {
+        for (int t = lu->first_desc[s]; t <= s; t++) {
+            if (!sparse_factor_super(lu, t, fronts)) {
+                #pragma omp atomic write
+                *ok = 0;
+                return;
+            }
+        }
+        return;
+    }
+    
+    for (int q = lu->child_p[s]; q < lu->child_p[s + 1]; q++) {
+        int c = lu->child[q];
+        #pragma omp task firstprivate(c)
+        sparse_subtree_openmp(lu, c, fronts, ok);
+    }
+    #pragma omp taskwait
+    
+    int children_ok;
+    #pragma omp atomic read
+    children_ok = *ok;
+    if (children_ok && !sparse_factor_super(lu, s, fronts)) {
+        #pragma omp atomic write
+        *ok = 0;
+    }
+}
+
+/**
+ * Phân tích số LU thưa (gauss_sparse.h) bằng OpenMP task theo cây khử: các
+ * cây con rời nhau chạy song song, supernode cha chờ các con
+ */
+int sparse_factor_openmp(SparseLU *lu, int num_threads) {
+    double **fronts = calloc(lu->nsuper, sizeof(double*));
+    int ok = 1;
+    omp_set_num_threads(num_threads);
+    
+    #pragma omp parallel
+    #pragma omp single
+    {
+        for (int s = 0; s < lu->nsuper; s++) {
+            if (lu->super_parent[s] == -1) {
+                #pragma omp task firstprivate(s)
+                sparse_subtree_openmp(lu, s, fronts, &ok);
+            }
+        }
+    }
+    
+    // Front còn lại khi có lỗi
+    for (int s = 0; s < lu->nsuper; s++) {
+        free(fronts[s]);
+    }
+    free(fronts);
+    return ok;
+}
+
+/**
+ * LU ngoài bộ nhớ (gauss_ooc.h) trong một vùng song song: một luồng nhận
+ * panel từ luồng đọc trước, đổi hàng và giải khối U; cập nhật A_j -= L_k * U_kj
+ * và cập nhật trong panel chia theo hàng cho các luồng
+ */
+int ooc_factor_openmp(OocMatrix *m, int num_threads) {
+    OocRead *plan;
+    int len = ooc_factor_plan(m, &plan);
+    OocStream *st = ooc_stream_open(m, plan, len);
+    if (!st) {
+        free(plan);
+        return 0;
+    }
+    
+    int n = m->n, w = m->w;
+    double *cur = NULL;
+    const double *Lk = NULL;
+    int ok = 1;
+    omp_set_num_threads(num_threads);
+    
+    #pragma omp parallel
+    {
+        for (int j = 0; j < m->npanels; j++) {
+            int wj = ooc_panel_width(m, j);
+            int j0 = j * w;
+            
+            #pragma omp single
+            cur = ooc_stream_next(st);
+            
+            for (int k = 0; k < j; k++) {
+                #pragma omp single
+                {
+                    Lk = ooc_stream_next(st);
+                    ooc_apply_panel(m, cur, wj, Lk, k);
+                }
+                
+                #pragma omp for schedule(static)
+                for (int i = (k + 1) * w; i < n; i++) {
+                    ooc_update_rows(m, cur, wj, Lk, k, i, i + 1);
+                }
+                
+                #pragma omp single
+                ooc_stream_release(st, Lk);
+            }
+            
+            for (int c0 = 0; c0 < wj; c0 += OOC_SUB_BLOCK) {
+                int cb = (c0 + OOC_SUB_BLOCK < wj) ? OOC_SUB_BLOCK : wj - c0;
+                
+                #pragma omp single
+                {
+                    if (!ooc_factor_block(m, cur, wj, j0, c0, cb)) {
+                        ok = 0;
+                    }
+                }
+                if (!ok) {
+                    break;
+                }
+                
+                #pragma omp for schedule(static)
+                for (int i = j0 + c0 + cb; i < n; i++) {
+                    ooc_update_panel_rows(cur, wj, j0, c0, cb, i, i + 1);
+                }
+            }
+            
+            #pragma omp single
+            {
+                if (ok && !ooc_write_panel(m, j, cur)) {
+                    ok = 0;
+                }
+                ooc_stream_written(st, j + 1);
+                ooc_stream_release(st, cur);
+            }
+            if (!ok) {
+                break;
+            }
+        }
+    }
+    
+    ooc_stream_close(st);
+    free(plan);
+    return ok;
+}
+
+/**
+ * Thomas khối cho hệ khối ba đường chéo (gauss_tridiag.h): mỗi khối đường
+ * chéo đã trừ phần bù Schur được chép vào một LinearSystem m x m rồi dùng lại
+ * LU dense của phiên bản này (lu_solve cho vế phải, lu_solve_multi_openmp cho khối
+ * C_i). D, C bị ghi đè; x nhận nghiệm.
+ */
+int block_tridiag_solve_openmp(BlockTridiag *bt, int block_size, int num_threads) {
+    int m = bt->m;
+    size_t mm = (size_t)m * m;
+    int threads = (m >= BTD_PARALLEL_MIN) ? num_threads : 1;
+    double *tmp = malloc(mm * sizeof(double));
+    if (!tmp) {
+        return 0;
+    }
+    int ok = 1;
+    
+    // Khử xuôi: D_i -= A_i * C'_{i-1}, y_i = D_i^-1 * (b_i - A_i * y_{i-1})
+    for (int i = 0; i < bt->nb && ok; i++) {
+        double *D = bt->D + i * mm;
+        double *C = bt->C + i * mm;
+        double *y = bt->x + (size_t)i * m;
+        memcpy(tmp, bt->b + (size_t)i * m, m * sizeof(double));
+        if (i > 0) {
+            btd_gemm_sub(m, bt->A + i * mm, C - mm, D);
+            btd_gemv_sub(m, bt->A + i * mm, y - m, tmp);
+        }
+        
+        LinearSystem *blk = create_system(m);
+        if (!blk) {
+            ok = 0;
+            break;
+        }
+        for (int r = 0; r < m; r++) {
+            memcpy(row_ptr(blk, r), D + (size_t)r * m, m * sizeof(double));
+        }
+        memset(blk->b, 0, m * sizeof(double));
+        ok = lu_factor_openmp(blk, threads, block_size, 0, DEFAULT_LOOKAHEAD);
+        if (ok) {
+            lu_solve(blk, tmp, y);
+            if (i + 1 < bt->nb) {
+                lu_solve_multi_openmp(blk, C, m, tmp, m, m);
+                memcpy(C, tmp, mm * sizeof(double));
+            }
+        }
+        free_system(blk);
+    }
+    
+    // Thế ngược: x_i = y_i - C'_i * x_{i+1}
+    for (int i = bt->nb - 2; i >= 0 && ok; i--) {
+        btd_gemv_sub(m, bt->C + i * mm, bt->x + (size_t)(i + 1) * m, bt->x + (size_t)i * m);
+    }
+    
+    free(tmp);
+    return ok;
+}
+
+/**
+ * LU băng khối song song: một luồng phân tích panel BAND_BLOCK cột, cả nhóm
+ * chia các cột của cửa sổ phía sau (mỗi cột độc lập), trong một vùng song
+ * song cho cả quá trình. Băng hẹp (kl * (kl + ku) < BAND_PARALLEL_MIN) quá ít
+ * việc mỗi panel so với barrier nên chạy band_factor tuần tự.
+ */
+int band_factor_openmp(BandSystem *bs, int num_threads) {
+    if ((long)bs->kl * (bs->kl + bs->ku) < BAND_PARALLEL_MIN) {
+        return band_factor(bs);
+    }
+    
+    int n = bs->n;
+    int ju = 0;
+    int ju_step[BAND_BLOCK];
+    int ok = 1;
+    omp_set_num_threads(num_threads);
+    
+    #pragma omp parallel
+    {
+        for (int j0 = 0; j0 < n; j0 += BAND_BLOCK) {
+            int jb = (j0 + BAND_BLOCK < n) ? BAND_BLOCK : n - j0;
+            
+            #pragma omp single
+            {
+                if (!band_factor_panel(bs, j0, jb, &ju, ju_step)) {
+                    ok = 0;
+                }
+            }
+            if (!ok) {
+                break;
+            }
+            
+            #pragma omp for schedule(static)
+            for (int c = j0 + jb; c <= ju; c++) {
+                band_update_block(bs, j0, jb, ju_step, c, c + 1);
+            }
+        }
+    }
+    
+    return ok;
+}
+
+/**
+ * Chia phần dữ liệu .mtx thành parts đoạn cắt ở đầu dòng, đếm dòng mỗi đoạn
+ * song song và lấy tổng tiền tố vào first (first[t] = số thứ tự phần tử đầu
+ * đoạn t) để mỗi đoạn parse độc lập. Trả về 0 nếu tổng khác nnz ở header.
+ */
+static int mtx_plan_openmp(const MtxFile *f, int parts, size_t *bounds, long *first) {
+    mtx_split(f, parts, bounds);
+    #pragma omp parallel for schedule(dynamic)
+    for (int t = 0; t < parts; t++) {
+        first[t + 1] = mtx_count(f, bounds[t], bounds[t + 1]);
+    }
+    first[0] = 0;
+    for (int t = 0; t < parts; t++) {
+        first[t + 1] += first[t];
+    }
+    return first[parts] == f->nnz;
+}
+
+/**
+ * Đọc phần dữ liệu .mtx song song: đếm dòng rồi parse các đoạn (mỗi luồng
+ * nhiều đoạn, lịch dynamic vì mật độ dòng không đều). sys != NULL: nạp vào
+ * hệ dense (xoá ma trận trước), ngược lại vào mảng toạ độ rows/cols/vals
+ * (mỗi đoạn ghi vào vị trí first[t] của nó). Trả về 0 nếu dữ liệu hỏng.
+ */
+int mtx_read_openmp(const MtxFile *f, LinearSystem *sys, int *rows, int *cols, double *vals,
+                    int num_threads) {
+    int parts = num_threads * 4;
+    size_t *bounds = malloc((parts + 1) * sizeof(size_t));
+    long *first = malloc((parts + 1) * sizeof(long));
+    omp_set_num_threads(num_threads);
+    
+    if (sys) {
+        int n = sys->n;
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; i++) {
+            memset(row_ptr(sys, i), 0, n * sizeof(double));
+        }
+    }
+    int ok = mtx_plan_openmp(f, parts, bounds, first);
+    if (ok) {
+        #pragma omp parallel for schedule(dynamic)
+        for (int t = 0; t < parts; t++) {
+            long count = sys ? mtx_parse_dense(f, bounds[t], bounds[t + 1], first[t], sys->A, sys->lda)
+                             : mtx_parse_coo(f, bounds[t], bounds[t + 1], first[t], rows, cols, vals);
+            if (count != first[t + 1] - first[t]) {
+                #pragma omp atomic write
+                ok = 0;
+            }
+        }
+    }
+    
+    free(bounds);
+    free(first);
+    return ok;
+}
+
+/**
+ * b = A * x với x[i] = i + 1 như hệ test (A nạp từ file .mtx), chia hàng cho
+ * các luồng
+ */
+void fill_test_rhs_openmp(LinearSystem *sys, int num_threads) {
+    int n = sys->n;
+    double *true_x = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        true_x[i] = i + 1.0;
+    }
+    
+    omp_set_num_threads(num_threads);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        sys->b[i] = simd_dot(n, row_ptr(sys, i), true_x);
+    }
+    free(true_x);
+}
+
+/**
+ * Giải lô hệ nhỏ (gauss_batch.h), mỗi luồng một nhóm BATCH_LANES hệ
+ */
+void batch_solve_openmp(BatchSystem *bs, int num_threads) {
+    // batch_kernel là riêng của đơn vị biên dịch này
+    batch_init();
+    omp_set_num_threads(num_threads);
+    #pragma omp parallel for schedule(static)
+    for (int g = 0; g < bs->groups; g++) {
+        batch_solve_groups(bs, g, g + 1);
+    }
+}
+
+/**
+ * Engine OpenMP của libgauss (gauss.h) trên hệ bọc bộ đệm của caller (wrap_system)
+ */
+int gauss_solve_openmp(int n, double *A, int lda, double *b, double *x, int *perm,
+                       int num_threads, int block_size) {
+    if (n <= 0 || lda < n || !A || !b || !x || num_threads <= 0) {
+        return GAUSS_EINVAL;
+    }
+    
+    LinearSystem sys;
+    if (!wrap_system(&sys, n, A, lda, b, x, perm)) {
+        return GAUSS_ENOMEM;
+    }
+    
+    int ok = gaussian_elimination_openmp(&sys, num_threads,
+                                         (block_size < 0) ? DEFAULT_BLOCK_SIZE : block_size,
+                                         0, DEFAULT_LOOKAHEAD);
+    
+    unwrap_system(&sys, perm);
+    return ok ? GAUSS_OK : GAUSS_ESINGULAR;
+}
@@ -0,0 +1,1481 @@
+/**
+ * GAUSSIAN ELIMINATION - ENGINE PTHREAD (libgauss)
+ * Giải hệ phương trình tuyến tính với manual thread management
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "gauss_core.h"
+
+
+// Số vòng spin trước khi nhường CPU khi chờ barrier (tránh đốt CPU khi oversubscribe)
+#define BARRIER_SPIN_LIMIT 4096
+
+// Barrier sense-reversing: tái sử dụng không cần reset, không cấp phát
+// (macOS không có pthread_barrier_t nên tự cài đặt bằng atomic)
+typedef struct {
+    atomic_int count;       // Số luồng chưa tới barrier trong lượt hiện tại
+    atomic_int sense;       // Đổi chiều mỗi lượt để đánh dấu barrier đã mở
+    int num_threads;
+} SpinBarrier;
+
+// Ứng viên pivot của một luồng: mỗi slot chiếm trọn một cache line để các
+// luồng ghi song song không tranh chấp cùng dòng cache (false sharing)
+typedef struct {
+    _Alignas(MATRIX_ALIGN) double value;    // max |A[i][k]| trên dải hàng của luồng
+    int row;                                // Hàng đạt max (-1: dải rỗng)
+} PivotSlot;
+
+// Hàng đợi supernode sẵn sàng của LU thưa (gauss_sparse.h)
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t ready_cond;  // Có đơn vị mới, hết việc hoặc có lỗi
+    int *ready;                 // Ngăn xếp các đơn vị đã đủ con
+    int ready_count;
+    int *pending;               // Số đơn vị con chưa xong của mỗi supernode
+    int units_left;             // Số đơn vị chưa phân tích xong
+    double **fronts;            // Phần bù Schur chờ cha gom
+} SparseQueue;
+
+// Đọc song song file Matrix Market (gauss_mtx.h): đoạn t là
+// [bounds[t], bounds[t+1]), phần tử đầu đoạn có số thứ tự first[t]
+typedef struct {
+    const MtxFile *file;
+    int parts;
+    size_t *bounds;
+    long *first;
+    int *rows;              // Mảng toạ độ (rows != NULL: parse COO cho --sparse)
+    int *cols;
+    double *vals;
+} MtxJob;
+
+// Sinh hệ test / kiểm tra nghiệm trên hệ gốc (gauss_verify.h), mỗi luồng
+// một dải hàng
+typedef struct {
+    const double *true_x;   // != NULL: sinh hệ test vào ctx->sys, b = A * true_x
+    const VerifySource *src;// != NULL: kiểm tra nghiệm x trên src
+    const double *x;
+    VerifyNorms *parts;     // Chuẩn của từng luồng, luồng chính gộp sau khi join
+} VerifyJob;
+
+// Trạng thái dùng chung của một lần giải: pool luồng chạy suốt các bước khử
+typedef struct {
+    LinearSystem *sys;
+    int num_threads;
+    int block_size;         // > 0: LU khối, 0: khử từng cột
+    int fused_pivot;        // 1: tìm pivot cột k+1 ngay trong lúc khử cột k
+    SpinBarrier barrier;
+    
+    // Pivot của bước hiện tại: mỗi luồng ghi slot riêng, luồng tới barrier
+    // cuối cùng gộp lại (không cần mutex)
+    PivotSlot *pivot_slots;
+    atomic_int error;       // Ma trận suy biến: mọi luồng cùng dừng (pool_fail)
+    atomic_int start;       // Luồng chính mở cổng khi pool đã tạo xong
+    
+    // Đo chi phí (chỉ khi bật --breakdown)
+    int measure;
+    double *barrier_wait;   // Tổng thời gian chờ barrier của từng luồng
+    
+    // Thế nhiều vế phải (X != NULL): X = A^-1 * B, ma trận n x m row-major
+    const double *rhs;
+    int ldb;
+    double *X;
+    int ldx;
+    int m;
+    
+    // Giải lô hệ nhỏ (batch != NULL): mỗi luồng một dải nhóm
+    BatchSystem *batch;
+    
+    // LU float cho --mixed (mixed != NULL)
+    MixedLU *mixed;
+    
+    // Thế xuôi/ngược b -> x ngay sau phân tích, trên cùng pool
+    int substitute;
+    
+    // LU băng (band != NULL): cột xa nhất U chạm tới, theo từng cột của panel
+    BandSystem *band;
+    int band_ju;
+    int band_ju_step[BAND_BLOCK];
+    
+    // Hệ ba đường chéo (tridiag != NULL): phần p là [bounds[p], bounds[p+1])
+    TridiagSystem *tridiag;
+    int *tridiag_bounds;
+    int tridiag_parts;
+    
+    // LU thưa (sparse != NULL): các luồng lấy việc từ hàng đợi cây khử
+    SparseLU *sparse;
+    SparseQueue *sparse_queue;
+    
+    // LU ngoài bộ nhớ (ooc != NULL): luồng 0 nhận panel từ luồng đọc trước
+    OocMatrix *ooc;
+    OocStream *ooc_stream;
+    double *ooc_cur;            // Panel đang phân tích
+    const double *ooc_panel;    // Panel L_k đang áp dụng
+    
+    // Đọc song song file Matrix Market (mtx != NULL)
+    MtxJob *mtx;
+    
+    // Sinh hệ test / kiểm tra nghiệm (verify != NULL)
+    VerifyJob *verify;
+} SolveContext;
+
+/**
+ * Báo lỗi cho cả pool (ma trận suy biến, hết bộ nhớ): cờ chỉ là tín hiệu dừng,
+ * dữ liệu vẫn đồng bộ qua barrier nên load/store relaxed là đủ
+ */
+static inline void pool_fail(SolveContext *ctx) {
+    atomic_store_explicit(&ctx->error, 1, memory_order_relaxed);
+}
+
+static inline int pool_failed(SolveContext *ctx) {
+    return atomic_load_explicit(&ctx->error, memory_order_relaxed);
+}
+
+// Tham số riêng của mỗi worker
+typedef struct {
+    SolveContext *ctx;
+    int tid;
+    int sense;              // Sense cục bộ cho barrier
+    long barriers;          // Số lần qua barrier
+} WorkerArg;
+
+/**
+ * Khởi tạo barrier cho num_threads luồng
+ */
+static void barrier_init(SpinBarrier *bar, int num_threads) {
+    atomic_init(&bar->count, num_threads);
+    atomic_init(&bar->sense, 0);
+    bar->num_threads = num_threads;
+}
+
+/**
+ * Chờ tại barrier. Luồng tới cuối cùng chạy action(ctx, arg) trước khi mở
+ * barrier: action thấy mọi ghi trước barrier, các luồng khác thấy kết quả của nó.
+ */
+static void barrier_wait(WorkerArg *w, void (*action)(SolveContext*, int), int arg) {
+    SolveContext *ctx = w->ctx;
+    SpinBarrier *bar = &ctx->barrier;
+    struct timespec t0, t1;
+    
+    if (ctx->measure) {
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+    }
+    
+    w->sense = !w->sense;
+    if (atomic_fetch_sub_explicit(&bar->count, 1, memory_order_acq_rel) == 1) {
+        if (action) {
+            action(ctx, arg);
+        }
+        atomic_store_explicit(&bar->count, bar->num_threads, memory_order_relaxed);
+        atomic_store_explicit(&bar->sense, w->sense, memory_order_release);
+    } else {
+        int spins = 0;
+        while (atomic_load_explicit(&bar->sense, memory_order_acquire) != w->sense) {
+            if (++spins >= BARRIER_SPIN_LIMIT) {
+                sched_yield();
+                spins = 0;
+            }
+        }
+    }
+    
+    if (ctx->measure) {
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ctx->barrier_wait[w->tid] += (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    }
+    w->barriers++;
+}
+
+/**
+ * Chia đoạn [first, last) thành nt phần liên tục, trả về phần của luồng tid
+ */
+static inline void split_range(int first, int last, int tid, int nt, int *begin, int *end) {
+    long total = last - first;
+    *begin = first + (int)(total * tid / nt);
+    *end = first + (int)(total * (tid + 1) / nt);
+}
+
+/**
+ * Tìm max |A[i][k]| trên dải hàng của luồng và ghi vào slot riêng.
+ * Dùng cho bước đầu tiên (hoặc mọi bước khi tắt chế độ gộp).
+ */
+static void search_pivot(WorkerArg *w, int k) {
+    SolveContext *ctx = w->ctx;
+    LinearSystem *sys = ctx->sys;
+    int begin, end;
+    split_range(k, sys->n, w->tid, ctx->num_threads, &begin, &end);
+    
+    int local_max_row = -1;
+    double local_max_val = -1.0;
+    for (int i = begin; i < end; i++) {
+        double val = fabs(row_ptr(sys, i)[k]);
+        if (val > local_max_val) {
+            local_max_val = val;
+            local_max_row = i;
+        }
+    }
+    
+    ctx->pivot_slots[w->tid].value = local_max_val;
+    ctx->pivot_slots[w->tid].row = local_max_row;
+}
+
+/**
+ * Action của barrier sau bước tìm pivot: gộp các slot, kiểm tra suy biến,
+ * hoán đổi hàng k (O(1) qua perm) và đặt lại slot cho bước sau.
+ * Dải hàng tăng dần theo tid nên so sánh chặt giữ hàng nhỏ hơn khi bằng nhau:
+ * kết quả không phụ thuộc số luồng.
+ */
+static void apply_pivot(SolveContext *ctx, int k) {
+    int pivot_row = -1;
+    double pivot_value = -1.0;
+    for (int t = 0; t < ctx->num_threads; t++) {
+        if (ctx->pivot_slots[t].value > pivot_value) {
+            pivot_value = ctx->pivot_slots[t].value;
+            pivot_row = ctx->pivot_slots[t].row;
+        }
+        ctx->pivot_slots[t].value = -1.0;
+        ctx->pivot_slots[t].row = -1;
+    }
+    
+    if (pivot_value < 1e-12) {
+        pool_fail(ctx);
+    } else if (pivot_row != k) {
+        swap_rows(ctx->sys, k, pivot_row);
+    }
+}
+
+/**
+ * Khử Gauss cổ điển trên dải hàng của luồng, giữ hệ số L dưới đường chéo.
+ * find_next: đồng thời tìm pivot cột k+1 trên chính các hàng vừa cập nhật
+ * (dải hàng của bước k trùng với dải tìm pivot của bước k+1), tránh một lượt
+ * đọc lại cột theo bước nhảy lda.
+ */
+static void eliminate_rows(WorkerArg *w, int k, int find_next) {
+    LinearSystem *sys = w->ctx->sys;
+    int n = sys->n;
+    int begin, end;
+    split_range(k + 1, n, w->tid, w->ctx->num_threads, &begin, &end);
+    
+    int local_max_row = -1;
+    double local_max_val = -1.0;
+    double *row_k = row_ptr(sys, k);
+    for (int i = begin; i < end; i++) {
+        double *row_i = row_ptr(sys, i);
+        double factor = row_i[k] / row_k[k];
+        row_i[k] = factor;
+        
+        // Cập nhật hàng i
+        simd_axpy(n - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+        
+        if (find_next && fabs(row_i[k+1]) > local_max_val) {
+            local_max_val = fabs(row_i[k+1]);
+            local_max_row = i;
+        }
+    }
+    
+    if (find_next) {
+        w->ctx->pivot_slots[w->tid].value = local_max_val;
+        w->ctx->pivot_slots[w->tid].row = local_max_row;
+    }
+}
+
+/**
+ * Cập nhật panel (cột k .. k_end-1) trên dải hàng của luồng, giữ hệ số L.
+ * find_next: tìm luôn pivot cột k+1 (phải nằm trong panel) như eliminate_rows.
+ */
+static void update_panel_rows(WorkerArg *w, int k, int k_end, int find_next) {
+    LinearSystem *sys = w->ctx->sys;
+    int begin, end;
+    split_range(k + 1, sys->n, w->tid, w->ctx->num_threads, &begin, &end);
+    
+    int local_max_row = -1;
+    double local_max_val = -1.0;
+    double *row_k = row_ptr(sys, k);
+    for (int i = begin; i < end; i++) {
+        double *row_i = row_ptr(sys, i);
+        double factor = row_i[k] / row_k[k];
+        row_i[k] = factor;
+        
+        simd_axpy(k_end - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+        
+        if (find_next && fabs(row_i[k+1]) > local_max_val) {
+            local_max_val = fabs(row_i[k+1]);
+            local_max_row = i;
+        }
+    }
+    
+    if (find_next) {
+        w->ctx->pivot_slots[w->tid].value = local_max_val;
+        w->ctx->pivot_slots[w->tid].row = local_max_row;
+    }
+}
+
+/**
+ * Worker khử từng cột: tìm pivot -> barrier (hoán đổi) -> khử -> barrier.
+ * Chế độ gộp: khử cột k đã tìm sẵn pivot cột k+1 nên barrier sau khử chính là
+ * barrier hoán đổi của bước sau (1 barrier mỗi cột thay vì 2).
+ */
+static void worker_unblocked(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    int n = ctx->sys->n;
+    
+    if (n > 1 && ctx->fused_pivot) {
+        search_pivot(w, 0);
+        barrier_wait(w, apply_pivot, 0);
+    }
+    
+    for (int k = 0; k < n - 1; k++) {
+        if (!ctx->fused_pivot) {
+            search_pivot(w, k);
+            barrier_wait(w, apply_pivot, k);
+        }
+        if (pool_failed(ctx)) {
+            return;
+        }
+        
+        if (ctx->fused_pivot && k + 1 < n - 1) {
+            eliminate_rows(w, k, 1);
+            barrier_wait(w, apply_pivot, k + 1);
+        } else {
+            eliminate_rows(w, k, 0);
+            barrier_wait(w, NULL, 0);
+        }
+    }
+}
+
+/**
+ * Worker LU khối: panel phân tích song song theo hàng, U12 chia theo cột,
+ * A22 chia theo dải hàng; các pha nối với nhau bằng barrier
+ */
+static void worker_blocked(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    LinearSystem *sys = ctx->sys;
+    int n = sys->n;
+    int nt = ctx->num_threads;
+    
+    for (int k0 = 0; k0 < n; k0 += ctx->block_size) {
+        int kb = (k0 + ctx->block_size < n) ? ctx->block_size : n - k0;
+        int k_end = k0 + kb;
+        
+        // Panel: mỗi cột một lần tìm pivot và một lần cập nhật; chế độ gộp chỉ
+        // quét riêng cột đầu panel, các cột sau có pivot từ lượt cập nhật trước
+        for (int k = k0; k < k_end; k++) {
+            if (k == k0 || !ctx->fused_pivot) {
+                search_pivot(w, k);
+                barrier_wait(w, apply_pivot, k);
+            }
+            if (pool_failed(ctx)) {
+                return;
+            }
+            
+            if (ctx->fused_pivot && k + 1 < k_end) {
+                update_panel_rows(w, k, k_end, 1);
+                barrier_wait(w, apply_pivot, k + 1);
+            } else {
+                update_panel_rows(w, k, k_end, 0);
+                barrier_wait(w, NULL, 0);
+            }
+        }
+        
+        if (k_end >= n) {
+            break;
+        }
+        
+        int begin, end;
+        split_range(k_end, n, w->tid, nt, &begin, &end);
+        update_row_block(sys, k0, kb, begin, end);
+        barrier_wait(w, NULL, 0);
+        
+        update_trailing(sys, k0, kb, begin, end);
+        barrier_wait(w, NULL, 0);
+    }
+}
+
+/**
+ * Worker thế nhiều vế phải: X (n x m) chia thành lát UPDATE_COL_CHUNK cột và
+ * khối SOLVE_BLOCK hàng. Mỗi khối: giải khối đường chéo (chia theo lát cột)
+ * -> barrier -> cập nhật các khối còn lại (chia theo cặp khối hàng x lát cột)
+ * -> barrier.
+ */
+static void worker_solve(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    LinearSystem *sys = ctx->sys;
+    int n = sys->n;
+    int nt = ctx->num_threads;
+    int m = ctx->m, ldx = ctx->ldx;
+    double *X = ctx->X;
+    int nblk = (n + SOLVE_BLOCK - 1) / SOLVE_BLOCK;
+    int nchunk = (m + UPDATE_COL_CHUNK - 1) / UPDATE_COL_CHUNK;
+    
+    // X = P * B (hàng vật lý không di chuyển nên perm[i] là hàng gốc)
+    int begin, end;
+    split_range(0, n, w->tid, nt, &begin, &end);
+    for (int i = begin; i < end; i++) {
+        memcpy(X + (size_t)i * ldx, ctx->rhs + (size_t)sys->perm[i] * ctx->ldb, m * sizeof(double));
+    }
+    barrier_wait(w, NULL, 0);
+    
+    // Thế xuôi L*Y = P*B
+    for (int K = 0; K < nblk; K++) {
+        int k0 = K * SOLVE_BLOCK;
+        int k1 = (k0 + SOLVE_BLOCK < n) ? k0 + SOLVE_BLOCK : n;
+        for (int C = w->tid; C < nchunk; C += nt) {
+            int c0 = C * UPDATE_COL_CHUNK;
+            int c1 = (c0 + UPDATE_COL_CHUNK < m) ? c0 + UPDATE_COL_CHUNK : m;
+            trsm_lower_diag(sys, k0, k1, X, ldx, c0, c1);
+        }
+        barrier_wait(w, NULL, 0);
+        
+        int tiles = (nblk - K - 1) * nchunk;
+        for (int t = w->tid; t < tiles; t += nt) {
+            int r0 = (K + 1 + t / nchunk) * SOLVE_BLOCK;
+            int r1 = (r0 + SOLVE_BLOCK < n) ? r0 + SOLVE_BLOCK : n;
+            int c0 = (t % nchunk) * UPDATE_COL_CHUNK;
+            int c1 = (c0 + UPDATE_COL_CHUNK < m) ? c0 + UPDATE_COL_CHUNK : m;
+            gemm_update_rhs(sys, k0, k1, r0, r1, X, ldx, c0, c1);
+        }
+        barrier_wait(w, NULL, 0);
+    }
+    
+    // Thế ngược U*X = Y
+    for (int K = nblk - 1; K >= 0; K--) {
+        int k0 = K * SOLVE_BLOCK;
+        int k1 = (k0 + SOLVE_BLOCK < n) ? k0 + SOLVE_BLOCK : n;
+        for (int C = w->tid; C < nchunk; C += nt) {
+            int c0 = C * UPDATE_COL_CHUNK;
+            int c1 = (c0 + UPDATE_COL_CHUNK < m) ? c0 + UPDATE_COL_CHUNK : m;
+            trsm_upper_diag(sys, k0, k1, X, ldx, c0, c1);
+        }
+        barrier_wait(w, NULL, 0);
+        
+        int tiles = K * nchunk;
+        for (int t = w->tid; t < tiles; t += nt) {
+            int r0 = (t / nchunk) * SOLVE_BLOCK;
+            int r1 = r0 + SOLVE_BLOCK;
+            int c0 = (t % nchunk) * UPDATE_COL_CHUNK;
+            int c1 = (c0 + UPDATE_COL_CHUNK < m) ? c0 + UPDATE_COL_CHUNK : m;
+            gemm_update_rhs(sys, k0, k1, r0, r1, X, ldx, c0, c1);
+        }
+        barrier_wait(w, NULL, 0);
+    }
+}
+
+/**
+ * Worker LU float (--mixed): chép A sang float theo dải hàng, sau đó mỗi
+ * panel do luồng 0 phân tích, khối hàng U12 và ma trận con chia như worker_blocked
+ */
+static void worker_mixed(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    MixedLU *m = ctx->mixed;
+    int n = m->n;
+    int nt = ctx->num_threads;
+    int begin, end;
+    
+    split_range(0, n, w->tid, nt, &begin, &end);
+    if (!mixed_load(m, ctx->sys->A, ctx->sys->lda, begin, end)) {
+        pool_fail(ctx);
+    }
+    barrier_wait(w, NULL, 0);
+    
+    for (int k0 = 0; k0 < n && !pool_failed(ctx); k0 += ctx->block_size) {
+        int kb = (k0 + ctx->block_size < n) ? ctx->block_size : n - k0;
+        int k_end = k0 + kb;
+        
+        if (w->tid == 0 && !mixed_factor_panel(m, k0, kb)) {
+            pool_fail(ctx);
+        }
+        barrier_wait(w, NULL, 0);
+        if (pool_failed(ctx) || k_end >= n) {
+            return;
+        }
+        
+        split_range(k_end, n, w->tid, nt, &begin, &end);
+        mixed_update_row_block(m, k0, kb, begin, end);
+        barrier_wait(w, NULL, 0);
+        
+        mixed_update_trailing(m, k0, kb, begin, end);
+        barrier_wait(w, NULL, 0);
+    }
+}
+
+/**
+ * Thế xuôi rồi thế ngược trên cùng pool ngay sau khi phân tích (b -> x).
+ * Theo khối cột SOLVE_BLOCK: luồng 0 giải khối đường chéo (nhỏ, tuần tự),
+ * sau đó mọi luồng trừ phần đóng góp của khối nghiệm vừa có khỏi các hàng
+ * còn lại, mỗi luồng một dải hàng.
+ */
+static void worker_substitution(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    LinearSystem *sys = ctx->sys;
+    int n = sys->n;
+    int nt = ctx->num_threads;
+    double *y = sys->b;
+    double *x = sys->x;
+    int begin, end;
+    
+    // Thế xuôi L*y = b (L đơn vị)
+    for (int k0 = 0; k0 < n; k0 += SOLVE_BLOCK) {
+        int k1 = (k0 + SOLVE_BLOCK < n) ? k0 + SOLVE_BLOCK : n;
+        if (w->tid == 0) {
+            for (int i = k0 + 1; i < k1; i++) {
+                y[i] -= simd_dot(i - k0, row_ptr(sys, i) + k0, y + k0);
+            }
+        }
+        barrier_wait(w, NULL, 0);
+        
+        split_range(k1, n, w->tid, nt, &begin, &end);
+        for (int i = begin; i < end; i++) {
+            y[i] -= simd_dot(k1 - k0, row_ptr(sys, i) + k0, y + k0);
+        }
+        barrier_wait(w, NULL, 0);
+    }
+    
+    // Thế ngược U*x = y
+    split_range(0, n, w->tid, nt, &begin, &end);
+    memcpy(x + begin, y + begin, (end - begin) * sizeof(double));
+    barrier_wait(w, NULL, 0);
+    
+    for (int k1 = n; k1 > 0; k1 -= SOLVE_BLOCK) {
+        int k0 = (k1 - SOLVE_BLOCK > 0) ? k1 - SOLVE_BLOCK : 0;
+        if (w->tid == 0) {
+            for (int i = k1 - 1; i >= k0; i--) {
+                double *row_i = row_ptr(sys, i);
+                x[i] = (x[i] - simd_dot(k1 - i - 1, row_i + i + 1, x + i + 1)) / row_i[i];
+            }
+        }
+        barrier_wait(w, NULL, 0);
+        
+        split_range(0, k0, w->tid, nt, &begin, &end);
+        for (int i = begin; i < end; i++) {
+            x[i] -= simd_dot(k1 - k0, row_ptr(sys, i) + k0, x + k0);
+        }
+        barrier_wait(w, NULL, 0);
+    }
+}
+
+/**
+ * Worker bộ giải lô: các nhóm độc lập nên mỗi luồng giải một dải nhóm liên
+ * tiếp, không cần barrier
+ */
+static void worker_batch(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    int begin, end;
+    split_range(0, ctx->batch->groups, w->tid, ctx->num_threads, &begin, &end);
+    batch_solve_groups(ctx->batch, begin, end);
+}
+
+/**
+ * Worker LU băng khối: luồng 0 phân tích panel BAND_BLOCK cột, sau đó mỗi
+ * luồng áp dụng panel lên một dải cột của cửa sổ phía sau (2 barrier mỗi panel)
+ */
+static void worker_band(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    BandSystem *bs = ctx->band;
+    int n = bs->n;
+    int begin, end;
+    
+    for (int j0 = 0; j0 < n; j0 += BAND_BLOCK) {
+        int jb = (j0 + BAND_BLOCK < n) ? BAND_BLOCK : n - j0;
+        
+        if (w->tid == 0 && !band_factor_panel(bs, j0, jb, &ctx->band_ju, ctx->band_ju_step)) {
+            pool_fail(ctx);
+        }
+        barrier_wait(w, NULL, 0);
+        if (pool_failed(ctx)) {
+            return;
+        }
+        
+        split_range(j0 + jb, ctx->band_ju + 1, w->tid, ctx->num_threads, &begin, &end);
+        band_update_block(bs, j0, jb, ctx->band_ju_step, begin, end);
+        barrier_wait(w, NULL, 0);
+    }
+}
+
+/**
+ * Worker giải phân hoạch hệ ba đường chéo: mỗi luồng khử các phần của mình
+ * (một phần nếu pool tạo đủ luồng), luồng 0 giải hệ rút gọn, rồi mỗi luồng
+ * tính nghiệm bên trong các phần đó
+ */
+static void worker_tridiag(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    TridiagSystem *ts = ctx->tridiag;
+    int *bounds = ctx->tridiag_bounds;
+    int parts = ctx->tridiag_parts;
+    
+    for (int p = w->tid; p < parts; p += ctx->num_threads) {
+        if (!tridiag_partition_reduce(ts, bounds[p], bounds[p + 1])) {
+            pool_fail(ctx);
+        }
+    }
+    barrier_wait(w, NULL, 0);
+    
+    if (w->tid == 0 && !pool_failed(ctx) && !tridiag_reduced_solve(ts, bounds, parts)) {
+        pool_fail(ctx);
+    }
+    barrier_wait(w, NULL, 0);
+    if (pool_failed(ctx)) {
+        return;
+    }
+    
+    for (int p = w->tid; p < parts; p += ctx->num_threads) {
+        tridiag_partition_finish(ts, bounds[p], bounds[p + 1]);
+    }
+}
+
+/**
+ * Worker LU thưa: lấy đơn vị sẵn sàng từ hàng đợi (cây con nhỏ: cả cây con;
+ * supernode lớn: chỉ supernode đó), phân tích, rồi giảm bộ đếm con của cha;
+ * cha có đủ con thì vào hàng đợi
+ */
+static void worker_sparse(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    SparseLU *lu = ctx->sparse;
+    SparseQueue *q = ctx->sparse_queue;
+    
+    pthread_mutex_lock(&q->lock);
+    for (;;) {
+        while (q->ready_count == 0 && q->units_left > 0 && !pool_failed(ctx)) {
+            pthread_cond_wait(&q->ready_cond, &q->lock);
+        }
+        if (q->units_left == 0 || pool_failed(ctx)) {
+            break;
+        }
+        int s = q->ready[--q->ready_count];
+        pthread_mutex_unlock(&q->lock);
+        
+        int ok = 1;
+        int first = (lu->subtree_work[s] < SPARSE_TASK_MIN) ? lu->first_desc[s] : s;
+        for (int t = first; t <= s && ok; t++) {
+            ok = sparse_factor_super(lu, t, q->fronts);
+        }
+        
+        pthread_mutex_lock(&q->lock);
+        q->units_left--;
+        int p = lu->super_parent[s];
+        if (!ok) {
+            pool_fail(ctx);
+        } else if (p != -1 && --q->pending[p] == 0) {
+            q->ready[q->ready_count++] = p;
+        }
+        pthread_cond_broadcast(&q->ready_cond);
+    }
+    pthread_mutex_unlock(&q->lock);
+}
+
+/**
+ * Worker LU ngoài bộ nhớ: luồng 0 nhận panel từ luồng đọc trước, đổi hàng,
+ * giải khối U và phân tích từng khối cột; các luồng chia hàng cho cập nhật
+ * A_j -= L_k * U_kj và cập nhật trong panel (2 barrier mỗi bước)
+ */
+static void worker_ooc(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    OocMatrix *m = ctx->ooc;
+    OocStream *st = ctx->ooc_stream;
+    int n = m->n;
+    int begin, end;
+    
+    for (int j = 0; j < m->npanels; j++) {
+        int wj = ooc_panel_width(m, j);
+        int j0 = j * m->w;
+        
+        if (w->tid == 0) {
+            ctx->ooc_cur = ooc_stream_next(st);
+        }
+        for (int k = 0; k < j; k++) {
+            if (w->tid == 0) {
+                ctx->ooc_panel = ooc_stream_next(st);
+                ooc_apply_panel(m, ctx->ooc_cur, wj, ctx->ooc_panel, k);
+            }
+            barrier_wait(w, NULL, 0);
+            
+            split_range((k + 1) * m->w, n, w->tid, ctx->num_threads, &begin, &end);
+            ooc_update_rows(m, ctx->ooc_cur, wj, ctx->ooc_panel, k, begin, end);
+            barrier_wait(w, NULL, 0);
+            
+            if (w->tid == 0) {
+                ooc_stream_release(st, ctx->ooc_panel);
+            }
+        }
+        
+        for (int c0 = 0; c0 < wj; c0 += OOC_SUB_BLOCK) {
+            int cb = (c0 + OOC_SUB_BLOCK < wj) ? OOC_SUB_BLOCK : wj - c0;
+            
+            if (w->tid == 0 && !ooc_factor_block(m, ctx->ooc_cur, wj, j0, c0, cb)) {
+                pool_fail(ctx);
+            }
+            barrier_wait(w, NULL, 0);
+            if (pool_failed(ctx)) {
+                return;
+            }
+            
+            split_range(j0 + c0 + cb, n, w->tid, ctx->num_threads, &begin, &end);
+            ooc_update_panel_rows(ctx->ooc_cur, wj, j0, c0, cb, begin, end);
+            barrier_wait(w, NULL, 0);
+        }
+        
+        if (w->tid == 0) {
+            if (!ooc_write_panel(m, j, ctx->ooc_cur)) {
+                pool_fail(ctx);
+            }
+            ooc_stream_written(st, j + 1);
+            ooc_stream_release(st, ctx->ooc_cur);
+        }
+        barrier_wait(w, NULL, 0);
+        if (pool_failed(ctx)) {
+            return;
+        }
+    }
+}
+
+/**
+ * Worker đọc Matrix Market: (dense) xoá dải hàng, đếm dòng các đoạn của
+ * mình, luồng 0 lấy tổng tiền tố và kiểm tra với nnz, rồi mỗi luồng parse
+ * các đoạn của mình vào vị trí đã biết
+ */
+static void worker_mtx(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    MtxJob *job = ctx->mtx;
+    const MtxFile *f = job->file;
+    LinearSystem *sys = ctx->sys;
+    int nt = ctx->num_threads;
+    int begin, end;
+    
+    if (sys) {
+        split_range(0, sys->n, w->tid, nt, &begin, &end);
+        for (int i = begin; i < end; i++) {
+            memset(row_ptr(sys, i), 0, sys->n * sizeof(double));
+        }
+    }
+    for (int t = w->tid; t < job->parts; t += nt) {
+        job->first[t + 1] = mtx_count(f, job->bounds[t], job->bounds[t + 1]);
+    }
+    barrier_wait(w, NULL, 0);
+    
+    if (w->tid == 0) {
+        job->first[0] = 0;
+        for (int t = 0; t < job->parts; t++) {
+            job->first[t + 1] += job->first[t];
+        }
+        if (job->first[job->parts] != f->nnz) {
+            pool_fail(ctx);
+        }
+    }
+    barrier_wait(w, NULL, 0);
+    if (pool_failed(ctx)) {
+        return;
+    }
+    
+    for (int t = w->tid; t < job->parts; t += nt) {
+        long count = sys ? mtx_parse_dense(f, job->bounds[t], job->bounds[t + 1], job->first[t],
+                                           sys->A, sys->lda)
+                         : mtx_parse_coo(f, job->bounds[t], job->bounds[t + 1], job->first[t],
+                                         job->rows, job->cols, job->vals);
+        if (count != job->first[t + 1] - job->first[t]) {
+            pool_fail(ctx);
+        }
+    }
+}
+
+/**
+ * Worker sinh hệ test hoặc kiểm tra nghiệm: dải hàng của luồng, không barrier
+ */
+static void worker_verify(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    VerifyJob *job = ctx->verify;
+    int n = job->src ? job->src->n : ctx->sys->n;
+    int begin, end;
+    split_range(0, n, w->tid, ctx->num_threads, &begin, &end);
+    
+    if (job->true_x) {
+        LinearSystem *sys = ctx->sys;
+        for (int i = begin; i < end; i++) {
+            double *row = row_ptr(sys, i);
+            verify_test_row(n, i, 0, n, row);
+            sys->b[i] = simd_dot(n, row, job->true_x);
+        }
+    } else {
+        verify_norms_init(&job->parts[w->tid]);
+        verify_rows(job->src, job->x, begin, end, &job->parts[w->tid]);
+    }
+}
+
+/**
+ * Công việc của một worker theo loại lần chạy của pool
+ */
+static void worker_run(WorkerArg *w) {
+    SolveContext *ctx = w->ctx;
+    if (ctx->mixed) {
+        worker_mixed(w);
+    } else if (ctx->band) {
+        worker_band(w);
+    } else if (ctx->tridiag) {
+        worker_tridiag(w);
+    } else if (ctx->sparse) {
+        worker_sparse(w);
+    } else if (ctx->ooc) {
+        worker_ooc(w);
+    } else if (ctx->mtx) {
+        worker_mtx(w);
+    } else if (ctx->verify) {
+        worker_verify(w);
+    } else if (ctx->batch) {
+        worker_batch(w);
+    } else if (ctx->X) {
+        worker_solve(w);
+    } else {
+        if (ctx->block_size > 0) {
+            worker_blocked(w);
+        } else {
+            worker_unblocked(w);
+        }
+        
+        // Mọi luồng thấy cùng trạng thái sau barrier cuối của lượt phân tích
+        LinearSystem *sys = ctx->sys;
+        if (ctx->substitute && !pool_failed(ctx) &&
+            fabs(row_ptr(sys, sys->n - 1)[sys->n - 1]) >= 1e-12) {
+            worker_substitution(w);
+        }
+    }
+}
+
+/**
+ * Hàm chạy của mỗi luồng trong pool: chờ lệnh bắt đầu rồi chạy hết lần giải
+ */
+static void* worker_main(void *arg) {
+    WorkerArg *w = (WorkerArg*)arg;
+    SolveContext *ctx = w->ctx;
+    
+    // Chờ luồng chính tạo xong pool (số luồng thực tế có thể ít hơn yêu cầu)
+    int spins = 0;
+    while (atomic_load_explicit(&ctx->start, memory_order_acquire) == 0) {
+        if (++spins >= BARRIER_SPIN_LIMIT) {
+            sched_yield();
+            spins = 0;
+        }
+    }
+    
+    worker_run(w);
+    
+    return NULL;
+}
+
+/**
+ * Chạy ctx trên pool luồng tạo một lần cho cả lần chạy.
+ * Luồng chính là worker 0; không có cấp phát hay tạo luồng trong vòng lặp.
+ */
+static int run_pool(SolveContext *ctx, PoolStats *stats) {
+    int num_threads = ctx->num_threads;
+    atomic_init(&ctx->error, 0);
+    ctx->measure = (stats != NULL);
+    ctx->barrier_wait = calloc(num_threads, sizeof(double));
+    atomic_init(&ctx->start, 0);
+    
+    if (posix_memalign((void**)&ctx->pivot_slots, MATRIX_ALIGN,
+                       num_threads * sizeof(PivotSlot)) != 0) {
+        free(ctx->barrier_wait);
+        return 0;
+    }
+    for (int t = 0; t < num_threads; t++) {
+        ctx->pivot_slots[t].value = -1.0;
+        ctx->pivot_slots[t].row = -1;
+    }
+    
+    pthread_t *threads = malloc(num_threads * sizeof(pthread_t));
+    WorkerArg *args = malloc(num_threads * sizeof(WorkerArg));
+    
+    struct timespec t0, t1, t2;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    
+    // Tạo pool: nếu hệ thống không cho tạo đủ luồng thì chạy với số đã có
+    // (số thực tế trả lại trong ctx->num_threads và stats->num_threads)
+    int created = 1;
+    for (int i = 1; i < num_threads; i++) {
+        args[i].ctx = ctx;
+        args[i].tid = i;
+        args[i].sense = 0;
+        args[i].barriers = 0;
+        if (pthread_create(&threads[i], NULL, worker_main, &args[i]) != 0) {
+            break;
+        }
+        created++;
+    }
+    ctx->num_threads = created;
+    barrier_init(&ctx->barrier, created);
+    atomic_store_explicit(&ctx->start, 1, memory_order_release);
+    
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    
+    args[0].ctx = ctx;
+    args[0].tid = 0;
+    args[0].sense = 0;
+    args[0].barriers = 0;
+    worker_run(&args[0]);
+    
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    
+    for (int i = 1; i < created; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    
+    if (stats) {
+        struct timespec t3;
+        clock_gettime(CLOCK_MONOTONIC, &t3);
+        
+        double total_wait = 0.0;
+        for (int i = 0; i < created; i++) {
+            total_wait += ctx->barrier_wait[i];
+        }
+        stats->spawn_time = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9
+                          + (t3.tv_sec - t2.tv_sec) + (t3.tv_nsec - t2.tv_nsec) / 1e9;
+        stats->barrier_time = total_wait / created;
+        stats->barrier_count = args[0].barriers;
+        stats->num_threads = created;
+    }
+    
+    int ok = !pool_failed(ctx);
+    free(ctx->pivot_slots);
+    free(ctx->barrier_wait);
+    free(threads);
+    free(args);
+    return ok;
+}
+
+/**
+ * Phân tích trên pool; substitute = 1: cùng pool giải tiếp b -> x
+ */
+static int factor_on_pool(LinearSystem *sys, int num_threads, int block_size,
+                          int fused_pivot, int substitute, PoolStats *stats) {
+    SolveContext ctx;
+    ctx.sys = sys;
+    ctx.num_threads = num_threads;
+    ctx.block_size = block_size;
+    ctx.fused_pivot = fused_pivot;
+    ctx.X = NULL;
+    ctx.batch = NULL;
+    ctx.mixed = NULL;
+    ctx.substitute = substitute;
+    ctx.band = NULL;
+    ctx.tridiag = NULL;
+    ctx.sparse = NULL;
+    ctx.ooc = NULL;
+    ctx.mtx = NULL;
+    ctx.verify = NULL;
+    
+    // Bản không khối dừng ở cột n-2: kiểm tra nốt phần tử chéo cuối
+    int ok = run_pool(&ctx, stats);
+    if (ok && fabs(row_ptr(sys, sys->n - 1)[sys->n - 1]) < 1e-12) {
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * Phân tích PA = LU bằng pool luồng (L đơn vị dưới đường chéo, U từ đường
+ * chéo trở lên, P trong perm); sau đó giải được nhiều vế phải bằng lu_solve
+ * hoặc lu_solve_multi_pthread.
+ */
+int lu_factor_pthread(LinearSystem *sys, int num_threads, int block_size,
+                      int fused_pivot, PoolStats *stats) {
+    return factor_on_pool(sys, num_threads, block_size, fused_pivot, 0, stats);
+}
+
+/**
+ * Giải A*X = B cho m vế phải cùng lúc bằng LU đã phân tích. B, X là ma trận
+ * n x m row-major (bước ldb, ldx, không trùng nhau), B theo thứ tự hàng gốc.
+ * Thế xuôi/ngược theo khối: mỗi hệ số L/U được đọc một lần cho cả lát cột
+ * thay vì một lần cho mỗi vế phải, phần lớn công việc là cập nhật dạng GEMM.
+ */
+void lu_solve_multi_pthread(LinearSystem *sys, int num_threads,
+                            const double *B, int ldb, double *X, int ldx, int m) {
+    SolveContext ctx;
+    ctx.sys = sys;
+    ctx.num_threads = num_threads;
+    ctx.block_size = 0;
+    ctx.fused_pivot = 0;
+    ctx.rhs = B;
+    ctx.ldb = ldb;
+    ctx.X = X;
+    ctx.ldx = ldx;
+    ctx.m = m;
+    ctx.batch = NULL;
+    ctx.mixed = NULL;
+    ctx.substitute = 0;
+    ctx.band = NULL;
+    ctx.tridiag = NULL;
+    ctx.sparse = NULL;
+    ctx.ooc = NULL;
+    ctx.mtx = NULL;
+    ctx.verify = NULL;
+    run_pool(&ctx, NULL);
+}
+
+/**
+ * Giải lô hệ nhỏ (gauss_batch.h) trên pool luồng, chia đều các nhóm
+ */
+void batch_solve_pthread(BatchSystem *bs, int num_threads) {
+    // batch_kernel là riêng của đơn vị biên dịch này
+    batch_init();
+    
+    SolveContext ctx;
+    ctx.sys = NULL;
+    ctx.num_threads = num_threads;
+    ctx.block_size = 0;
+    ctx.fused_pivot = 0;
+    ctx.X = NULL;
+    ctx.batch = bs;
+    ctx.mixed = NULL;
+    ctx.substitute = 0;
+    ctx.band = NULL;
+    ctx.tridiag = NULL;
+    ctx.sparse = NULL;
+    ctx.ooc = NULL;
+    ctx.mtx = NULL;
+    ctx.verify = NULL;
+    run_pool(&ctx, NULL);
+}
+
+/**
+ * Chạy một VerifyJob trên pool luồng (sys chỉ cần khi sinh hệ test)
+ */
+static int run_verify_job(LinearSystem *sys, VerifyJob *job, int num_threads) {
+    SolveContext ctx;
+    ctx.sys = sys;
+    ctx.num_threads = num_threads;
+    ctx.block_size = 0;
+    ctx.fused_pivot = 0;
+    ctx.X = NULL;
+    ctx.batch = NULL;
+    ctx.mixed = NULL;
+    ctx.substitute = 0;
+    ctx.band = NULL;
+    ctx.tridiag = NULL;
+    ctx.sparse = NULL;
+    ctx.ooc = NULL;
+    ctx.mtx = NULL;
+    ctx.verify = job;
+    int ok = run_pool(&ctx, NULL);
+    return ok ? ctx.num_threads : 0;
+}
+
+/**
+ * Tạo hệ phương trình test với ma trận dominant diagonal (gauss_verify.h)
+ * trên pool luồng; b = A * x với x[i] = i + 1 tính ngay khi hàng còn trong
+ * cache
+ */
+void generate_test_system_pthread(LinearSystem *sys, int num_threads) {
+    int n = sys->n;
+    
+    double *true_x = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        true_x[i] = i + 1.0;
+    }
+    
+    VerifyJob job;
+    job.true_x = true_x;
+    job.src = NULL;
+    job.x = NULL;
+    job.parts = NULL;
+    run_verify_job(sys, &job, num_threads);
+    
+    free(true_x);
+}
+
+/**
+ * Sai số ngược ||b - A*x|| / (||A|| * ||x|| + ||b||) của nghiệm x trên hệ gốc
+ * (gauss_verify.h): mỗi luồng một dải hàng, gộp chuẩn sau khi join
+ */
+double verify_solution_pthread(const VerifySource *src, const double *x, int num_threads) {
+    VerifyJob job;
+    job.true_x = NULL;
+    job.src = src;
+    job.x = x;
+    job.parts = malloc(num_threads * sizeof(VerifyNorms));
+    int threads = run_verify_job(NULL, &job, num_threads);
+    
+    VerifyNorms acc;
+    verify_norms_init(&acc);
+    for (int t = 0; t < threads; t++) {
+        verify_norms_merge(&acc, &job.parts[t]);
+    }
+    free(job.parts);
+    
+    // Pool không chạy được: báo lỗi qua NaN để kiểm tra thất bại
+    return threads ? verify_backward_error(&acc, src->n, x, src->b) : NAN;
+}
+
+/**
+ * Hàm rỗng cho phép đo chi phí tạo/join luồng
+ */
+static void* noop_thread(void *arg) {
+    return arg;
+}
+
+/**
+ * Đo chi phí của cách làm cũ: mỗi lần gọi tạo rồi join num_threads luồng.
+ * Trả về tổng thời gian cho rounds lần (cách cũ dùng 2 lần mỗi cột).
+ */
+double measure_legacy_spawn_cost(int num_threads, int rounds) {
+    pthread_t *threads = malloc(num_threads * sizeof(pthread_t));
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    
+    for (int r = 0; r < rounds; r++) {
+        int created = 0;
+        for (int i = 0; i < num_threads; i++) {
+            if (pthread_create(&threads[i], NULL, noop_thread, NULL) != 0) {
+                break;
+            }
+            created++;
+        }
+        for (int i = 0; i < created; i++) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    free(threads);
+    return (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+}
+
+/**
+ * Thuật toán Gaussian Elimination sử dụng Pthreads
+ * block_size > 0: LU khối; block_size = 0: khử từng cột (rank-1)
+ * fused_pivot: tìm pivot cột kế tiếp ngay trong lượt khử
+ * stats != NULL: đo chi phí pool và barrier
+ */
+int gaussian_elimination_pthread(LinearSystem *sys, int num_threads, int block_size,
+                                 int fused_pivot, PoolStats *stats) {
+    // Khử xuôi rồi thế xuôi/ngược khối trên cùng một pool luồng
+    return factor_on_pool(sys, num_threads, block_size, fused_pivot, 1, stats);
+}
+
+/**
+ * LU float + tinh chỉnh lặp double (gauss_mixed.h) với LU float trên pool
+ * luồng. Cần hệ vừa tạo (A, b chưa bị khử, perm đơn vị); A, b không bị sửa
+ * nếu tinh chỉnh hội tụ. Nếu LU float thất bại hoặc tinh chỉnh chững lại thì
+ * giải lại bằng double (*fallback = 1).
+ */
+int gaussian_elimination_mixed_pthread(LinearSystem *sys, int num_threads, int block_size,
+                                       int fused_pivot, int *iterations, int *fallback) {
+    MixedLU *m = mixed_create(sys->n);
+    *iterations = 0;
+    *fallback = 0;
+    
+    int ok = (m != NULL);
+    if (ok) {
+        SolveContext ctx;
+        ctx.sys = sys;
+        ctx.num_threads = num_threads;
+        ctx.block_size = (block_size > 0) ? block_size : DEFAULT_BLOCK_SIZE;
+        ctx.fused_pivot = 0;
+        ctx.X = NULL;
+        ctx.batch = NULL;
+        ctx.mixed = m;
+        ctx.substitute = 0;
+        ctx.band = NULL;
+        ctx.tridiag = NULL;
+        ctx.sparse = NULL;
+        ctx.ooc = NULL;
+        ctx.mtx = NULL;
+        ctx.verify = NULL;
+        ok = run_pool(&ctx, NULL) &&
+             mixed_refine(m, sys->A, sys->lda, sys->b, sys->x, iterations);
+    }
+    mixed_free(m);
+    
+    if (!ok) {
+        *fallback = 1;
+        return gaussian_elimination_pthread(sys, num_threads, block_size, fused_pivot, NULL);
+    }
+    return 1;
+}
+
+/**
+ * Giải phân hoạch hệ ba đường chéo (gauss_tridiag.h) trên pool luồng, mỗi
+ * luồng một phần liên tục; hệ nhỏ dùng Thomas tuần tự
+ */
+int tridiag_solve_pthread(TridiagSystem *ts, int num_threads) {
+    int n = ts->n;
+    int parts = (num_threads < n / TRIDIAG_MIN_ROWS) ? num_threads : n / TRIDIAG_MIN_ROWS;
+    if (n < TRIDIAG_PARALLEL_MIN || parts < 2) {
+        return tridiag_thomas(ts);
+    }
+    
+    int *bounds = malloc((parts + 1) * sizeof(int));
+    for (int p = 0; p <= parts; p++) {
+        bounds[p] = (int)((long)n * p / parts);
+    }
+    
+    SolveContext ctx;
+    ctx.sys = NULL;
+    ctx.num_threads = parts;
+    ctx.block_size = 0;
+    ctx.fused_pivot = 0;
+    ctx.X = NULL;
+    ctx.batch = NULL;
+    ctx.mixed = NULL;
+    ctx.substitute = 0;
+    ctx.band = NULL;
+    ctx.tridiag = ts;
+    ctx.tridiag_bounds = bounds;
+    ctx.tridiag_parts = parts;
+    ctx.sparse = NULL;
+    ctx.ooc = NULL;
+    ctx.mtx = NULL;
+    ctx.verify = NULL;
+    int ok = run_pool(&ctx, NULL);
+    
+    free(bounds);
+    return ok;
+}
+
+/**
+ * Phân tích số LU thưa (gauss_sparse.h) trên pool luồng: các cây con rời
+ * nhau của cây khử đi qua hàng đợi dùng chung, supernode cha chờ các con
+ */
+int sparse_factor_pthread(SparseLU *lu, int num_threads) {
+    int ns = lu->nsuper;
+    SparseQueue q;
+    pthread_mutex_init(&q.lock, NULL);
+    pthread_cond_init(&q.ready_cond, NULL);
+    q.ready = malloc(ns * sizeof(int));
+    q.pending = calloc(ns, sizeof(int));
+    q.fronts = calloc(ns, sizeof(double*));
+    q.ready_count = 0;
+    q.units_left = 0;
+    
+    // Đơn vị: supernode lớn, hoặc gốc của một cây con nhỏ có cha lớn
+    for (int s = 0; s < ns; s++) {
+        int p = lu->super_parent[s];
+        int big = lu->subtree_work[s] >= SPARSE_TASK_MIN;
+        if (big || p == -1 || lu->subtree_work[p] >= SPARSE_TASK_MIN) {
+            q.units_left++;
+            if (p != -1) {
+                q.pending[p]++;
+            }
+        }
+    }
+    for (int s = 0; s < ns; s++) {
+        int p = lu->super_parent[s];
+        int unit = lu->subtree_work[s] >= SPARSE_TASK_MIN || p == -1 ||
+                   lu->subtree_work[p] >= SPARSE_TASK_MIN;
+        if (unit && q.pending[s] == 0) {
+            q.ready[q.ready_count++] = s;
+        }
+    }
+    
+    SolveContext ctx;
+    ctx.sys = NULL;
+    ctx.num_threads = num_threads;
+    ctx.block_size = 0;
+    ctx.fused_pivot = 0;
+    ctx.X = NULL;
+    ctx.batch = NULL;
+    ctx.mixed = NULL;
+    ctx.substitute = 0;
+    ctx.band = NULL;
+    ctx.tridiag = NULL;
+    ctx.sparse = lu;
+    ctx.ooc = NULL;
+    ctx.mtx = NULL;
+    ctx.verify = NULL;
+    ctx.sparse_queue = &q;
+    int ok = run_pool(&ctx, NULL);
+    
+    // Front còn lại khi có lỗi
+    for (int s = 0; s < ns; s++) {
+        free(q.fronts[s]);
+    }
+    free(q.fronts);
+    free(q.ready);
+    free(q.pending);
+    pthread_mutex_destroy(&q.lock);
+    pthread_cond_destroy(&q.ready_cond);
+    return ok;
+}
+
+/**
+ * LU ngoài bộ nhớ (gauss_ooc.h) trên pool luồng, luồng I/O riêng đọc trước
+ * panel kế tiếp
+ */
+int ooc_factor_pthread(OocMatrix *m, int num_threads) {
+    OocRead *plan;
+    int len = ooc_factor_plan(m, &plan);
+    OocStream *st = ooc_stream_open(m, plan, len);
+    if (!st) {
+        free(plan);
+        return 0;
+    }
+    
+    SolveContext ctx;
+    ctx.sys = NULL;
+    ctx.num_threads = num_threads;
+    ctx.block_size = 0;
+    ctx.fused_pivot = 0;
+    ctx.X = NULL;
+    ctx.batch = NULL;
+    ctx.mixed = NULL;
+    ctx.substitute = 0;
+    ctx.band = NULL;
+    ctx.tridiag = NULL;
+    ctx.sparse = NULL;
+    ctx.ooc = m;
+    ctx.mtx = NULL;
+    ctx.verify = NULL;
+    ctx.ooc_stream = st;
+    int ok = run_pool(&ctx, NULL);
+    
+    ooc_stream_close(st);
+    free(plan);
+    return ok;
+}
+
+/**
+ * Thomas khối cho hệ khối ba đường chéo (gauss_tridiag.h): mỗi khối đường
+ * chéo đã trừ phần bù Schur được chép vào một LinearSystem m x m rồi dùng lại
+ * LU dense của phiên bản này (lu_solve cho vế phải, lu_solve_multi cho khối
+ * C_i). D, C bị ghi đè; x nhận nghiệm.
+ */
+int block_tridiag_solve_pthread(BlockTridiag *bt, int block_size, int num_threads) {
+    int m = bt->m;
+    size_t mm = (size_t)m * m;
+    int threads = (m >= BTD_PARALLEL_MIN) ? num_threads : 1;
+    double *tmp = malloc(mm * sizeof(double));
+    if (!tmp) {
+        return 0;
+    }
+    int ok = 1;
+    
+    // Khử xuôi: D_i -= A_i * C'_{i-1}, y_i = D_i^-1 * (b_i - A_i * y_{i-1})
+    for (int i = 0; i < bt->nb && ok; i++) {
+        double *D = bt->D + i * mm;
+        double *C = bt->C + i * mm;
+        double *y = bt->x + (size_t)i * m;
+        memcpy(tmp, bt->b + (size_t)i * m, m * sizeof(double));
+        if (i > 0) {
+            btd_gemm_sub(m, bt->A + i * mm, C - mm, D);
+            btd_gemv_sub(m, bt->A + i * mm, y - m, tmp);
+        }
+        
+        LinearSystem *blk = create_system(m);
+        if (!blk) {
+            ok = 0;
+            break;
+        }
+        for (int r = 0; r < m; r++) {
+            memcpy(row_ptr(blk, r), D + (size_t)r * m, m * sizeof(double));
+        }
+        memset(blk->b, 0, m * sizeof(double));
+        ok = lu_factor_pthread(blk, threads, block_size, 1, NULL);
+        if (ok) {
+            lu_solve(blk, tmp, y);
+            if (i + 1 < bt->nb) {
+                lu_solve_multi_pthread(blk, threads, C, m, tmp, m, m);
+                memcpy(C, tmp, mm * sizeof(double));
+            }
+        }
+        free_system(blk);
+    }
+    
+    // Thế ngược: x_i = y_i - C'_i * x_{i+1}
+    for (int i = bt->nb - 2; i >= 0 && ok; i--) {
+        btd_gemv_sub(m, bt->C + i * mm, bt->x + (size_t)(i + 1) * m, bt->x + (size_t)i * m);
+    }
+    
+    free(tmp);
+    return ok;
+}
+
+/**
+ * LU băng khối trên pool luồng. Băng hẹp (kl * (kl + ku) < BAND_PARALLEL_MIN)
+ * quá ít việc mỗi panel so với barrier nên chạy band_factor tuần tự.
+ */
+int band_factor_pthread(BandSystem *bs, int num_threads) {
+    if ((long)bs->kl * (bs->kl + bs->ku) < BAND_PARALLEL_MIN) {
+        return band_factor(bs);
+    }
+    
+    SolveContext ctx;
+    ctx.sys = NULL;
+    ctx.num_threads = num_threads;
+    ctx.block_size = 0;
+    ctx.fused_pivot = 0;
+    ctx.X = NULL;
+    ctx.batch = NULL;
+    ctx.mixed = NULL;
+    ctx.substitute = 0;
+    ctx.band = bs;
+    ctx.tridiag = NULL;
+    ctx.sparse = NULL;
+    ctx.ooc = NULL;
+    ctx.mtx = NULL;
+    ctx.verify = NULL;
+    ctx.band_ju = 0;
+    return run_pool(&ctx, NULL);
+}
+
+/**
+ * Đọc phần dữ liệu .mtx song song trên pool luồng: sys != NULL nạp vào hệ
+ * dense (xoá ma trận trước), ngược lại vào mảng toạ độ rows/cols/vals.
+ * Trả về 0 nếu dữ liệu hỏng.
+ */
+int mtx_read_pthread(const MtxFile *f, LinearSystem *sys, int *rows, int *cols, double *vals,
+                     int num_threads) {
+    MtxJob job;
+    job.file = f;
+    job.rows = rows;
+    job.cols = cols;
+    job.vals = vals;
+    job.parts = num_threads * 4;
+    job.bounds = malloc((job.parts + 1) * sizeof(size_t));
+    job.first = malloc((job.parts + 1) * sizeof(long));
+    mtx_split(f, job.parts, job.bounds);
+    
+    SolveContext ctx;
+    ctx.sys = sys;
+    ctx.num_threads = num_threads;
+    ctx.block_size = 0;
+    ctx.fused_pivot = 0;
+    ctx.X = NULL;
+    ctx.batch = NULL;
+    ctx.mixed = NULL;
+    ctx.substitute = 0;
+    ctx.band = NULL;
+    ctx.tridiag = NULL;
+    ctx.sparse = NULL;
+    ctx.ooc = NULL;
+    ctx.mtx = &job;
+    ctx.verify = NULL;
+    int ok = run_pool(&ctx, NULL);
+    
+    free(job.bounds);
+    free(job.first);
+    return ok;
+}
+
+/**
+ * Engine Pthread của libgauss (gauss.h) trên hệ bọc bộ đệm của caller
+ * (wrap_system); pool luồng tạo và join trong lần gọi
+ */
+int gauss_solve_pthread(int n, double *A, int lda, double *b, double *x, int *perm,
+                        int num_threads, int block_size) {
+    if (n <= 0 || lda < n || !A || !b || !x || num_threads <= 0) {
+        return GAUSS_EINVAL;
+    }
+    
+    LinearSystem sys;
+    if (!wrap_system(&sys, n, A, lda, b, x, perm)) {
+        return GAUSS_ENOMEM;
+    }
+    
+    int ok = gaussian_elimination_pthread(&sys, num_threads,
+                                          (block_size < 0) ? DEFAULT_BLOCK_SIZE : block_size,
+                                          1, NULL);
+    
+    unwrap_system(&sys, perm);
+    return ok ? GAUSS_OK : GAUSS_ESINGULAR;
+}
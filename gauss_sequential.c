@@ -0,0 +1,304 @@
+/**
+ * GAUSSIAN ELIMINATION - ENGINE TUẦN TỰ (libgauss)
+ * LU dense từng cột / theo khối, LU float + tinh chỉnh lặp và Thomas khối;
+ * chương trình sequential (sequential.c) và gauss_solve_sequential gọi vào đây
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gauss_core.h"
+
+
+/**
+ * Tạo hệ phương trình test với ma trận dominant diagonal (gauss_verify.h),
+ * b = A * x với x[i] = i + 1 tính ngay khi hàng còn trong cache
+ */
+void generate_test_system(LinearSystem *sys) {
+    int n = sys->n;
+    
+    double *true_x = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        true_x[i] = i + 1.0;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        double *row = row_ptr(sys, i);
+        verify_test_row(n, i, 0, n, row);
+        sys->b[i] = simd_dot(n, row, true_x);
+    }
+    
+    free(true_x);
+}
+
+/**
+ * Sai số ngược ||b - A*x|| / (||A|| * ||x|| + ||b||) của nghiệm x trên hệ gốc
+ * (gauss_verify.h), không dùng A đã bị LU ghi đè
+ */
+double verify_solution(const VerifySource *src, const double *x) {
+    VerifyNorms acc;
+    verify_norms_init(&acc);
+    verify_rows(src, x, 0, src->n, &acc);
+    return verify_backward_error(&acc, src->n, x, src->b);
+}
+
+/**
+ * Thế ngược (Backward Substitution) trên tam giác trên U
+ */
+static int back_substitution(LinearSystem *sys) {
+    int n = sys->n;
+    
+    // Kiểm tra phần tử cuối cùng trên đường chéo
+    if (fabs(row_ptr(sys, n-1)[n-1]) < 1e-12) {
+        return 0;
+    }
+    
+    solve_upper(sys, sys->b, sys->x);
+    return 1;
+}
+
+/**
+ * LU cổ điển: mỗi cột một lần cập nhật rank-1 lên toàn bộ ma trận con,
+ * hệ số nhân L được giữ lại ở phần dưới đường chéo
+ */
+static int lu_factor_unblocked(LinearSystem *sys) {
+    int n = sys->n;
+    
+    for (int k = 0; k < n - 1; k++) {
+        // Tìm pivot lớn nhất trong cột k (từ hàng k trở xuống)
+        int max_row = k;
+        double max_val = fabs(row_ptr(sys, k)[k]);
+        
+        for (int i = k + 1; i < n; i++) {
+            double val = fabs(row_ptr(sys, i)[k]);
+            if (val > max_val) {
+                max_val = val;
+                max_row = i;
+            }
+        }
+        
+        // Kiểm tra ma trận có khả nghịch không
+        if (max_val < 1e-12) {
+            return 0;
+        }
+        
+        // Hoán đổi hàng k với hàng max_row nếu cần (chỉ đổi chỉ số)
+        if (max_row != k) {
+            swap_rows(sys, k, max_row);
+        }
+        
+        // Khử các phần tử dưới pivot
+        double *row_k = row_ptr(sys, k);
+        for (int i = k + 1; i < n; i++) {
+            double *row_i = row_ptr(sys, i);
+            double factor = row_i[k] / row_k[k];
+            row_i[k] = factor;
+            
+            // Cập nhật hàng i
+            simd_axpy(n - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * Phân tích panel gồm các cột k0 .. k0+kb-1 với partial pivoting.
+ * Hệ số nhân L được giữ lại ở phần dưới đường chéo; chỉ các cột trong
+ * panel được cập nhật, phần bên phải để dành cho cập nhật khối.
+ */
+static int factor_panel(LinearSystem *sys, int k0, int kb) {
+    int n = sys->n;
+    int k_end = k0 + kb;
+    
+    for (int k = k0; k < k_end; k++) {
+        int max_row = k;
+        double max_val = fabs(row_ptr(sys, k)[k]);
+        
+        for (int i = k + 1; i < n; i++) {
+            double val = fabs(row_ptr(sys, i)[k]);
+            if (val > max_val) {
+                max_val = val;
+                max_row = i;
+            }
+        }
+        
+        if (max_val < 1e-12) {
+            return 0;
+        }
+        
+        // Đổi cả hàng qua perm: tương đương áp dụng lô hoán vị cho mọi cột
+        if (max_row != k) {
+            swap_rows(sys, k, max_row);
+        }
+        
+        double *row_k = row_ptr(sys, k);
+        for (int i = k + 1; i < n; i++) {
+            double *row_i = row_ptr(sys, i);
+            double factor = row_i[k] / row_k[k];
+            row_i[k] = factor;
+            
+            simd_axpy(k_end - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * LU khối right-looking: panel -> giải tam giác khối hàng -> cập nhật ma trận con
+ * Kết quả: PA = LU lưu tại chỗ (L dưới đường chéo, U từ đường chéo trở lên)
+ */
+static int lu_factor_blocked(LinearSystem *sys, int block_size) {
+    int n = sys->n;
+    
+    for (int k0 = 0; k0 < n; k0 += block_size) {
+        int kb = (k0 + block_size < n) ? block_size : n - k0;
+        
+        if (!factor_panel(sys, k0, kb)) {
+            return 0;
+        }
+        
+        update_row_block(sys, k0, kb, k0 + kb, n);
+        update_trailing(sys, k0, kb, k0 + kb, n);
+    }
+    
+    return 1;
+}
+
+/**
+ * Thế xuôi với L đơn vị: b <- L^-1 * b (b đã được hoán vị cùng các hàng)
+ */
+static void forward_substitution(LinearSystem *sys) {
+    solve_lower(sys, sys->b);
+}
+
+/**
+ * Phân tích PA = LU một lần (L đơn vị dưới đường chéo, U từ đường chéo trở
+ * lên, P trong perm) để sau đó giải nhiều vế phải bằng lu_solve.
+ * block_size > 0: LU khối; block_size = 0: từng cột (rank-1)
+ */
+int lu_factor(LinearSystem *sys, int block_size) {
+    int n = sys->n;
+    int ok = (block_size > 0) ? lu_factor_blocked(sys, block_size) : lu_factor_unblocked(sys);
+    
+    // Bản không khối dừng ở cột n-2: kiểm tra nốt phần tử chéo cuối
+    if (ok && fabs(row_ptr(sys, n-1)[n-1]) < 1e-12) {
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * Thuật toán Gaussian Elimination với Partial Pivoting
+ * block_size > 0: LU khối; block_size = 0: khử từng cột (rank-1)
+ */
+int gaussian_elimination(LinearSystem *sys, int block_size) {
+    // Giai đoạn 1: Khử xuôi (Forward Elimination)
+    if (!lu_factor(sys, block_size)) {
+        return 0;
+    }
+    forward_substitution(sys);
+    
+    // Giai đoạn 2: Thế ngược (Backward Substitution)
+    return back_substitution(sys);
+}
+
+/**
+ * LU float + tinh chỉnh lặp double (gauss_mixed.h). Cần hệ vừa tạo (A, b chưa
+ * bị khử, perm đơn vị); A, b không bị sửa nếu tinh chỉnh hội tụ. Nếu LU float
+ * thất bại hoặc tinh chỉnh chững lại thì giải lại bằng double (*fallback = 1).
+ */
+int gaussian_elimination_mixed(LinearSystem *sys, int block_size, int *iterations, int *fallback) {
+    int n = sys->n;
+    MixedLU *m = mixed_create(n);
+    *iterations = 0;
+    *fallback = 0;
+    
+    // LU float luôn theo khối (không có bản khử từng cột)
+    int ok = m && mixed_load(m, sys->A, sys->lda, 0, n) &&
+             mixed_factor(m, (block_size > 0) ? block_size : DEFAULT_BLOCK_SIZE) &&
+             mixed_refine(m, sys->A, sys->lda, sys->b, sys->x, iterations);
+    mixed_free(m);
+    
+    if (!ok) {
+        *fallback = 1;
+        return gaussian_elimination(sys, block_size);
+    }
+    return 1;
+}
+
+/**
+ * Thomas khối cho hệ khối ba đường chéo (gauss_tridiag.h): mỗi khối đường
+ * chéo đã trừ phần bù Schur được chép vào một LinearSystem m x m rồi dùng lại
+ * LU dense của phiên bản này (lu_solve cho vế phải, lu_solve_multi cho khối
+ * C_i). D, C bị ghi đè; x nhận nghiệm.
+ */
+int block_tridiag_solve(BlockTridiag *bt, int block_size) {
+    int m = bt->m;
+    size_t mm = (size_t)m * m;
+    double *tmp = malloc(mm * sizeof(double));
+    if (!tmp) {
+        return 0;
+    }
+    int ok = 1;
+    
+    // Khử xuôi: D_i -= A_i * C'_{i-1}, y_i = D_i^-1 * (b_i - A_i * y_{i-1})
+    for (int i = 0; i < bt->nb && ok; i++) {
+        double *D = bt->D + i * mm;
+        double *C = bt->C + i * mm;
+        double *y = bt->x + (size_t)i * m;
+        memcpy(tmp, bt->b + (size_t)i * m, m * sizeof(double));
+        if (i > 0) {
+            btd_gemm_sub(m, bt->A + i * mm, C - mm, D);
+            btd_gemv_sub(m, bt->A + i * mm, y - m, tmp);
+        }
+        
+        LinearSystem *blk = create_system(m);
+        if (!blk) {
+            ok = 0;
+            break;
+        }
+        for (int r = 0; r < m; r++) {
+            memcpy(row_ptr(blk, r), D + (size_t)r * m, m * sizeof(double));
+        }
+        memset(blk->b, 0, m * sizeof(double));
+        ok = lu_factor(blk, block_size);
+        if (ok) {
+            lu_solve(blk, tmp, y);
+            if (i + 1 < bt->nb) {
+                lu_solve_multi(blk, C, m, tmp, m, m);
+                memcpy(C, tmp, mm * sizeof(double));
+            }
+        }
+        free_system(blk);
+    }
+    
+    // Thế ngược: x_i = y_i - C'_i * x_{i+1}
+    for (int i = bt->nb - 2; i >= 0 && ok; i--) {
+        btd_gemv_sub(m, bt->C + i * mm, bt->x + (size_t)(i + 1) * m, bt->x + (size_t)i * m);
+    }
+    
+    free(tmp);
+    return ok;
+}
+
+/**
+ * Engine tuần tự của libgauss (gauss.h) trên hệ bọc bộ đệm của caller (wrap_system)
+ */
+int gauss_solve_sequential(int n, double *A, int lda, double *b, double *x, int *perm,
+                           int block_size) {
+    if (n <= 0 || lda < n || !A || !b || !x) {
+        return GAUSS_EINVAL;
+    }
+    
+    LinearSystem sys;
+    if (!wrap_system(&sys, n, A, lda, b, x, perm)) {
+        return GAUSS_ENOMEM;
+    }
+    
+    int ok = gaussian_elimination(&sys, (block_size < 0) ? DEFAULT_BLOCK_SIZE : block_size);
+    
+    unwrap_system(&sys, perm);
+    return ok ? GAUSS_OK : GAUSS_ESINGULAR;
+}
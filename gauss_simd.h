@@ -0,0 +1,641 @@
+/**
+ * GAUSS SIMD - KERNEL VECTOR HÓA DÙNG CHUNG
+ * AXPY / dot product cho SSE2, AVX2+FMA, AVX-512 với dispatch theo CPUID
+ *
+ * Kernel được chọn lúc nạp chương trình (simd_init trong constructor của mỗi
+ * đơn vị biên dịch), sau đó dùng simd_axpy / simd_axpy4 / simd_dot /
+ * simd_gemv4 (bản float: simd_axpyf / simd_axpy4f cho LU độ chính xác đơn,
+ * gấp đôi số phần tử mỗi vector). Biến môi trường GAUSS_SIMD (scalar | sse2 |
+ * avx2 | avx512) cho phép ép chọn kernel để so sánh.
+ */
+
+#ifndef GAUSS_SIMD_H
+#define GAUSS_SIMD_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GAUSS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Bảng kernel được chọn lúc khởi động
+typedef struct {
+    // y[0..len) += a * x[0..len)
+    void (*axpy)(int len, double a, const double *x, double *y);
+    // y[0..len) += a[0]*x0 + a[1]*x1 + a[2]*x2 + a[3]*x3 (4 AXPY gộp một lượt)
+    void (*axpy4)(int len, const double *a, const double *x0, const double *x1,
+                  const double *x2, const double *x3, double *y);
+    // Trả về sum(x[0..len) * y[0..len))
+    double (*dot)(int len, const double *x, const double *y);
+    // 4 hàng của tích ma trận-vector: d[r] += sum(a_r * x), s[r] += sum(|a_r|)
+    // (tổng |a| cho chuẩn vô cùng của A trong cùng một lượt đọc)
+    void (*gemv4)(int len, const double *a0, const double *a1, const double *a2,
+                  const double *a3, const double *x, double *d, double *s);
+    // Bản float của axpy / axpy4
+    void (*axpyf)(int len, float a, const float *x, float *y);
+    void (*axpy4f)(int len, const float *a, const float *x0, const float *x1,
+                   const float *x2, const float *x3, float *y);
+    const char *name;
+} SimdKernels;
+
+static SimdKernels simd_kernels;
+
+/* ===================== Kernel vô hướng (mọi kiến trúc) ===================== */
+
+static void axpy_scalar(int len, double a, const double *x, double *y) {
+    for (int j = 0; j < len; j++) {
+        y[j] += a * x[j];
+    }
+}
+
+static void axpy4_scalar(int len, const double *a, const double *x0, const double *x1,
+                         const double *x2, const double *x3, double *y) {
+    for (int j = 0; j < len; j++) {
+        y[j] += a[0] * x0[j] + a[1] * x1[j] + a[2] * x2[j] + a[3] * x3[j];
+    }
+}
+
+static double dot_scalar(int len, const double *x, const double *y) {
+    // 4 tổng riêng để không bị nghẽn ở độ trễ phép cộng
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    int j = 0;
+    for (; j + 3 < len; j += 4) {
+        s0 += x[j] * y[j];
+        s1 += x[j+1] * y[j+1];
+        s2 += x[j+2] * y[j+2];
+        s3 += x[j+3] * y[j+3];
+    }
+    for (; j < len; j++) {
+        s0 += x[j] * y[j];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+static void gemv4_scalar(int len, const double *a0, const double *a1, const double *a2,
+                         const double *a3, const double *x, double *d, double *s) {
+    double d0 = 0.0, d1 = 0.0, d2 = 0.0, d3 = 0.0;
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    for (int j = 0; j < len; j++) {
+        d0 += a0[j] * x[j];
+        d1 += a1[j] * x[j];
+        d2 += a2[j] * x[j];
+        d3 += a3[j] * x[j];
+        s0 += fabs(a0[j]);
+        s1 += fabs(a1[j]);
+        s2 += fabs(a2[j]);
+        s3 += fabs(a3[j]);
+    }
+    d[0] += d0; d[1] += d1; d[2] += d2; d[3] += d3;
+    s[0] += s0; s[1] += s1; s[2] += s2; s[3] += s3;
+}
+
+static void axpyf_scalar(int len, float a, const float *x, float *y) {
+    for (int j = 0; j < len; j++) {
+        y[j] += a * x[j];
+    }
+}
+
+static void axpy4f_scalar(int len, const float *a, const float *x0, const float *x1,
+                          const float *x2, const float *x3, float *y) {
+    for (int j = 0; j < len; j++) {
+        y[j] += a[0] * x0[j] + a[1] * x1[j] + a[2] * x2[j] + a[3] * x3[j];
+    }
+}
+
+#ifdef GAUSS_SIMD_X86
+
+/* ===================== SSE2 (128-bit, 2 double) ===================== */
+
+__attribute__((target("sse2")))
+static void axpy_sse2(int len, double a, const double *x, double *y) {
+    int j = 0;
+    // Phần đầu: đưa y về căn lề 16 byte để store luôn căn lề
+    if (len > 0 && ((uintptr_t)y & 15) != 0) {
+        y[0] += a * x[0];
+        j = 1;
+    }
+    __m128d va = _mm_set1_pd(a);
+    for (; j + 3 < len; j += 4) {
+        __m128d y0 = _mm_load_pd(y + j);
+        __m128d y1 = _mm_load_pd(y + j + 2);
+        y0 = _mm_add_pd(y0, _mm_mul_pd(va, _mm_loadu_pd(x + j)));
+        y1 = _mm_add_pd(y1, _mm_mul_pd(va, _mm_loadu_pd(x + j + 2)));
+        _mm_store_pd(y + j, y0);
+        _mm_store_pd(y + j + 2, y1);
+    }
+    for (; j < len; j++) {
+        y[j] += a * x[j];
+    }
+}
+
+__attribute__((target("sse2")))
+static void axpy4_sse2(int len, const double *a, const double *x0, const double *x1,
+                       const double *x2, const double *x3, double *y) {
+    int j = 0;
+    if (len > 0 && ((uintptr_t)y & 15) != 0) {
+        y[0] += a[0] * x0[0] + a[1] * x1[0] + a[2] * x2[0] + a[3] * x3[0];
+        j = 1;
+    }
+    __m128d a0 = _mm_set1_pd(a[0]), a1 = _mm_set1_pd(a[1]);
+    __m128d a2 = _mm_set1_pd(a[2]), a3 = _mm_set1_pd(a[3]);
+    for (; j + 1 < len; j += 2) {
+        __m128d acc = _mm_add_pd(_mm_mul_pd(a0, _mm_loadu_pd(x0 + j)),
+                                 _mm_mul_pd(a1, _mm_loadu_pd(x1 + j)));
+        acc = _mm_add_pd(acc, _mm_add_pd(_mm_mul_pd(a2, _mm_loadu_pd(x2 + j)),
+                                         _mm_mul_pd(a3, _mm_loadu_pd(x3 + j))));
+        _mm_store_pd(y + j, _mm_add_pd(_mm_load_pd(y + j), acc));
+    }
+    for (; j < len; j++) {
+        y[j] += a[0] * x0[j] + a[1] * x1[j] + a[2] * x2[j] + a[3] * x3[j];
+    }
+}
+
+__attribute__((target("sse2")))
+static double dot_sse2(int len, const double *x, const double *y) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    int j = 0;
+    for (; j + 3 < len; j += 4) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(x + j), _mm_loadu_pd(y + j)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(x + j + 2), _mm_loadu_pd(y + j + 2)));
+    }
+    double buf[2];
+    _mm_storeu_pd(buf, _mm_add_pd(s0, s1));
+    double sum = buf[0] + buf[1];
+    for (; j < len; j++) {
+        sum += x[j] * y[j];
+    }
+    return sum;
+}
+
+__attribute__((target("sse2")))
+static void gemv4_sse2(int len, const double *a0, const double *a1, const double *a2,
+                       const double *a3, const double *x, double *d, double *s) {
+    const double *a[4] = {a0, a1, a2, a3};
+    __m128d sign = _mm_set1_pd(-0.0);
+    __m128d vd[4], vs[4];
+    for (int r = 0; r < 4; r++) {
+        vd[r] = _mm_setzero_pd();
+        vs[r] = _mm_setzero_pd();
+    }
+    int j = 0;
+    for (; j + 1 < len; j += 2) {
+        __m128d vx = _mm_loadu_pd(x + j);
+        for (int r = 0; r < 4; r++) {
+            __m128d v = _mm_loadu_pd(a[r] + j);
+            vd[r] = _mm_add_pd(vd[r], _mm_mul_pd(v, vx));
+            vs[r] = _mm_add_pd(vs[r], _mm_andnot_pd(sign, v));
+        }
+    }
+    for (int r = 0; r < 4; r++) {
+        double bd[2], bs[2];
+        _mm_storeu_pd(bd, vd[r]);
+        _mm_storeu_pd(bs, vs[r]);
+        d[r] += bd[0] + bd[1];
+        s[r] += bs[0] + bs[1];
+        for (int t = j; t < len; t++) {
+            d[r] += a[r][t] * x[t];
+            s[r] += fabs(a[r][t]);
+        }
+    }
+}
+
+__attribute__((target("sse2")))
+static void axpyf_sse2(int len, float a, const float *x, float *y) {
+    __m128 va = _mm_set1_ps(a);
+    int j = 0;
+    for (; j + 3 < len; j += 4) {
+        _mm_storeu_ps(y + j, _mm_add_ps(_mm_loadu_ps(y + j), _mm_mul_ps(va, _mm_loadu_ps(x + j))));
+    }
+    for (; j < len; j++) {
+        y[j] += a * x[j];
+    }
+}
+
+__attribute__((target("sse2")))
+static void axpy4f_sse2(int len, const float *a, const float *x0, const float *x1,
+                        const float *x2, const float *x3, float *y) {
+    __m128 a0 = _mm_set1_ps(a[0]), a1 = _mm_set1_ps(a[1]);
+    __m128 a2 = _mm_set1_ps(a[2]), a3 = _mm_set1_ps(a[3]);
+    int j = 0;
+    for (; j + 3 < len; j += 4) {
+        __m128 acc = _mm_add_ps(_mm_mul_ps(a0, _mm_loadu_ps(x0 + j)),
+                                _mm_mul_ps(a1, _mm_loadu_ps(x1 + j)));
+        acc = _mm_add_ps(acc, _mm_add_ps(_mm_mul_ps(a2, _mm_loadu_ps(x2 + j)),
+                                         _mm_mul_ps(a3, _mm_loadu_ps(x3 + j))));
+        _mm_storeu_ps(y + j, _mm_add_ps(_mm_loadu_ps(y + j), acc));
+    }
+    for (; j < len; j++) {
+        y[j] += a[0] * x0[j] + a[1] * x1[j] + a[2] * x2[j] + a[3] * x3[j];
+    }
+}
+
+/* ===================== AVX2 + FMA (256-bit, 4 double) ===================== */
+
+__attribute__((target("avx2,fma")))
+static void axpy_avx2(int len, double a, const double *x, double *y) {
+    int j = 0;
+    // Phần đầu vô hướng tới khi y căn lề 32 byte
+    while (j < len && ((uintptr_t)(y + j) & 31) != 0) {
+        y[j] += a * x[j];
+        j++;
+    }
+    __m256d va = _mm256_set1_pd(a);
+    for (; j + 7 < len; j += 8) {
+        __m256d y0 = _mm256_fmadd_pd(va, _mm256_loadu_pd(x + j), _mm256_load_pd(y + j));
+        __m256d y1 = _mm256_fmadd_pd(va, _mm256_loadu_pd(x + j + 4), _mm256_load_pd(y + j + 4));
+        _mm256_store_pd(y + j, y0);
+        _mm256_store_pd(y + j + 4, y1);
+    }
+    for (; j + 3 < len; j += 4) {
+        _mm256_store_pd(y + j, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + j), _mm256_load_pd(y + j)));
+    }
+    for (; j < len; j++) {
+        y[j] += a * x[j];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void axpy4_avx2(int len, const double *a, const double *x0, const double *x1,
+                       const double *x2, const double *x3, double *y) {
+    int j = 0;
+    while (j < len && ((uintptr_t)(y + j) & 31) != 0) {
+        y[j] += a[0] * x0[j] + a[1] * x1[j] + a[2] * x2[j] + a[3] * x3[j];
+        j++;
+    }
+    __m256d a0 = _mm256_set1_pd(a[0]), a1 = _mm256_set1_pd(a[1]);
+    __m256d a2 = _mm256_set1_pd(a[2]), a3 = _mm256_set1_pd(a[3]);
+    for (; j + 3 < len; j += 4) {
+        __m256d acc = _mm256_load_pd(y + j);
+        acc = _mm256_fmadd_pd(a0, _mm256_loadu_pd(x0 + j), acc);
+        acc = _mm256_fmadd_pd(a1, _mm256_loadu_pd(x1 + j), acc);
+        acc = _mm256_fmadd_pd(a2, _mm256_loadu_pd(x2 + j), acc);
+        acc = _mm256_fmadd_pd(a3, _mm256_loadu_pd(x3 + j), acc);
+        _mm256_store_pd(y + j, acc);
+    }
+    for (; j < len; j++) {
+        y[j] += a[0] * x0[j] + a[1] * x1[j] + a[2] * x2[j] + a[3] * x3[j];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static double dot_avx2(int len, const double *x, const double *y) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    int j = 0;
+    for (; j + 7 < len; j += 8) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + j), _mm256_loadu_pd(y + j), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + j + 4), _mm256_loadu_pd(y + j + 4), s1);
+    }
+    for (; j + 3 < len; j += 4) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + j), _mm256_loadu_pd(y + j), s0);
+    }
+    s0 = _mm256_add_pd(s0, s1);
+    __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s0), _mm256_extractf128_pd(s0, 1));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+    for (; j < len; j++) {
+        sum += x[j] * y[j];
+    }
+    return sum;
+}
+
+__attribute__((target("avx2,fma")))
+static void gemv4_avx2(int len, const double *a0, const double *a1, const double *a2,
+                       const double *a3, const double *x, double *d, double *s) {
+    const double *a[4] = {a0, a1, a2, a3};
+    __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d vd[4], vs[4];
+    for (int r = 0; r < 4; r++) {
+        vd[r] = _mm256_setzero_pd();
+        vs[r] = _mm256_setzero_pd();
+    }
+    int j = 0;
+    for (; j + 3 < len; j += 4) {
+        __m256d vx = _mm256_loadu_pd(x + j);
+        for (int r = 0; r < 4; r++) {
+            __m256d v = _mm256_loadu_pd(a[r] + j);
+            vd[r] = _mm256_fmadd_pd(v, vx, vd[r]);
+            vs[r] = _mm256_add_pd(vs[r], _mm256_andnot_pd(sign, v));
+        }
+    }
+    for (int r = 0; r < 4; r++) {
+        double bd[4], bs[4];
+        _mm256_storeu_pd(bd, vd[r]);
+        _mm256_storeu_pd(bs, vs[r]);
+        d[r] += (bd[0] + bd[1]) + (bd[2] + bd[3]);
+        s[r] += (bs[0] + bs[1]) + (bs[2] + bs[3]);
+        for (int t = j; t < len; t++) {
+            d[r] += a[r][t] * x[t];
+            s[r] += fabs(a[r][t]);
+        }
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void axpyf_avx2(int len, float a, const float *x, float *y) {
+    __m256 va = _mm256_set1_ps(a);
+    int j = 0;
+    for (; j + 15 < len; j += 16) {
+        __m256 y0 = _mm256_fmadd_ps(va, _mm256_loadu_ps(x + j), _mm256_loadu_ps(y + j));
+        __m256 y1 = _mm256_fmadd_ps(va, _mm256_loadu_ps(x + j + 8), _mm256_loadu_ps(y + j + 8));
+        _mm256_storeu_ps(y + j, y0);
+        _mm256_storeu_ps(y + j + 8, y1);
+    }
+    for (; j + 7 < len; j += 8) {
+        _mm256_storeu_ps(y + j, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + j), _mm256_loadu_ps(y + j)));
+    }
+    for (; j < len; j++) {
+        y[j] += a * x[j];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void axpy4f_avx2(int len, const float *a, const float *x0, const float *x1,
+                        const float *x2, const float *x3, float *y) {
+    __m256 a0 = _mm256_set1_ps(a[0]), a1 = _mm256_set1_ps(a[1]);
+    __m256 a2 = _mm256_set1_ps(a[2]), a3 = _mm256_set1_ps(a[3]);
+    int j = 0;
+    for (; j + 7 < len; j += 8) {
+        __m256 acc = _mm256_loadu_ps(y + j);
+        acc = _mm256_fmadd_ps(a0, _mm256_loadu_ps(x0 + j), acc);
+        acc = _mm256_fmadd_ps(a1, _mm256_loadu_ps(x1 + j), acc);
+        acc = _mm256_fmadd_ps(a2, _mm256_loadu_ps(x2 + j), acc);
+        acc = _mm256_fmadd_ps(a3, _mm256_loadu_ps(x3 + j), acc);
+        _mm256_storeu_ps(y + j, acc);
+    }
+    for (; j < len; j++) {
+        y[j] += a[0] * x0[j] + a[1] * x1[j] + a[2] * x2[j] + a[3] * x3[j];
+    }
+}
+
+/* ===================== AVX-512F (512-bit, 8 double) ===================== */
+
+__attribute__((target("avx512f")))
+static void axpy_avx512(int len, double a, const double *x, double *y) {
+    int j = 0;
+    __m512d va = _mm512_set1_pd(a);
+    // Phần đầu: store có mask tới khi y căn lề 64 byte
+    int head = (int)((64 - ((uintptr_t)y & 63)) & 63) / 8;
+    if (head > len) {
+        head = len;
+    }
+    if (head > 0) {
+        __mmask8 m = (__mmask8)((1u << head) - 1);
+        __m512d vy = _mm512_maskz_loadu_pd(m, y);
+        vy = _mm512_fmadd_pd(va, _mm512_maskz_loadu_pd(m, x), vy);
+        _mm512_mask_storeu_pd(y, m, vy);
+        j = head;
+    }
+    for (; j + 15 < len; j += 16) {
+        __m512d y0 = _mm512_fmadd_pd(va, _mm512_loadu_pd(x + j), _mm512_load_pd(y + j));
+        __m512d y1 = _mm512_fmadd_pd(va, _mm512_loadu_pd(x + j + 8), _mm512_load_pd(y + j + 8));
+        _mm512_store_pd(y + j, y0);
+        _mm512_store_pd(y + j + 8, y1);
+    }
+    for (; j + 7 < len; j += 8) {
+        _mm512_store_pd(y + j, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + j), _mm512_load_pd(y + j)));
+    }
+    // Phần đuôi: mask thay vì vòng lặp vô hướng
+    if (j < len) {
+        __mmask8 m = (__mmask8)((1u << (len - j)) - 1);
+        __m512d vy = _mm512_maskz_loadu_pd(m, y + j);
+        vy = _mm512_fmadd_pd(va, _mm512_maskz_loadu_pd(m, x + j), vy);
+        _mm512_mask_storeu_pd(y + j, m, vy);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void axpy4_avx512(int len, const double *a, const double *x0, const double *x1,
+                         const double *x2, const double *x3, double *y) {
+    __m512d a0 = _mm512_set1_pd(a[0]), a1 = _mm512_set1_pd(a[1]);
+    __m512d a2 = _mm512_set1_pd(a[2]), a3 = _mm512_set1_pd(a[3]);
+    int j = 0;
+    int head = (int)((64 - ((uintptr_t)y & 63)) & 63) / 8;
+    if (head > len) {
+        head = len;
+    }
+    if (head > 0) {
+        __mmask8 m = (__mmask8)((1u << head) - 1);
+        __m512d acc = _mm512_maskz_loadu_pd(m, y);
+        acc = _mm512_fmadd_pd(a0, _mm512_maskz_loadu_pd(m, x0), acc);
+        acc = _mm512_fmadd_pd(a1, _mm512_maskz_loadu_pd(m, x1), acc);
+        acc = _mm512_fmadd_pd(a2, _mm512_maskz_loadu_pd(m, x2), acc);
+        acc = _mm512_fmadd_pd(a3, _mm512_maskz_loadu_pd(m, x3), acc);
+        _mm512_mask_storeu_pd(y, m, acc);
+        j = head;
+    }
+    for (; j + 7 < len; j += 8) {
+        __m512d acc = _mm512_load_pd(y + j);
+        acc = _mm512_fmadd_pd(a0, _mm512_loadu_pd(x0 + j), acc);
+        acc = _mm512_fmadd_pd(a1, _mm512_loadu_pd(x1 + j), acc);
+        acc = _mm512_fmadd_pd(a2, _mm512_loadu_pd(x2 + j), acc);
+        acc = _mm512_fmadd_pd(a3, _mm512_loadu_pd(x3 + j), acc);
+        _mm512_store_pd(y + j, acc);
+    }
+    if (j < len) {
+        __mmask8 m = (__mmask8)((1u << (len - j)) - 1);
+        __m512d acc = _mm512_maskz_loadu_pd(m, y + j);
+        acc = _mm512_fmadd_pd(a0, _mm512_maskz_loadu_pd(m, x0 + j), acc);
+        acc = _mm512_fmadd_pd(a1, _mm512_maskz_loadu_pd(m, x1 + j), acc);
+        acc = _mm512_fmadd_pd(a2, _mm512_maskz_loadu_pd(m, x2 + j), acc);
+        acc = _mm512_fmadd_pd(a3, _mm512_maskz_loadu_pd(m, x3 + j), acc);
+        _mm512_mask_storeu_pd(y + j, m, acc);
+    }
+}
+
+__attribute__((target("avx512f")))
+static double dot_avx512(int len, const double *x, const double *y) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    int j = 0;
+    for (; j + 15 < len; j += 16) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + j), _mm512_loadu_pd(y + j), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + j + 8), _mm512_loadu_pd(y + j + 8), s1);
+    }
+    for (; j + 7 < len; j += 8) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + j), _mm512_loadu_pd(y + j), s0);
+    }
+    if (j < len) {
+        __mmask8 m = (__mmask8)((1u << (len - j)) - 1);
+        s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, x + j), _mm512_maskz_loadu_pd(m, y + j), s1);
+    }
+    return _mm512_reduce_add_pd(_mm512_add_pd(s0, s1));
+}
+
+__attribute__((target("avx512f")))
+static void gemv4_avx512(int len, const double *a0, const double *a1, const double *a2,
+                         const double *a3, const double *x, double *d, double *s) {
+    const double *a[4] = {a0, a1, a2, a3};
+    __m512d vd[4], vs[4];
+    for (int r = 0; r < 4; r++) {
+        vd[r] = _mm512_setzero_pd();
+        vs[r] = _mm512_setzero_pd();
+    }
+    int j = 0;
+    for (; j + 7 < len; j += 8) {
+        __m512d vx = _mm512_loadu_pd(x + j);
+        for (int r = 0; r < 4; r++) {
+            __m512d v = _mm512_loadu_pd(a[r] + j);
+            vd[r] = _mm512_fmadd_pd(v, vx, vd[r]);
+            vs[r] = _mm512_add_pd(vs[r], _mm512_abs_pd(v));
+        }
+    }
+    if (j < len) {
+        __mmask8 m = (__mmask8)((1u << (len - j)) - 1);
+        __m512d vx = _mm512_maskz_loadu_pd(m, x + j);
+        for (int r = 0; r < 4; r++) {
+            __m512d v = _mm512_maskz_loadu_pd(m, a[r] + j);
+            vd[r] = _mm512_fmadd_pd(v, vx, vd[r]);
+            vs[r] = _mm512_add_pd(vs[r], _mm512_abs_pd(v));
+        }
+    }
+    for (int r = 0; r < 4; r++) {
+        d[r] += _mm512_reduce_add_pd(vd[r]);
+        s[r] += _mm512_reduce_add_pd(vs[r]);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void axpyf_avx512(int len, float a, const float *x, float *y) {
+    __m512 va = _mm512_set1_ps(a);
+    int j = 0;
+    for (; j + 15 < len; j += 16) {
+        _mm512_storeu_ps(y + j, _mm512_fmadd_ps(va, _mm512_loadu_ps(x + j), _mm512_loadu_ps(y + j)));
+    }
+    if (j < len) {
+        __mmask16 m = (__mmask16)((1u << (len - j)) - 1);
+        __m512 vy = _mm512_maskz_loadu_ps(m, y + j);
+        vy = _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(m, x + j), vy);
+        _mm512_mask_storeu_ps(y + j, m, vy);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void axpy4f_avx512(int len, const float *a, const float *x0, const float *x1,
+                          const float *x2, const float *x3, float *y) {
+    __m512 a0 = _mm512_set1_ps(a[0]), a1 = _mm512_set1_ps(a[1]);
+    __m512 a2 = _mm512_set1_ps(a[2]), a3 = _mm512_set1_ps(a[3]);
+    int j = 0;
+    for (; j + 15 < len; j += 16) {
+        __m512 acc = _mm512_loadu_ps(y + j);
+        acc = _mm512_fmadd_ps(a0, _mm512_loadu_ps(x0 + j), acc);
+        acc = _mm512_fmadd_ps(a1, _mm512_loadu_ps(x1 + j), acc);
+        acc = _mm512_fmadd_ps(a2, _mm512_loadu_ps(x2 + j), acc);
+        acc = _mm512_fmadd_ps(a3, _mm512_loadu_ps(x3 + j), acc);
+        _mm512_storeu_ps(y + j, acc);
+    }
+    if (j < len) {
+        __mmask16 m = (__mmask16)((1u << (len - j)) - 1);
+        __m512 acc = _mm512_maskz_loadu_ps(m, y + j);
+        acc = _mm512_fmadd_ps(a0, _mm512_maskz_loadu_ps(m, x0 + j), acc);
+        acc = _mm512_fmadd_ps(a1, _mm512_maskz_loadu_ps(m, x1 + j), acc);
+        acc = _mm512_fmadd_ps(a2, _mm512_maskz_loadu_ps(m, x2 + j), acc);
+        acc = _mm512_fmadd_ps(a3, _mm512_maskz_loadu_ps(m, x3 + j), acc);
+        _mm512_mask_storeu_ps(y + j, m, acc);
+    }
+}
+
+#endif /* GAUSS_SIMD_X86 */
+
+/**
+ * Gán bảng kernel theo tên (trả về 0 nếu CPU không hỗ trợ)
+ */
+static int simd_select(const char *name) {
+    if (strcmp(name, "scalar") == 0) {
+        simd_kernels.axpy = axpy_scalar;
+        simd_kernels.axpy4 = axpy4_scalar;
+        simd_kernels.dot = dot_scalar;
+        simd_kernels.gemv4 = gemv4_scalar;
+        simd_kernels.axpyf = axpyf_scalar;
+        simd_kernels.axpy4f = axpy4f_scalar;
+        simd_kernels.name = "scalar";
+        return 1;
+    }
+#ifdef GAUSS_SIMD_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "avx512") == 0 && __builtin_cpu_supports("avx512f")) {
+        simd_kernels.axpy = axpy_avx512;
+        simd_kernels.axpy4 = axpy4_avx512;
+        simd_kernels.dot = dot_avx512;
+        simd_kernels.gemv4 = gemv4_avx512;
+        simd_kernels.axpyf = axpyf_avx512;
+        simd_kernels.axpy4f = axpy4f_avx512;
+        simd_kernels.name = "AVX-512";
+        return 1;
+    }
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2") &&
+        __builtin_cpu_supports("fma")) {
+        simd_kernels.axpy = axpy_avx2;
+        simd_kernels.axpy4 = axpy4_avx2;
+        simd_kernels.dot = dot_avx2;
+        simd_kernels.gemv4 = gemv4_avx2;
+        simd_kernels.axpyf = axpyf_avx2;
+        simd_kernels.axpy4f = axpy4f_avx2;
+        simd_kernels.name = "AVX2+FMA";
+        return 1;
+    }
+    if (strcmp(name, "sse2") == 0 && __builtin_cpu_supports("sse2")) {
+        simd_kernels.axpy = axpy_sse2;
+        simd_kernels.axpy4 = axpy4_sse2;
+        simd_kernels.dot = dot_sse2;
+        simd_kernels.gemv4 = gemv4_sse2;
+        simd_kernels.axpyf = axpyf_sse2;
+        simd_kernels.axpy4f = axpy4f_sse2;
+        simd_kernels.name = "SSE2";
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+/**
+ * Chọn kernel tốt nhất cho CPU hiện tại (gọi một lần lúc khởi động)
+ */
+static void simd_init(void) {
+    const char *forced = getenv("GAUSS_SIMD");
+    if (forced && simd_select(forced)) {
+        return;
+    }
+
+    if (!simd_select("avx512") && !simd_select("avx2") && !simd_select("sse2")) {
+        simd_select("scalar");
+    }
+}
+
+/**
+ * Bảng kernel là riêng của từng đơn vị biên dịch: mỗi file .c chọn kernel của
+ * mình lúc chương trình (hoặc libgauss.so) được nạp, trước main và mọi luồng
+ */
+__attribute__((constructor)) static void simd_unit_init(void) {
+    simd_init();
+}
+
+static inline void simd_axpy(int len, double a, const double *x, double *y) {
+    simd_kernels.axpy(len, a, x, y);
+}
+
+static inline void simd_axpy4(int len, const double *a, const double *x0, const double *x1,
+                              const double *x2, const double *x3, double *y) {
+    simd_kernels.axpy4(len, a, x0, x1, x2, x3, y);
+}
+
+static inline double simd_dot(int len, const double *x, const double *y) {
+    return simd_kernels.dot(len, x, y);
+}
+
+static inline void simd_gemv4(int len, const double *a0, const double *a1, const double *a2,
+                               const double *a3, const double *x, double *d, double *s) {
+    simd_kernels.gemv4(len, a0, a1, a2, a3, x, d, s);
+}
+
+static inline void simd_axpyf(int len, float a, const float *x, float *y) {
+    simd_kernels.axpyf(len, a, x, y);
+}
+
+static inline void simd_axpy4f(int len, const float *a, const float *x0, const float *x1,
+                               const float *x2, const float *x3, float *y) {
+    simd_kernels.axpy4f(len, a, x0, x1, x2, x3, y);
+}
+
+#endif /* GAUSS_SIMD_H */
@@ -0,0 +1,1311 @@
+/**
+ * GAUSS SPARSE - LU THƯA (CSR) VỚI SẮP XẾP NESTED DISSECTION
+ * Ma trận thưa lưu CSR nên hệ hàng triệu ẩn chỉ tốn O(nnz) bộ nhớ. Lời giải
+ * trực tiếp gồm ba pha:
+ *
+ * - Sắp xếp: nested dissection trên đồ thị của A + A^T (tách đồ thị bằng
+ *   tầng giữa của cấu trúc tầng BFS từ đỉnh gần ngoại biên) để giảm fill-in,
+ *   rồi postorder cây khử để mọi cây con là một đoạn cột liên tục
+ * - Ghép cặp: hoán vị hàng theo ghép cặp hàng - cột có tích |a_ij| lớn nhất
+ *   (như MC64) để đường chéo khác 0 và lớn, nên ma trận không đối xứng hay
+ *   có đường chéo bằng 0 vẫn khử được dù pivot chỉ đổi hàng trong supernode
+ * - Phân tích ký hiệu: cây khử, số phần tử mỗi cột của L (duyệt cây con theo
+ *   hàng), supernode cơ bản và danh sách chỉ số front của từng supernode;
+ *   kích thước L và U biết trước nên pha số không cấp phát lại
+ * - Phân tích số (multifrontal): mỗi supernode gom phần tử của A và khối bù
+ *   Schur của các con vào một front dense, khử các cột của supernode bằng
+ *   LU khối (simd_axpy4) và chuyển phần bù Schur còn lại lên cha
+ *
+ * Pivot theo ngưỡng: ưu tiên phần tử chéo nếu |a_kk| >= SPARSE_PIVOT_TOL *
+ * max cột, nếu không chọn phần tử lớn nhất trong các hàng của supernode (đổi
+ * hàng trong supernode không đổi cấu trúc đã tính). Pivot dưới ngưỡng vẫn
+ * được nhận nhưng được đếm (weak) và sparse_refine bù lại bằng tinh chỉnh
+ * lặp; cột không có pivot khác 0 trong supernode thì trả về lỗi.
+ *
+ * Các cây con rời nhau của cây khử độc lập, nên backend song song chia chúng
+ * cho các luồng (sparse_factor_super là đơn vị công việc); sparse_factor là
+ * bản tuần tự.
+ */
+
+#ifndef GAUSS_SPARSE_H
+#define GAUSS_SPARSE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "gauss_simd.h"
+
+// Ngưỡng pivot (như UMFPACK): phần tử chéo được giữ nếu đạt tỉ lệ này của max cột
+#define SPARSE_PIVOT_TOL 0.1
+
+// Đồ thị con nhỏ hơn ngưỡng này không chia nested dissection nữa
+#define SPARSE_ND_LEAF 64
+
+// Độ rộng panel khi khử các cột của một front
+#define SPARSE_BLOCK 32
+
+// Cột mỗi lát khi cập nhật phần bù Schur của front
+#define SPARSE_COL_CHUNK 512
+
+// Số lần tinh chỉnh lặp tối đa sau khi giải (bù cho pivot dưới ngưỡng)
+#define SPARSE_MAX_REFINE 10
+
+// Cây con có ước lượng flop dưới ngưỡng này: một luồng phân tích cả cây con
+#define SPARSE_TASK_MIN 2e6
+
+// Hệ test ngẫu nhiên (sparse_test_random): số phần tử phụ mỗi hàng và tầm cột
+#define SPARSE_RANDOM_NNZ 4
+#define SPARSE_RANDOM_SPAN 40
+
+// Ma trận thưa CSR: cột của hàng i là j[p[i]] .. j[p[i+1]-1]
+typedef struct {
+    int *p;         // n + 1 phần tử
+    int *j;         // Chỉ số cột
+    double *x;      // Giá trị
+    int n;
+    int nnz;
+} SparseMatrix;
+
+// Kết quả phân tích ký hiệu + hệ số LU của B = P*Q*A*P^T (Q: ghép cặp hàng)
+typedef struct {
+    int n;
+    int *perm;          // Hàng/cột mới k là hàng/cột gốc perm[k]
+    int *iperm;         // Nghịch đảo của perm
+    int *row_perm;      // Hàng k của B là hàng gốc row_perm[k] của A (sau ghép cặp)
+
+    // B theo CSR (gom theo hàng) và CSC (gom theo cột)
+    int *row_p, *row_j;
+    double *row_x;
+    int *col_p, *col_i;
+    double *col_x;
+
+    // Supernode s gồm các cột super_first[s] .. super_first[s+1]-1
+    int nsuper;
+    int *super_first;
+    int *super_parent;  // -1: gốc
+    int *first_desc;    // Supernode đầu tiên trong cây con (cây đã postorder)
+    int *child_p;       // Con của s: child[child_p[s]] .. child[child_p[s+1]-1]
+    int *child;
+
+    // Front của s: chỉ số toàn cục front_idx[front_p[s]] .. (tăng dần); các
+    // cột của supernode đứng đầu, sau đó là các hàng của phần bù Schur
+    int *front_p;
+    int *front_idx;
+    int max_front;
+
+    // Hệ số của s tại LU + lu_p[s]: khối L (nf x ncol, chứa cả U11) rồi
+    // khối U12 (ncol x (nf - ncol)), đều row-major
+    size_t *lu_p;
+    double *LU;
+    int *piv;           // Cột k của supernode đã đổi hàng k với hàng piv[k] (cục bộ)
+    int *weak;          // Số pivot dưới ngưỡng của từng supernode
+
+    double *work;       // Ước lượng flop của từng supernode
+    double *subtree_work;
+    double flops;
+} SparseLU;
+
+static inline SparseMatrix* sparse_create(int n, int nnz) {
+    SparseMatrix *A = malloc(sizeof(SparseMatrix));
+    A->n = n;
+    A->nnz = nnz;
+    A->p = malloc(((size_t)n + 1) * sizeof(int));
+    A->j = malloc((size_t)nnz * sizeof(int));
+    A->x = malloc((size_t)nnz * sizeof(double));
+    if (!A->p || !A->j || !A->x) {
+        free(A->p);
+        free(A->j);
+        free(A->x);
+        free(A);
+        return NULL;
+    }
+    return A;
+}
+
+static inline void sparse_free(SparseMatrix *A) {
+    if (!A) return;
+
+    free(A->p);
+    free(A->j);
+    free(A->x);
+    free(A);
+}
+
+/**
+ * Nghiệm đúng của hệ test
+ */
+static inline double sparse_test_solution(int i) {
+    return 1.0 + i % 10;
+}
+
+/**
+ * Giá trị ngẫu nhiên giả trong [0, 1) theo cặp (i, j)
+ */
+static inline double sparse_test_hash(int i, int j) {
+    uint32_t h = ((uint32_t)i * 40503u + (uint32_t)j * 9973u + 7u) * 2654435761u;
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    return h / 4294967296.0;
+}
+
+/**
+ * Hệ test: lưới 5 điểm k x k (n = k*k ẩn) kiểu đối lưu - khuếch tán, cấu
+ * trúc đối xứng nhưng giá trị không đối xứng; b = A * x_đúng
+ */
+static inline SparseMatrix* sparse_test_system(int k, double *b) {
+    int n = k * k;
+    SparseMatrix *A = sparse_create(n, 5 * n);
+    if (!A) {
+        return NULL;
+    }
+
+    int nnz = 0;
+    for (int i = 0; i < n; i++) {
+        int r = i / k, c = i % k;
+        int nb[5] = { i - k, i - 1, i, i + 1, i + k };
+        int valid[5] = { r > 0, c > 0, 1, c < k - 1, r < k - 1 };
+
+        A->p[i] = nnz;
+        b[i] = 0.0;
+        for (int t = 0; t < 5; t++) {
+            if (!valid[t]) continue;
+            int j = nb[t];
+            double v = (j == i) ? 4.0 + sparse_test_hash(i, j)
+                                : -0.6 - 0.8 * sparse_test_hash(i, j);
+            A->j[nnz] = j;
+            A->x[nnz] = v;
+            b[i] += v * sparse_test_solution(j);
+            nnz++;
+        }
+    }
+    A->p[n] = nnz;
+    A->nnz = nnz;
+    return A;
+}
+
+/**
+ * Hệ test không theo lưới: hàng i có phần tử trội 4 + hash ở cột đối xứng
+ * với i trong nhóm 8 hàng (đường chéo phần lớn bằng 0) và SPARSE_RANDOM_NNZ
+ * phần tử |v| < 1 ở cột ngẫu nhiên cách i không quá SPARSE_RANDOM_SPAN.
+ * Cấu trúc không đối xứng, chỉ khử được sau khi ghép cặp hàng; b = A * x_đúng
+ */
+static inline SparseMatrix* sparse_test_random(int n, double *b) {
+    SparseMatrix *A = sparse_create(n, (SPARSE_RANDOM_NNZ + 1) * n);
+    if (!A) {
+        return NULL;
+    }
+
+    int nnz = 0;
+    for (int i = 0; i < n; i++) {
+        int g = i - i % 8;
+        int last = (g + 7 < n) ? g + 7 : n - 1;
+        int cols[SPARSE_RANDOM_NNZ + 1];
+        double vals[SPARSE_RANDOM_NNZ + 1];
+        int len = 0;
+        cols[len] = g + last - i;
+        vals[len++] = 4.0 + sparse_test_hash(i, n);
+        for (int t = 1; len <= SPARSE_RANDOM_NNZ && t <= 4 * SPARSE_RANDOM_NNZ; t++) {
+            int j = i - SPARSE_RANDOM_SPAN + (int)((2 * SPARSE_RANDOM_SPAN + 1) * sparse_test_hash(i, n + t));
+            if (j < 0 || j >= n) continue;
+            int dup = 0;
+            for (int u = 0; u < len; u++) {
+                dup |= (cols[u] == j);
+            }
+            if (dup) continue;
+            cols[len] = j;
+            vals[len++] = 1.8 * sparse_test_hash(j, i) - 0.9;
+        }
+
+        // Cột trong hàng theo thứ tự tăng như sparse_test_system
+        A->p[i] = nnz;
+        b[i] = 0.0;
+        for (int u = 0; u < len; u++) {
+            int best = u;
+            for (int w = u + 1; w < len; w++) {
+                if (cols[w] < cols[best]) best = w;
+            }
+            int tc = cols[u];
+            cols[u] = cols[best];
+            cols[best] = tc;
+            double tv = vals[u];
+            vals[u] = vals[best];
+            vals[best] = tv;
+            A->j[nnz] = cols[u];
+            A->x[nnz] = vals[u];
+            b[i] += vals[u] * sparse_test_solution(cols[u]);
+            nnz++;
+        }
+    }
+    A->p[n] = nnz;
+    A->nnz = nnz;
+    return A;
+}
+
+/**
+ * Sai số ngược chuẩn hóa ||A*x - b|| / (||A|| * ||x|| + ||b||) (chuẩn vô cùng)
+ */
+static inline double sparse_backward_error(const SparseMatrix *A, const double *x, const double *b) {
+    double norm_a = 0.0, norm_x = 0.0, norm_b = 0.0, norm_r = 0.0;
+
+    for (int i = 0; i < A->n; i++) {
+        double r = -b[i];
+        double row_sum = 0.0;
+        for (int q = A->p[i]; q < A->p[i + 1]; q++) {
+            r += A->x[q] * x[A->j[q]];
+            row_sum += fabs(A->x[q]);
+        }
+        if (row_sum > norm_a) norm_a = row_sum;
+        if (fabs(x[i]) > norm_x) norm_x = fabs(x[i]);
+        if (fabs(b[i]) > norm_b) norm_b = fabs(b[i]);
+        if (fabs(r) > norm_r) norm_r = fabs(r);
+    }
+    return norm_r / (norm_a * norm_x + norm_b);
+}
+
+/**
+ * Chuyển vị CSR: (p, j, x) n hàng -> (tp, tj, tx); x = NULL chỉ chuyển cấu trúc
+ */
+static inline void sparse_transpose(int n, const int *p, const int *j, const double *x,
+                                    int *tp, int *tj, double *tx) {
+    int *next = calloc((size_t)n + 1, sizeof(int));
+    for (int q = 0; q < p[n]; q++) {
+        next[j[q] + 1]++;
+    }
+    for (int i = 0; i < n; i++) {
+        next[i + 1] += next[i];
+    }
+    memcpy(tp, next, ((size_t)n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        for (int q = p[i]; q < p[i + 1]; q++) {
+            int dst = next[j[q]]++;
+            tj[dst] = i;
+            if (x) {
+                tx[dst] = x[q];
+            }
+        }
+    }
+    free(next);
+}
+
+/**
+ * Đồ thị kề của A + A^T (bỏ đường chéo, không trùng cạnh) dạng CSR
+ */
+static inline void sparse_graph(const SparseMatrix *A, int **adj_p, int **adj) {
+    int n = A->n;
+    int *tp = malloc(((size_t)n + 1) * sizeof(int));
+    int *tj = malloc(((size_t)A->nnz + 1) * sizeof(int));
+    sparse_transpose(n, A->p, A->j, NULL, tp, tj, NULL);
+
+    int *mark = malloc((size_t)n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        mark[i] = -1;
+    }
+    int *gp = malloc(((size_t)n + 1) * sizeof(int));
+    int *g = malloc((2 * (size_t)A->nnz + 1) * sizeof(int));
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        gp[i] = count;
+        mark[i] = i;
+        for (int q = A->p[i]; q < A->p[i + 1]; q++) {
+            if (mark[A->j[q]] != i) {
+                mark[A->j[q]] = i;
+                g[count++] = A->j[q];
+            }
+        }
+        for (int q = tp[i]; q < tp[i + 1]; q++) {
+            if (mark[tj[q]] != i) {
+                mark[tj[q]] = i;
+                g[count++] = tj[q];
+            }
+        }
+    }
+    gp[n] = count;
+
+    free(tp);
+    free(tj);
+    free(mark);
+    *adj_p = gp;
+    *adj = g;
+}
+
+/**
+ * BFS từ start trong các đỉnh có label == tag. queue nhận các đỉnh theo thứ
+ * tự tầng, level[v] là tầng; *num_levels nhận số tầng. Trả về số đỉnh tới được.
+ */
+static inline int sparse_bfs(const int *gp, const int *g, const int *label, int tag,
+                             int start, int *queue, int *level, int *num_levels) {
+    int head = 0, tail = 0;
+    queue[tail++] = start;
+    level[start] = 0;
+    while (head < tail) {
+        int v = queue[head++];
+        for (int q = gp[v]; q < gp[v + 1]; q++) {
+            int u = g[q];
+            if (label[u] == tag && level[u] < 0) {
+                level[u] = level[v] + 1;
+                queue[tail++] = u;
+            }
+        }
+    }
+    *num_levels = level[queue[tail - 1]] + 1;
+    return tail;
+}
+
+/**
+ * Nested dissection: order[k] = đỉnh gốc xếp ở vị trí k. Mỗi đồ thị con
+ * [lo, hi) được xếp lại thành [phần 1 | phần 2 | vách ngăn]; vách ngăn là
+ * các đỉnh của tầng giữa (có cạnh sang tầng sau) trong cấu trúc tầng BFS từ
+ * một đỉnh gần ngoại biên. Đồ thị con không liên thông tách theo thành phần.
+ */
+static inline void sparse_nd_order(int n, const int *gp, const int *g, int *order) {
+    int *label = malloc((size_t)n * sizeof(int));
+    int *level = malloc((size_t)n * sizeof(int));
+    int *queue = malloc((size_t)n * sizeof(int));
+    int *stack = malloc(2 * ((size_t)n + 1) * sizeof(int));
+    int *count = malloc(((size_t)n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+        label[i] = -1;
+    }
+
+    int top = 0, tag = 0;
+    stack[top++] = 0;
+    stack[top++] = n;
+    while (top > 0) {
+        int hi = stack[--top];
+        int lo = stack[--top];
+        int size = hi - lo;
+        if (size <= SPARSE_ND_LEAF) {
+            continue;
+        }
+
+        tag++;
+        for (int t = lo; t < hi; t++) {
+            label[order[t]] = tag;
+        }
+
+        // Đỉnh gần ngoại biên: lặp BFS từ đỉnh bậc nhỏ nhất của tầng cuối
+        // khi độ lệch tâm còn tăng
+        int start = order[lo], num_levels = 0, reached = 0;
+        for (int iter = 0; iter < 4; iter++) {
+            for (int t = lo; t < hi; t++) {
+                level[order[t]] = -1;
+            }
+            int prev_levels = num_levels;
+            reached = sparse_bfs(gp, g, label, tag, start, queue, level, &num_levels);
+            if (iter > 0 && num_levels <= prev_levels) {
+                break;
+            }
+            int best = queue[reached - 1], best_deg = n + 1;
+            for (int t = reached - 1; t >= 0 && level[queue[t]] == num_levels - 1; t--) {
+                int deg = gp[queue[t] + 1] - gp[queue[t]];
+                if (deg < best_deg) {
+                    best_deg = deg;
+                    best = queue[t];
+                }
+            }
+            if (best == start) {
+                break;
+            }
+            start = best;
+        }
+        for (int t = lo; t < hi; t++) {
+            level[order[t]] = -1;
+        }
+        reached = sparse_bfs(gp, g, label, tag, start, queue, level, &num_levels);
+
+        if (reached < size) {
+            // Không liên thông: thành phần chứa start | phần còn lại
+            int w = reached;
+            for (int t = lo; t < hi; t++) {
+                if (level[order[t]] < 0) {
+                    queue[w++] = order[t];
+                }
+            }
+            memcpy(order + lo, queue, (size_t)size * sizeof(int));
+            stack[top++] = lo;
+            stack[top++] = lo + reached;
+            stack[top++] = lo + reached;
+            stack[top++] = hi;
+            continue;
+        }
+        if (num_levels < 3) {
+            continue;
+        }
+
+        // Tầng giữa: tầng đầu tiên mà tổng số đỉnh tới hết tầng đó đạt nửa
+        for (int l = 0; l <= num_levels; l++) {
+            count[l] = 0;
+        }
+        for (int t = 0; t < size; t++) {
+            count[level[queue[t]]]++;
+        }
+        int mid = 0, seen = 0;
+        while (mid < num_levels - 2 && seen + count[mid] < size / 2) {
+            seen += count[mid++];
+        }
+        if (mid == 0) {
+            mid = 1;
+        }
+
+        // Đỉnh tầng giữa không có cạnh sang tầng sau chuyển về phần 1
+        int n1 = 0, n2 = 0, ns = 0;
+        for (int t = 0; t < size; t++) {
+            int v = queue[t];
+            int lv = level[v];
+            if (lv == mid) {
+                int cut = 0;
+                for (int q = gp[v]; q < gp[v + 1] && !cut; q++) {
+                    cut = (label[g[q]] == tag && level[g[q]] == mid + 1);
+                }
+                if (!cut) {
+                    level[v] = mid - 1;
+                    lv = mid - 1;
+                }
+            }
+            if (lv < mid) n1++;
+            else if (lv == mid) ns++;
+            else n2++;
+        }
+        int p1 = lo, p2 = lo + n1, ps = lo + n1 + n2;
+        for (int t = 0; t < size; t++) {
+            int v = queue[t];
+            if (level[v] < mid) order[p1++] = v;
+            else if (level[v] == mid) order[ps++] = v;
+            else order[p2++] = v;
+        }
+        stack[top++] = lo;
+        stack[top++] = lo + n1;
+        stack[top++] = lo + n1;
+        stack[top++] = lo + n1 + n2;
+    }
+
+    free(label);
+    free(level);
+    free(queue);
+    free(stack);
+    free(count);
+}
+
+/**
+ * Đưa (d, i) vào heap nhị phân (hd, hi) đang có *size phần tử
+ */
+static inline void sparse_heap_push(double *hd, int *hi, int *size, double d, int i) {
+    int c = (*size)++;
+    while (c > 0 && hd[(c - 1) / 2] > d) {
+        hd[c] = hd[(c - 1) / 2];
+        hi[c] = hi[(c - 1) / 2];
+        c = (c - 1) / 2;
+    }
+    hd[c] = d;
+    hi[c] = i;
+}
+
+/**
+ * Lấy phần tử nhỏ nhất của heap (*size > 0)
+ */
+static inline int sparse_heap_pop(double *hd, int *hi, int *size, double *d) {
+    int top = hi[0];
+    *d = hd[0];
+    double last_d = hd[--(*size)];
+    int last_i = hi[*size];
+    int c = 0;
+    while (2 * c + 1 < *size) {
+        int m = 2 * c + 1;
+        if (m + 1 < *size && hd[m + 1] < hd[m]) {
+            m++;
+        }
+        if (hd[m] >= last_d) {
+            break;
+        }
+        hd[c] = hd[m];
+        hi[c] = hi[m];
+        c = m;
+    }
+    hd[c] = last_d;
+    hi[c] = last_i;
+    return top;
+}
+
+/**
+ * Ghép cặp hàng - cột với tích |a_ij| lớn nhất (như MC64): match[j] nhận
+ * hàng gốc đưa về vị trí chéo của cột j. Chi phí c_ij = log max_i |a_ij| -
+ * log |a_ij| >= 0; ghép tham lam phần tử lớn nhất của mỗi cột, rồi mỗi cột
+ * còn lại tìm đường tăng ngắn nhất tới một hàng tự do (Dijkstra trên chi
+ * phí rút gọn c_ij - u_i - v_j). Trả về 0 nếu A suy biến cấu trúc.
+ */
+static inline int sparse_match(const SparseMatrix *A, int *match) {
+    int n = A->n;
+    int *cp = malloc(((size_t)n + 1) * sizeof(int));
+    int *ci = malloc(((size_t)A->nnz + 1) * sizeof(int));
+    double *cost = malloc(((size_t)A->nnz + 1) * sizeof(double));
+    sparse_transpose(n, A->p, A->j, A->x, cp, ci, cost);
+    for (int j = 0; j < n; j++) {
+        double col_max = 0.0;
+        for (int q = cp[j]; q < cp[j + 1]; q++) {
+            if (fabs(cost[q]) > col_max) {
+                col_max = fabs(cost[q]);
+            }
+        }
+        for (int q = cp[j]; q < cp[j + 1]; q++) {
+            cost[q] = (cost[q] != 0.0) ? log(col_max) - log(fabs(cost[q])) : INFINITY;
+        }
+    }
+
+    int *row_match = malloc((size_t)n * sizeof(int));
+    int *pcol = malloc((size_t)n * sizeof(int));
+    int *done = malloc((size_t)n * sizeof(int));
+    int *fin = malloc((size_t)n * sizeof(int));
+    int *touched = malloc((size_t)n * sizeof(int));
+    double *u = calloc((size_t)n, sizeof(double));
+    double *v = calloc((size_t)n, sizeof(double));
+    double *dist = malloc((size_t)n * sizeof(double));
+    double *hd = malloc(((size_t)A->nnz + 1) * sizeof(double));
+    int *hi = malloc(((size_t)A->nnz + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        row_match[i] = -1;
+        done[i] = -1;
+        dist[i] = INFINITY;
+    }
+
+    // Ghép tham lam: phần tử lớn nhất của cột (chi phí 0) nếu hàng còn tự do
+    for (int j = 0; j < n; j++) {
+        match[j] = -1;
+        for (int q = cp[j]; q < cp[j + 1]; q++) {
+            if (cost[q] == 0.0 && row_match[ci[q]] == -1) {
+                match[j] = ci[q];
+                row_match[ci[q]] = j;
+                break;
+            }
+        }
+    }
+
+    int ok = 1;
+    for (int j0 = 0; j0 < n && ok; j0++) {
+        if (match[j0] != -1) continue;
+
+        // Dijkstra từ cột j0: cột j -> hàng i giá c_ij - u_i - v_j, hàng đã
+        // ghép đi tiếp sang cột của nó với giá 0
+        int size = 0, nfin = 0, ntouched = 0, found = -1;
+        double D = 0.0, dj = 0.0;
+        int j = j0;
+        while (j != -1) {
+            for (int q = cp[j]; q < cp[j + 1]; q++) {
+                int i = ci[q];
+                double nd = dj + cost[q] - u[i] - v[j];
+                if (done[i] != j0 && nd < dist[i]) {
+                    if (dist[i] == INFINITY) {
+                        touched[ntouched++] = i;
+                    }
+                    dist[i] = nd;
+                    pcol[i] = j;
+                    sparse_heap_push(hd, hi, &size, nd, i);
+                }
+            }
+            j = -1;
+            while (size > 0 && j == -1 && found == -1) {
+                double d;
+                int i = sparse_heap_pop(hd, hi, &size, &d);
+                if (done[i] == j0 || d > dist[i]) continue;
+                done[i] = j0;
+                fin[nfin++] = i;
+                if (row_match[i] == -1) {
+                    found = i;
+                    D = d;
+                } else {
+                    j = row_match[i];
+                    dj = d;
+                }
+            }
+        }
+
+        if (found == -1) {
+            ok = 0;
+        } else {
+            // Thế vị mới: cạnh trên đường tăng có chi phí rút gọn 0, mọi cạnh >= 0
+            v[j0] += D;
+            for (int t = 0; t < nfin; t++) {
+                int i = fin[t];
+                if (i != found) {
+                    u[i] -= D - dist[i];
+                    v[row_match[i]] += D - dist[i];
+                }
+            }
+
+            // Đảo cặp dọc đường tăng
+            for (int i = found; ; ) {
+                int jp = pcol[i];
+                int next = match[jp];
+                match[jp] = i;
+                row_match[i] = jp;
+                if (jp == j0) break;
+                i = next;
+            }
+        }
+        for (int t = 0; t < ntouched; t++) {
+            dist[touched[t]] = INFINITY;
+        }
+    }
+
+    free(cp);
+    free(ci);
+    free(cost);
+    free(row_match);
+    free(pcol);
+    free(done);
+    free(fin);
+    free(touched);
+    free(u);
+    free(v);
+    free(dist);
+    free(hd);
+    free(hi);
+    return ok;
+}
+
+/**
+ * Cây khử của đồ thị (gp, g) theo thứ tự mới (perm / iperm), thuật toán Liu
+ * với nén đường đi
+ */
+static inline void sparse_etree(int n, const int *gp, const int *g, const int *perm,
+                                const int *iperm, int *parent) {
+    int *ancestor = malloc((size_t)n * sizeof(int));
+    for (int k = 0; k < n; k++) {
+        parent[k] = -1;
+        ancestor[k] = -1;
+        int v = perm[k];
+        for (int q = gp[v]; q < gp[v + 1]; q++) {
+            int i = iperm[g[q]];
+            while (i != -1 && i < k) {
+                int next = ancestor[i];
+                ancestor[i] = k;
+                if (next == -1) {
+                    parent[i] = k;
+                }
+                i = next;
+            }
+        }
+    }
+    free(ancestor);
+}
+
+/**
+ * Postorder của rừng parent: post[k] = nút đứng thứ k (con trước cha, các
+ * con theo thứ tự chỉ số tăng)
+ */
+static inline void sparse_postorder(int n, const int *parent, int *post) {
+    int *head = malloc((size_t)n * sizeof(int));
+    int *next = malloc((size_t)n * sizeof(int));
+    int *stack = malloc((size_t)n * sizeof(int));
+    for (int j = 0; j < n; j++) {
+        head[j] = -1;
+    }
+    for (int j = n - 1; j >= 0; j--) {
+        if (parent[j] != -1) {
+            next[j] = head[parent[j]];
+            head[parent[j]] = j;
+        }
+    }
+
+    int k = 0;
+    for (int root = 0; root < n; root++) {
+        if (parent[root] != -1) continue;
+        int top = 0;
+        stack[top++] = root;
+        while (top > 0) {
+            int j = stack[top - 1];
+            int c = head[j];
+            if (c == -1) {
+                top--;
+                post[k++] = j;
+            } else {
+                head[j] = next[c];
+                stack[top++] = c;
+            }
+        }
+    }
+    free(head);
+    free(next);
+    free(stack);
+}
+
+static inline void sparse_lu_free(SparseLU *lu) {
+    if (!lu) return;
+
+    free(lu->perm);
+    free(lu->iperm);
+    free(lu->row_perm);
+    free(lu->row_p);
+    free(lu->row_j);
+    free(lu->row_x);
+    free(lu->col_p);
+    free(lu->col_i);
+    free(lu->col_x);
+    free(lu->super_first);
+    free(lu->super_parent);
+    free(lu->first_desc);
+    free(lu->child_p);
+    free(lu->child);
+    free(lu->front_p);
+    free(lu->front_idx);
+    free(lu->lu_p);
+    free(lu->LU);
+    free(lu->piv);
+    free(lu->weak);
+    free(lu->work);
+    free(lu->subtree_work);
+    free(lu);
+}
+
+/**
+ * Phân tích ký hiệu: sắp xếp, cây khử, supernode, front và kích thước LU.
+ * Cấp phát trước toàn bộ bộ nhớ hệ số; trả về NULL nếu không đủ bộ nhớ.
+ */
+static inline SparseLU* sparse_analyze(const SparseMatrix *A) {
+    int n = A->n;
+    SparseLU *lu = calloc(1, sizeof(SparseLU));
+    lu->n = n;
+
+    // Ghép cặp: hàng match[j] của A về vị trí j (A suy biến cấu trúc: giữ
+    // nguyên, phân tích số sẽ báo thiếu pivot)
+    int *match = malloc((size_t)n * sizeof(int));
+    if (!sparse_match(A, match)) {
+        for (int j = 0; j < n; j++) {
+            match[j] = j;
+        }
+    }
+    SparseMatrix *QA = sparse_create(n, A->nnz);
+    if (!QA) {
+        free(match);
+        sparse_lu_free(lu);
+        return NULL;
+    }
+    QA->p[0] = 0;
+    for (int j = 0; j < n; j++) {
+        int r = match[j];
+        int len = A->p[r + 1] - A->p[r];
+        memcpy(QA->j + QA->p[j], A->j + A->p[r], (size_t)len * sizeof(int));
+        QA->p[j + 1] = QA->p[j] + len;
+    }
+
+    int *gp, *g;
+    sparse_graph(QA, &gp, &g);
+    sparse_free(QA);
+
+    // Nested dissection rồi postorder cây khử (không đổi fill-in)
+    int *order = malloc((size_t)n * sizeof(int));
+    int *parent = malloc((size_t)n * sizeof(int));
+    int *post = malloc((size_t)n * sizeof(int));
+    lu->perm = malloc((size_t)n * sizeof(int));
+    lu->iperm = malloc((size_t)n * sizeof(int));
+    sparse_nd_order(n, gp, g, order);
+    for (int k = 0; k < n; k++) {
+        lu->iperm[order[k]] = k;
+    }
+    sparse_etree(n, gp, g, order, lu->iperm, parent);
+    sparse_postorder(n, parent, post);
+    lu->row_perm = malloc((size_t)n * sizeof(int));
+    for (int k = 0; k < n; k++) {
+        lu->perm[k] = order[post[k]];
+        lu->iperm[lu->perm[k]] = k;
+        lu->row_perm[k] = match[lu->perm[k]];
+    }
+    free(match);
+    sparse_etree(n, gp, g, lu->perm, lu->iperm, parent);
+    free(order);
+    free(post);
+
+    // Số phần tử mỗi cột của L: hàng k chạm các cột trên đường từ mỗi láng
+    // giềng i < k lên k trong cây khử
+    int *colcount = malloc((size_t)n * sizeof(int));
+    int *mark = malloc((size_t)n * sizeof(int));
+    for (int j = 0; j < n; j++) {
+        colcount[j] = 1;
+        mark[j] = -1;
+    }
+    for (int k = 0; k < n; k++) {
+        mark[k] = k;
+        int v = lu->perm[k];
+        for (int q = gp[v]; q < gp[v + 1]; q++) {
+            for (int j = lu->iperm[g[q]]; j < k && mark[j] != k; j = parent[j]) {
+                mark[j] = k;
+                colcount[j]++;
+            }
+        }
+    }
+
+    // Supernode cơ bản: j + 1 nối vào supernode của j nếu là cha duy nhất
+    // và cấu trúc cột chỉ ngắn hơn đúng phần tử chéo
+    int *nchild = calloc((size_t)n + 1, sizeof(int));
+    for (int j = 0; j < n; j++) {
+        if (parent[j] != -1) {
+            nchild[parent[j]]++;
+        }
+    }
+    int *super_of = malloc((size_t)n * sizeof(int));
+    lu->super_first = malloc(((size_t)n + 1) * sizeof(int));
+    int ns = 0;
+    for (int j = 0; j < n; j++) {
+        if (j == 0 || !(parent[j - 1] == j && nchild[j] == 1 &&
+                        colcount[j - 1] == colcount[j] + 1)) {
+            lu->super_first[ns++] = j;
+        }
+        super_of[j] = ns - 1;
+    }
+    lu->super_first[ns] = n;
+    lu->nsuper = ns;
+    free(nchild);
+
+    lu->super_parent = malloc((size_t)ns * sizeof(int));
+    lu->first_desc = malloc((size_t)ns * sizeof(int));
+    lu->child_p = calloc((size_t)ns + 1, sizeof(int));
+    lu->child = malloc(((size_t)ns + 1) * sizeof(int));
+    for (int s = 0; s < ns; s++) {
+        int last = lu->super_first[s + 1] - 1;
+        lu->super_parent[s] = (parent[last] == -1) ? -1 : super_of[parent[last]];
+        lu->first_desc[s] = s;
+    }
+    for (int s = 0; s < ns; s++) {
+        int p = lu->super_parent[s];
+        if (p != -1) {
+            lu->child_p[p + 1]++;
+            if (lu->first_desc[s] < lu->first_desc[p]) {
+                lu->first_desc[p] = lu->first_desc[s];
+            }
+        }
+    }
+    for (int s = 0; s < ns; s++) {
+        lu->child_p[s + 1] += lu->child_p[s];
+    }
+    int *fill = malloc(((size_t)ns + 1) * sizeof(int));
+    memcpy(fill, lu->child_p, ((size_t)ns + 1) * sizeof(int));
+    for (int s = 0; s < ns; s++) {
+        if (lu->super_parent[s] != -1) {
+            lu->child[fill[lu->super_parent[s]]++] = s;
+        }
+    }
+
+    // Chỉ số front: cột đầu f của supernode, rồi mọi hàng k > f có L(k, f) != 0
+    // (duyệt lại theo hàng, k tăng dần nên danh sách đã sắp xếp)
+    lu->front_p = malloc(((size_t)ns + 1) * sizeof(int));
+    size_t total_idx = 0;
+    lu->max_front = 0;
+    for (int s = 0; s < ns; s++) {
+        int nf = colcount[lu->super_first[s]];
+        lu->front_p[s] = (int)total_idx;
+        total_idx += nf;
+        if (nf > lu->max_front) {
+            lu->max_front = nf;
+        }
+    }
+    lu->front_p[ns] = (int)total_idx;
+    lu->front_idx = malloc((total_idx + 1) * sizeof(int));
+    for (int s = 0; s < ns; s++) {
+        fill[s] = lu->front_p[s];
+        lu->front_idx[fill[s]++] = lu->super_first[s];
+    }
+    for (int j = 0; j < n; j++) {
+        mark[j] = -1;
+    }
+    for (int k = 0; k < n; k++) {
+        mark[k] = k;
+        int v = lu->perm[k];
+        for (int q = gp[v]; q < gp[v + 1]; q++) {
+            for (int j = lu->iperm[g[q]]; j < k && mark[j] != k; j = parent[j]) {
+                mark[j] = k;
+                if (lu->super_first[super_of[j]] == j) {
+                    lu->front_idx[fill[super_of[j]]++] = k;
+                }
+            }
+        }
+    }
+    free(fill);
+    free(mark);
+    free(super_of);
+    free(colcount);
+    free(parent);
+    free(gp);
+    free(g);
+
+    // Kích thước hệ số và ước lượng flop (cộng dồn lên theo cây con)
+    lu->lu_p = malloc(((size_t)ns + 1) * sizeof(size_t));
+    lu->work = malloc((size_t)ns * sizeof(double));
+    lu->subtree_work = malloc((size_t)ns * sizeof(double));
+    size_t total = 0;
+    lu->flops = 0.0;
+    for (int s = 0; s < ns; s++) {
+        size_t ncol = lu->super_first[s + 1] - lu->super_first[s];
+        size_t nf = lu->front_p[s + 1] - lu->front_p[s];
+        lu->lu_p[s] = total;
+        total += nf * ncol + ncol * (nf - ncol);
+
+        double w = 0.0;
+        for (size_t k = 0; k < ncol; k++) {
+            double rest = (double)(nf - k - 1);
+            w += 2.0 * rest * rest + rest;
+        }
+        lu->work[s] = w;
+        lu->flops += w;
+        lu->subtree_work[s] = w;
+    }
+    lu->lu_p[ns] = total;
+    for (int s = 0; s < ns; s++) {
+        if (lu->super_parent[s] != -1) {
+            lu->subtree_work[lu->super_parent[s]] += lu->subtree_work[s];
+        }
+    }
+
+    // B = P*Q*A*P^T theo hàng và theo cột
+    int nnz = A->nnz;
+    lu->row_p = malloc(((size_t)n + 1) * sizeof(int));
+    lu->row_j = malloc(((size_t)nnz + 1) * sizeof(int));
+    lu->row_x = malloc(((size_t)nnz + 1) * sizeof(double));
+    lu->col_p = malloc(((size_t)n + 1) * sizeof(int));
+    lu->col_i = malloc(((size_t)nnz + 1) * sizeof(int));
+    lu->col_x = malloc(((size_t)nnz + 1) * sizeof(double));
+    int pos = 0;
+    for (int k = 0; k < n; k++) {
+        int v = lu->row_perm[k];
+        lu->row_p[k] = pos;
+        for (int q = A->p[v]; q < A->p[v + 1]; q++) {
+            lu->row_j[pos] = lu->iperm[A->j[q]];
+            lu->row_x[pos] = A->x[q];
+            pos++;
+        }
+    }
+    lu->row_p[n] = pos;
+    sparse_transpose(n, lu->row_p, lu->row_j, lu->row_x, lu->col_p, lu->col_i, lu->col_x);
+
+    lu->LU = malloc((total + 1) * sizeof(double));
+    lu->piv = malloc((size_t)n * sizeof(int));
+    lu->weak = calloc((size_t)ns, sizeof(int));
+    if (!lu->LU || !lu->piv || !lu->weak) {
+        sparse_lu_free(lu);
+        return NULL;
+    }
+    return lu;
+}
+
+/**
+ * Số phần tử khác 0 của L + U (tính cả đường chéo một lần)
+ */
+static inline size_t sparse_lu_nnz(const SparseLU *lu) {
+    return lu->lu_p[lu->nsuper];
+}
+
+/**
+ * Vị trí cục bộ của chỉ số toàn cục gi trong front s (gi phải thuộc front)
+ */
+static inline int sparse_front_pos(const SparseLU *lu, int s, int gi) {
+    int f = lu->super_first[s];
+    int ncol = lu->super_first[s + 1] - f;
+    if (gi < f + ncol) {
+        return gi - f;
+    }
+    const int *idx = lu->front_idx + lu->front_p[s];
+    int lo = ncol, hi = lu->front_p[s + 1] - lu->front_p[s] - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (idx[mid] < gi) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * Khử ncol cột đầu của front F (nf x nf row-major) bằng LU khối: pivot chỉ
+ * chọn trong ncol hàng đầu (ngưỡng SPARSE_PIVOT_TOL, ưu tiên đường chéo),
+ * phần bù Schur nằm lại ở F[ncol.., ncol..]. Trả về 0 nếu không có pivot.
+ */
+static inline int sparse_front_factor(double *F, int nf, int ncol, int *piv, int *weak) {
+    for (int k0 = 0; k0 < ncol; k0 += SPARSE_BLOCK) {
+        int k_end = (k0 + SPARSE_BLOCK < ncol) ? k0 + SPARSE_BLOCK : ncol;
+
+        // Panel: cột k0 .. k_end-1 trên mọi hàng còn lại
+        for (int k = k0; k < k_end; k++) {
+            double col_max = 0.0, cand_max = -1.0;
+            int cand = k;
+            for (int i = k; i < nf; i++) {
+                double val = fabs(F[(size_t)i * nf + k]);
+                if (val > col_max) {
+                    col_max = val;
+                }
+                if (i < ncol && val > cand_max) {
+                    cand_max = val;
+                    cand = i;
+                }
+            }
+            if (!(cand_max > 0.0) || cand_max < 1e-12 * col_max) {
+                return 0;
+            }
+            if (fabs(F[(size_t)k * nf + k]) >= SPARSE_PIVOT_TOL * col_max) {
+                cand = k;
+            } else if (cand_max < SPARSE_PIVOT_TOL * col_max) {
+                (*weak)++;
+            }
+            piv[k] = cand;
+            if (cand != k) {
+                double *r1 = F + (size_t)k * nf, *r2 = F + (size_t)cand * nf;
+                for (int j = 0; j < nf; j++) {
+                    double tmp = r1[j];
+                    r1[j] = r2[j];
+                    r2[j] = tmp;
+                }
+            }
+
+            double *row_k = F + (size_t)k * nf;
+            for (int i = k + 1; i < nf; i++) {
+                double *row_i = F + (size_t)i * nf;
+                double factor = row_i[k] / row_k[k];
+                row_i[k] = factor;
+                simd_axpy(k_end - k - 1, -factor, row_k + k + 1, row_i + k + 1);
+            }
+        }
+
+        // Khối hàng U12 = L11^-1 * A12
+        for (int i = k0 + 1; i < k_end; i++) {
+            double *row_i = F + (size_t)i * nf;
+            for (int p = k0; p < i; p++) {
+                simd_axpy(nf - k_end, -row_i[p], F + (size_t)p * nf + k_end, row_i + k_end);
+            }
+        }
+
+        // A22 -= L21 * U12 (lát cột, gộp 4 hàng U)
+        for (int jc = k_end; jc < nf; jc += SPARSE_COL_CHUNK) {
+            int jc_end = (jc + SPARSE_COL_CHUNK < nf) ? jc + SPARSE_COL_CHUNK : nf;
+            for (int i = k_end; i < nf; i++) {
+                double *row_i = F + (size_t)i * nf;
+                int p = k0;
+                for (; p + 3 < k_end; p += 4) {
+                    double l[4] = { -row_i[p], -row_i[p+1], -row_i[p+2], -row_i[p+3] };
+                    simd_axpy4(jc_end - jc, l,
+                               F + (size_t)p * nf + jc, F + (size_t)(p+1) * nf + jc,
+                               F + (size_t)(p+2) * nf + jc, F + (size_t)(p+3) * nf + jc,
+                               row_i + jc);
+                }
+                for (; p < k_end; p++) {
+                    simd_axpy(jc_end - jc, -row_i[p], F + (size_t)p * nf + jc, row_i + jc);
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * Phân tích supernode s: gom phần tử của B và phần bù Schur của các con
+ * (fronts[c], giải phóng sau khi gom) vào front mới, khử, chép hệ số vào
+ * lu->LU. Front được giữ ở fronts[s] cho cha (gốc thì giải phóng ngay).
+ * Các con phải xong trước; các supernode không cùng tổ tiên chạy song song được.
+ */
+static inline int sparse_factor_super(SparseLU *lu, int s, double **fronts) {
+    int f = lu->super_first[s];
+    int ncol = lu->super_first[s + 1] - f;
+    int nf = lu->front_p[s + 1] - lu->front_p[s];
+    const int *idx = lu->front_idx + lu->front_p[s];
+    lu->weak[s] = 0;
+
+    double *F = calloc((size_t)nf * nf, sizeof(double));
+    int *pos = malloc((size_t)nf * sizeof(int));
+    if (!F || !pos) {
+        free(F);
+        free(pos);
+        return 0;
+    }
+
+    // Phần tử gốc: hàng của supernode (cột >= f) và cột của supernode (hàng
+    // sau supernode)
+    for (int i = f; i < f + ncol; i++) {
+        double *row = F + (size_t)(i - f) * nf;
+        for (int q = lu->row_p[i]; q < lu->row_p[i + 1]; q++) {
+            if (lu->row_j[q] >= f) {
+                row[sparse_front_pos(lu, s, lu->row_j[q])] += lu->row_x[q];
+            }
+        }
+    }
+    for (int j = f; j < f + ncol; j++) {
+        for (int q = lu->col_p[j]; q < lu->col_p[j + 1]; q++) {
+            if (lu->col_i[q] >= f + ncol) {
+                F[(size_t)sparse_front_pos(lu, s, lu->col_i[q]) * nf + (j - f)] += lu->col_x[q];
+            }
+        }
+    }
+
+    // Cộng phần bù Schur của các con (chỉ số con là tập con của front, trộn
+    // hai danh sách đã sắp xếp)
+    for (int t = lu->child_p[s]; t < lu->child_p[s + 1]; t++) {
+        int c = lu->child[t];
+        int ncol_c = lu->super_first[c + 1] - lu->super_first[c];
+        int nf_c = lu->front_p[c + 1] - lu->front_p[c];
+        const int *idx_c = lu->front_idx + lu->front_p[c];
+        double *Fc = fronts[c];
+
+        int m = nf_c - ncol_c;
+        int r = 0;
+        for (int q = 0; q < m; q++) {
+            while (idx[r] != idx_c[ncol_c + q]) {
+                r++;
+            }
+            pos[q] = r;
+        }
+        for (int q = 0; q < m; q++) {
+            const double *src = Fc + (size_t)(ncol_c + q) * nf_c + ncol_c;
+            double *dst = F + (size_t)pos[q] * nf;
+            for (int w = 0; w < m; w++) {
+                dst[pos[w]] += src[w];
+            }
+        }
+        free(Fc);
+        fronts[c] = NULL;
+    }
+    free(pos);
+
+    int ok = sparse_front_factor(F, nf, ncol, lu->piv + f, &lu->weak[s]);
+
+    if (ok) {
+        double *L = lu->LU + lu->lu_p[s];
+        double *U = L + (size_t)nf * ncol;
+        for (int i = 0; i < nf; i++) {
+            memcpy(L + (size_t)i * ncol, F + (size_t)i * nf, (size_t)ncol * sizeof(double));
+        }
+        for (int i = 0; i < ncol; i++) {
+            memcpy(U + (size_t)i * (nf - ncol), F + (size_t)i * nf + ncol,
+                   (size_t)(nf - ncol) * sizeof(double));
+        }
+    }
+    if (!ok || lu->super_parent[s] == -1) {
+        free(F);
+        F = NULL;
+    }
+    fronts[s] = F;
+    return ok;
+}
+
+/**
+ * Phân tích số tuần tự: thứ tự supernode tăng dần đã là con trước cha
+ */
+static inline int sparse_factor(SparseLU *lu) {
+    double **fronts = calloc((size_t)lu->nsuper, sizeof(double*));
+    int ok = 1;
+    for (int s = 0; s < lu->nsuper && ok; s++) {
+        ok = sparse_factor_super(lu, s, fronts);
+    }
+    for (int s = 0; s < lu->nsuper; s++) {
+        free(fronts[s]);
+    }
+    free(fronts);
+    return ok;
+}
+
+/**
+ * Tổng số pivot dưới ngưỡng
+ */
+static inline int sparse_weak_pivots(const SparseLU *lu) {
+    int total = 0;
+    for (int s = 0; s < lu->nsuper; s++) {
+        total += lu->weak[s];
+    }
+    return total;
+}
+
+/**
+ * Giải A*x = b bằng hệ số đã phân tích (b, x theo thứ tự gốc, có thể trùng)
+ */
+static inline void sparse_solve(const SparseLU *lu, const double *b, double *x) {
+    int n = lu->n;
+    double *y = malloc((size_t)n * sizeof(double));
+    double *gather = malloc(((size_t)lu->max_front + 1) * sizeof(double));
+    for (int k = 0; k < n; k++) {
+        y[k] = b[lu->row_perm[k]];
+    }
+
+    // Thế xuôi: đổi hàng trong supernode, L11 đơn vị, rồi trừ L21 * y
+    for (int s = 0; s < lu->nsuper; s++) {
+        int f = lu->super_first[s];
+        int ncol = lu->super_first[s + 1] - f;
+        int nf = lu->front_p[s + 1] - lu->front_p[s];
+        const int *idx = lu->front_idx + lu->front_p[s];
+        const double *L = lu->LU + lu->lu_p[s];
+        double *seg = y + f;
+
+        for (int k = 0; k < ncol; k++) {
+            int p = lu->piv[f + k];
+            double tmp = seg[k];
+            seg[k] = seg[p];
+            seg[p] = tmp;
+        }
+        for (int k = 1; k < ncol; k++) {
+            seg[k] -= simd_dot(k, L + (size_t)k * ncol, seg);
+        }
+        for (int r = ncol; r < nf; r++) {
+            y[idx[r]] -= simd_dot(ncol, L + (size_t)r * ncol, seg);
+        }
+    }
+
+    // Thế ngược: supernode sau đã có nghiệm cho mọi chỉ số ngoài supernode
+    for (int s = lu->nsuper - 1; s >= 0; s--) {
+        int f = lu->super_first[s];
+        int ncol = lu->super_first[s + 1] - f;
+        int nf = lu->front_p[s + 1] - lu->front_p[s];
+        const int *idx = lu->front_idx + lu->front_p[s];
+        const double *L = lu->LU + lu->lu_p[s];
+        const double *U = L + (size_t)nf * ncol;
+        double *seg = y + f;
+
+        for (int r = ncol; r < nf; r++) {
+            gather[r - ncol] = y[idx[r]];
+        }
+        for (int k = ncol - 1; k >= 0; k--) {
+            const double *row_l = L + (size_t)k * ncol;
+            double sum = simd_dot(nf - ncol, U + (size_t)k * (nf - ncol), gather)
+                       + simd_dot(ncol - k - 1, row_l + k + 1, seg + k + 1);
+            seg[k] = (seg[k] - sum) / row_l[k];
+        }
+    }
+
+    for (int k = 0; k < n; k++) {
+        x[lu->perm[k]] = y[k];
+    }
+    free(y);
+    free(gather);
+}
+
+/**
+ * Tinh chỉnh lặp sau sparse_solve: x += A^-1 (b - A*x) với cùng hệ số, tới
+ * khi sai số ngược đạt mức double (bù cho pivot dưới ngưỡng) hoặc hết
+ * max_iter lần. Trả về số lần tinh chỉnh.
+ */
+static inline int sparse_refine(const SparseMatrix *A, const SparseLU *lu, const double *b,
+                                double *x, int max_iter) {
+    int n = A->n;
+    double *r = malloc((size_t)n * sizeof(double));
+    int iter = 0;
+    double prev_error = INFINITY;
+
+    while (iter < max_iter) {
+        double error = sparse_backward_error(A, x, b);
+        if (error <= 4 * DBL_EPSILON || !(error < 0.5 * prev_error)) {
+            break;
+        }
+        prev_error = error;
+        for (int i = 0; i < n; i++) {
+            double sum = b[i];
+            for (int q = A->p[i]; q < A->p[i + 1]; q++) {
+                sum -= A->x[q] * x[A->j[q]];
+            }
+            r[i] = sum;
+        }
+        sparse_solve(lu, r, r);
+        for (int i = 0; i < n; i++) {
+            x[i] += r[i];
+        }
+        iter++;
+    }
+    free(r);
+    return iter;
+}
+
+#endif /* GAUSS_SPARSE_H */
@@ -0,0 +1,442 @@
+/**
+ * GAUSS TRIDIAG - HỆ BA ĐƯỜNG CHÉO VÀ KHỐI BA ĐƯỜNG CHÉO
+ * Hệ ba đường chéo a[i]*x[i-1] + d[i]*x[i] + c[i]*x[i+1] = b[i] chỉ lưu ba
+ * vector (a[0] = c[n-1] = 0), nên giải được cả 10^8 hàng mà create_system
+ * không cấp phát nổi. Không chọn pivot: dành cho hệ trội chéo (PDE ẩn).
+ *
+ * - tridiag_thomas: thuật toán Thomas tuần tự, O(n)
+ * - Giải phân hoạch (kiểu SPIKE): mỗi phần [s, e) khử xuôi rồi ngược độc lập
+ *   (tridiag_partition_reduce) để mọi hàng chỉ còn phụ thuộc x[s] và x[e-1];
+ *   hai hàng biên của các phần tạo một hệ ba đường chéo rút gọn 2P ẩn
+ *   (tridiag_unit_thomas), sau đó mỗi phần tự tính nghiệm bên trong
+ *   (tridiag_partition_finish). Backend chia các phần cho luồng/process.
+ *
+ * Hệ khối ba đường chéo (khối m x m): BlockTridiag giữ các khối dưới A_i,
+ * chéo D_i, trên C_i; backend giải bằng Thomas khối với LU dense của nó cho
+ * khối đường chéo, btd_gemm_sub / btd_gemv_sub cho phần bù Schur.
+ */
+
+#ifndef GAUSS_TRIDIAG_H
+#define GAUSS_TRIDIAG_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gauss_simd.h"
+
+// Mỗi phần của lời giải phân hoạch cần ít nhất 3 hàng
+#define TRIDIAG_MIN_ROWS 3
+
+// Dưới số hàng này backend song song giải bằng Thomas tuần tự
+#define TRIDIAG_PARALLEL_MIN 10000
+
+// Khối nhỏ hơn kích thước này: LU dense của khối chạy một luồng
+#define BTD_PARALLEL_MIN 256
+
+// Hệ ba đường chéo n hàng
+typedef struct {
+    double *a;      // Đường chéo dưới (a[0] = 0)
+    double *d;      // Đường chéo chính
+    double *c;      // Đường chéo trên (c[n-1] = 0)
+    double *b;      // Vế phải
+    double *x;      // Nghiệm (lời giải phân hoạch dùng làm vùng đệm)
+    double *work;   // 2n phần tử trung gian cho Thomas / phân hoạch
+    int n;
+} TridiagSystem;
+
+static inline TridiagSystem* tridiag_create(int n) {
+    TridiagSystem *ts = malloc(sizeof(TridiagSystem));
+    ts->n = n;
+    ts->a = malloc((size_t)n * sizeof(double));
+    ts->d = malloc((size_t)n * sizeof(double));
+    ts->c = malloc((size_t)n * sizeof(double));
+    ts->b = malloc((size_t)n * sizeof(double));
+    ts->x = malloc((size_t)n * sizeof(double));
+    ts->work = malloc(2 * (size_t)n * sizeof(double));
+    if (!ts->a || !ts->d || !ts->c || !ts->b || !ts->x || !ts->work) {
+        free(ts->a);
+        free(ts->d);
+        free(ts->c);
+        free(ts->b);
+        free(ts->x);
+        free(ts->work);
+        free(ts);
+        return NULL;
+    }
+    return ts;
+}
+
+static inline void tridiag_free(TridiagSystem *ts) {
+    if (!ts) return;
+
+    free(ts->a);
+    free(ts->d);
+    free(ts->c);
+    free(ts->b);
+    free(ts->x);
+    free(ts->work);
+    free(ts);
+}
+
+/**
+ * Nghiệm đúng của hệ test
+ */
+static inline double tridiag_test_solution(int i) {
+    return 1.0 + i % 10;
+}
+
+/**
+ * Hàng i (chỉ số toàn cục) của hệ test n hàng: kiểu bước thời gian ẩn của
+ * phương trình nhiệt, trội chéo chặt; b = A * x với x là nghiệm đúng
+ */
+static inline void tridiag_test_row(int i, int n, double *a, double *d, double *c, double *b) {
+    *a = (i > 0) ? -1.0 : 0.0;
+    *c = (i < n - 1) ? -1.0 + 0.1 * (i % 3) : 0.0;
+    *d = 2.5 + 0.1 * (i % 7);
+    *b = *d * tridiag_test_solution(i);
+    if (i > 0) {
+        *b += *a * tridiag_test_solution(i - 1);
+    }
+    if (i < n - 1) {
+        *b += *c * tridiag_test_solution(i + 1);
+    }
+}
+
+/**
+ * Tạo các hàng [begin, end) của hệ test n hàng, hàng toàn cục begin ghi vào
+ * phần tử 0 (MPI: mỗi process tự tạo phần của mình)
+ */
+static inline void tridiag_fill_test(TridiagSystem *ts, int begin, int end, int n) {
+    for (int i = begin; i < end; i++) {
+        int l = i - begin;
+        tridiag_test_row(i, n, &ts->a[l], &ts->d[l], &ts->c[l], &ts->b[l]);
+    }
+}
+
+/**
+ * Thomas tuần tự: khử xuôi (c' trong work, d' trong x) rồi thế ngược.
+ * Trả về 0 nếu pivot ≈ 0.
+ */
+static inline int tridiag_thomas(TridiagSystem *ts) {
+    int n = ts->n;
+    const double *a = ts->a, *d = ts->d, *c = ts->c, *b = ts->b;
+    double *cp = ts->work;
+    double *x = ts->x;
+
+    if (fabs(d[0]) < 1e-12) {
+        return 0;
+    }
+    cp[0] = c[0] / d[0];
+    x[0] = b[0] / d[0];
+    for (int i = 1; i < n; i++) {
+        double pivot = d[i] - a[i] * cp[i - 1];
+        if (fabs(pivot) < 1e-12) {
+            return 0;
+        }
+        cp[i] = c[i] / pivot;
+        x[i] = (b[i] - a[i] * x[i - 1]) / pivot;
+    }
+    for (int i = n - 2; i >= 0; i--) {
+        x[i] -= cp[i] * x[i + 1];
+    }
+    return 1;
+}
+
+/**
+ * Khử phần [s, e) (e - s >= TRIDIAG_MIN_ROWS) độc lập với các phần khác.
+ * Sau bước này hàng i của phần có dạng
+ *     aa[i] * x[s] + x[i] + cc[i] * x[e-1] = dd[i]     (s < i < e-1)
+ * còn hai hàng biên nối sang phần kề:
+ *     aa[s] * x[s-1] + x[s] + cc[s] * x[e-1] = dd[s]
+ *     aa[e-1] * x[s] + x[e-1] + cc[e-1] * x[e] = dd[e-1]
+ * với aa, cc trong work và dd trong x. Trả về 0 nếu pivot ≈ 0.
+ */
+static inline int tridiag_partition_reduce(TridiagSystem *ts, int s, int e) {
+    const double *a = ts->a, *d = ts->d, *c = ts->c, *b = ts->b;
+    double *aa = ts->work;
+    double *cc = ts->work + ts->n;
+    double *dd = ts->x;
+
+    // Khử xuôi: hàng i >= s+2 thay x[i-1] bằng hàng i-1 (phụ thuộc x[s])
+    for (int i = s; i < s + 2; i++) {
+        if (fabs(d[i]) < 1e-12) {
+            return 0;
+        }
+        aa[i] = a[i] / d[i];
+        cc[i] = c[i] / d[i];
+        dd[i] = b[i] / d[i];
+    }
+    for (int i = s + 2; i < e; i++) {
+        double pivot = d[i] - a[i] * cc[i - 1];
+        if (fabs(pivot) < 1e-12) {
+            return 0;
+        }
+        dd[i] = (b[i] - a[i] * dd[i - 1]) / pivot;
+        aa[i] = -a[i] * aa[i - 1] / pivot;
+        cc[i] = c[i] / pivot;
+    }
+
+    // Khử ngược: hàng i thay x[i+1] bằng hàng i+1 (phụ thuộc x[s], x[e-1])
+    for (int i = e - 3; i > s; i--) {
+        dd[i] -= cc[i] * dd[i + 1];
+        aa[i] -= cc[i] * aa[i + 1];
+        cc[i] = -cc[i] * cc[i + 1];
+    }
+    double r = 1.0 - cc[s] * aa[s + 1];
+    if (fabs(r) < 1e-12) {
+        return 0;
+    }
+    dd[s] = (dd[s] - cc[s] * dd[s + 1]) / r;
+    aa[s] = aa[s] / r;
+    cc[s] = -cc[s] * cc[s + 1] / r;
+    return 1;
+}
+
+/**
+ * Giải tại chỗ hệ ba đường chéo m ẩn có đường chéo chính bằng 1 (hệ rút gọn
+ * của lời giải phân hoạch). scratch cần m phần tử. Trả về 0 nếu pivot ≈ 0.
+ */
+static inline int tridiag_unit_thomas(int m, const double *sub, const double *sup,
+                                      double *rhs, double *scratch) {
+    scratch[0] = sup[0];
+    for (int i = 1; i < m; i++) {
+        double pivot = 1.0 - sub[i] * scratch[i - 1];
+        if (fabs(pivot) < 1e-12) {
+            return 0;
+        }
+        scratch[i] = sup[i] / pivot;
+        rhs[i] = (rhs[i] - sub[i] * rhs[i - 1]) / pivot;
+    }
+    for (int i = m - 2; i >= 0; i--) {
+        rhs[i] -= scratch[i] * rhs[i + 1];
+    }
+    return 1;
+}
+
+/**
+ * Ghép hai hàng biên của parts phần (phần p là [bounds[p], bounds[p+1]))
+ * thành hệ rút gọn 2*parts ẩn, giải, rồi ghi x[s], x[e-1] của mọi phần
+ */
+static inline int tridiag_reduced_solve(TridiagSystem *ts, const int *bounds, int parts) {
+    int m = 2 * parts;
+    double *sub = calloc(4 * (size_t)m, sizeof(double));
+    double *sup = sub + m;
+    double *rhs = sub + 2 * m;
+    double *scratch = sub + 3 * m;
+    const double *aa = ts->work;
+    const double *cc = ts->work + ts->n;
+
+    for (int p = 0; p < parts; p++) {
+        int s = bounds[p];
+        int e = bounds[p + 1] - 1;
+        sub[2 * p] = aa[s];
+        sup[2 * p] = cc[s];
+        rhs[2 * p] = ts->x[s];
+        sub[2 * p + 1] = aa[e];
+        sup[2 * p + 1] = cc[e];
+        rhs[2 * p + 1] = ts->x[e];
+    }
+    int ok = tridiag_unit_thomas(m, sub, sup, rhs, scratch);
+    if (ok) {
+        for (int p = 0; p < parts; p++) {
+            ts->x[bounds[p]] = rhs[2 * p];
+            ts->x[bounds[p + 1] - 1] = rhs[2 * p + 1];
+        }
+    }
+    free(sub);
+    return ok;
+}
+
+/**
+ * Nghiệm bên trong phần [s, e) khi đã biết x[s], x[e-1]
+ */
+static inline void tridiag_partition_finish(TridiagSystem *ts, int s, int e) {
+    const double *aa = ts->work;
+    const double *cc = ts->work + ts->n;
+    double *x = ts->x;
+    double xs = x[s], xe = x[e - 1];
+
+    for (int i = s + 1; i < e - 1; i++) {
+        x[i] -= aa[i] * xs + cc[i] * xe;
+    }
+}
+
+/**
+ * Sai số ngược chuẩn hóa ||A*x - b|| / (||A|| * ||x|| + ||b||) (chuẩn vô cùng)
+ */
+static inline double tridiag_backward_error(const TridiagSystem *ts) {
+    int n = ts->n;
+    const double *x = ts->x;
+    double norm_a = 0.0, norm_x = 0.0, norm_b = 0.0, norm_r = 0.0;
+
+    for (int i = 0; i < n; i++) {
+        double r = ts->d[i] * x[i] - ts->b[i];
+        if (i > 0) r += ts->a[i] * x[i - 1];
+        if (i < n - 1) r += ts->c[i] * x[i + 1];
+        double row_sum = fabs(ts->a[i]) + fabs(ts->d[i]) + fabs(ts->c[i]);
+
+        if (row_sum > norm_a) norm_a = row_sum;
+        if (fabs(x[i]) > norm_x) norm_x = fabs(x[i]);
+        if (fabs(ts->b[i]) > norm_b) norm_b = fabs(ts->b[i]);
+        if (fabs(r) > norm_r) norm_r = fabs(r);
+    }
+    return norm_r / (norm_a * norm_x + norm_b);
+}
+
+// Hệ khối ba đường chéo: nb khối hàng, mỗi khối m x m row-major liên tục
+typedef struct {
+    double *A;      // Khối dưới A_i tại A + i*m*m (A_0 không dùng)
+    double *D;      // Khối chéo D_i (bị ghi đè bởi phần bù Schur)
+    double *C;      // Khối trên C_i (bị ghi đè bởi D_i^-1 * C_i; C_{nb-1} không dùng)
+    double *b;      // Vế phải nb*m
+    double *x;      // Nghiệm nb*m
+    int nb;         // Số khối hàng
+    int m;          // Kích thước khối
+} BlockTridiag;
+
+static inline BlockTridiag* btd_create(int nb, int m) {
+    BlockTridiag *bt = malloc(sizeof(BlockTridiag));
+    size_t blocks = (size_t)nb * m * m;
+    bt->nb = nb;
+    bt->m = m;
+    bt->A = malloc(blocks * sizeof(double));
+    bt->D = malloc(blocks * sizeof(double));
+    bt->C = malloc(blocks * sizeof(double));
+    bt->b = malloc((size_t)nb * m * sizeof(double));
+    bt->x = malloc((size_t)nb * m * sizeof(double));
+    if (!bt->A || !bt->D || !bt->C || !bt->b || !bt->x) {
+        free(bt->A);
+        free(bt->D);
+        free(bt->C);
+        free(bt->b);
+        free(bt->x);
+        free(bt);
+        return NULL;
+    }
+    return bt;
+}
+
+static inline void btd_free(BlockTridiag *bt) {
+    if (!bt) return;
+
+    free(bt->A);
+    free(bt->D);
+    free(bt->C);
+    free(bt->b);
+    free(bt->x);
+    free(bt);
+}
+
+/**
+ * Phần tử (r, col) của khối loại kind (0: A, 1: D, 2: C) ở khối hàng i của
+ * hệ test: ngẫu nhiên giả trong [-0.5, 0.5), D_i cộng thêm 3m trên đường chéo
+ * (trội chéo theo khối, Thomas khối ổn định)
+ */
+static inline double btd_test_entry(int kind, int i, int r, int col, int m) {
+    uint32_t h = ((uint32_t)i * 2654435761u) ^
+                 ((uint32_t)(kind * 7919 + r * 40503 + col * 9973 + 1) * 2246822519u);
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    double v = h / 4294967296.0 - 0.5;
+    if (kind == 1 && r == col) {
+        v += 3.0 * m;
+    }
+    return v;
+}
+
+/**
+ * Tạo hệ test khối: b = A * x với x[k] = tridiag_test_solution(k)
+ */
+static inline void btd_fill_test(BlockTridiag *bt) {
+    int nb = bt->nb, m = bt->m;
+    size_t mm = (size_t)m * m;
+
+    for (int i = 0; i < nb; i++) {
+        for (int r = 0; r < m; r++) {
+            double sum = 0.0;
+            for (int col = 0; col < m; col++) {
+                double a = (i > 0) ? btd_test_entry(0, i, r, col, m) : 0.0;
+                double d = btd_test_entry(1, i, r, col, m);
+                double c = (i < nb - 1) ? btd_test_entry(2, i, r, col, m) : 0.0;
+                bt->A[i * mm + (size_t)r * m + col] = a;
+                bt->D[i * mm + (size_t)r * m + col] = d;
+                bt->C[i * mm + (size_t)r * m + col] = c;
+
+                sum += d * tridiag_test_solution(i * m + col);
+                if (i > 0) sum += a * tridiag_test_solution((i - 1) * m + col);
+                if (i < nb - 1) sum += c * tridiag_test_solution((i + 1) * m + col);
+            }
+            bt->b[(size_t)i * m + r] = sum;
+        }
+    }
+}
+
+/**
+ * Z -= X * Y cho các khối m x m row-major (gộp 4 hàng của Y mỗi lượt)
+ */
+static inline void btd_gemm_sub(int m, const double *X, const double *Y, double *Z) {
+    for (int r = 0; r < m; r++) {
+        const double *x_r = X + (size_t)r * m;
+        double *z_r = Z + (size_t)r * m;
+        int p = 0;
+        for (; p + 3 < m; p += 4) {
+            double l[4] = { -x_r[p], -x_r[p+1], -x_r[p+2], -x_r[p+3] };
+            simd_axpy4(m, l, Y + (size_t)p * m, Y + (size_t)(p+1) * m,
+                       Y + (size_t)(p+2) * m, Y + (size_t)(p+3) * m, z_r);
+        }
+        for (; p < m; p++) {
+            simd_axpy(m, -x_r[p], Y + (size_t)p * m, z_r);
+        }
+    }
+}
+
+/**
+ * z -= X * y cho khối m x m
+ */
+static inline void btd_gemv_sub(int m, const double *X, const double *y, double *z) {
+    for (int r = 0; r < m; r++) {
+        z[r] -= simd_dot(m, X + (size_t)r * m, y);
+    }
+}
+
+/**
+ * Sai số ngược chuẩn hóa của nghiệm bt->x so với hệ test (các khối được tạo
+ * lại từ btd_test_entry vì D, C đã bị ghi đè khi giải)
+ */
+static inline double btd_backward_error(const BlockTridiag *bt) {
+    int nb = bt->nb, m = bt->m;
+    const double *x = bt->x;
+    double norm_a = 0.0, norm_x = 0.0, norm_b = 0.0, norm_r = 0.0;
+
+    for (int i = 0; i < nb; i++) {
+        for (int r = 0; r < m; r++) {
+            size_t row = (size_t)i * m + r;
+            double sum = -bt->b[row];
+            double row_sum = 0.0;
+            for (int col = 0; col < m; col++) {
+                double d = btd_test_entry(1, i, r, col, m);
+                sum += d * x[(size_t)i * m + col];
+                row_sum += fabs(d);
+                if (i > 0) {
+                    double a = btd_test_entry(0, i, r, col, m);
+                    sum += a * x[(size_t)(i - 1) * m + col];
+                    row_sum += fabs(a);
+                }
+                if (i < nb - 1) {
+                    double c = btd_test_entry(2, i, r, col, m);
+                    sum += c * x[(size_t)(i + 1) * m + col];
+                    row_sum += fabs(c);
+                }
+            }
+            if (row_sum > norm_a) norm_a = row_sum;
+            if (fabs(x[row]) > norm_x) norm_x = fabs(x[row]);
+            if (fabs(bt->b[row]) > norm_b) norm_b = fabs(bt->b[row]);
+            if (fabs(sum) > norm_r) norm_r = fabs(sum);
+        }
+    }
+    return norm_r / (norm_a * norm_x + norm_b);
+}
+
+#endif /* GAUSS_TRIDIAG_H */
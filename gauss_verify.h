@@ -0,0 +1,178 @@
+/**
+ * GAUSS VERIFY - KIỂM TRA NGHIỆM TRÊN HỆ GỐC
+ * LU ghi đè A và b tại chỗ nên nghiệm được kiểm tra trên một nguồn gốc
+ * riêng (VerifySource): hệ test sinh lại phần tử theo công thức đóng (không
+ * tốn bộ nhớ), hệ --input map file thêm một lần (bản map của hệ là
+ * MAP_PRIVATE nên file không đổi), hệ .mtx giữ bản sao A.
+ *
+ * Sai số ngược chuẩn vô cùng ||b - A*x|| / (||A|| * ||x|| + ||b||) được tính
+ * trong một lượt đọc A: khối VERIFY_ROWS hàng x VERIFY_COLS cột qua
+ * simd_gemv4 (tích và tổng |a| của hàng cùng lúc). verify_rows xử lý một dải
+ * hàng nên backend chia dải cho luồng rồi gộp bằng verify_norms_merge.
+ */
+
+#ifndef GAUSS_VERIFY_H
+#define GAUSS_VERIFY_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gauss_simd.h"
+#include "gauss_io.h"
+
+// Số hàng mỗi lần gọi simd_gemv4
+#define VERIFY_ROWS 4
+
+// Độ rộng khối cột: khối A sinh lại (VERIFY_ROWS x VERIFY_COLS) nằm trong L1
+#define VERIFY_COLS 512
+
+// Nguồn phần tử gốc của hệ
+typedef struct {
+    int n;
+    const double *A;    // A gốc, hàng i ở A + i * lda; NULL: sinh lại hệ test
+    size_t lda;
+    double *b;          // Bản sao b gốc
+    double *copy;       // A gốc do nguồn giữ (hệ .mtx)
+    GaussFile file;     // File --input map lần thứ hai
+} VerifySource;
+
+// Các chuẩn gộp được giữa các dải hàng
+typedef struct {
+    double norm_r;      // max |b_i - (A*x)_i|
+    double norm_a;      // max tổng |a_ij| trên một hàng
+} VerifyNorms;
+
+/**
+ * Phần tử (i, j) của ma trận test dominant diagonal
+ */
+static inline double verify_test_entry(int n, int i, int j) {
+    if (i == j) {
+        return n + 10.0;            // Đường chéo chính lớn (đảm bảo khả nghịch)
+    }
+    return 1.0 / (i + j + 1.0);     // Phần tử khác nhỏ
+}
+
+/**
+ * Các phần tử j0 .. j0+len-1 của hàng i ma trận test (vòng chia không rẽ
+ * nhánh để compiler vector hoá, đường chéo gán lại sau)
+ */
+static inline void verify_test_row(int n, int i, int j0, int len, double *row) {
+    for (int c = 0; c < len; c++) {
+        row[c] = 1.0 / (i + j0 + c + 1.0);
+    }
+    if (i >= j0 && i < j0 + len) {
+        row[i - j0] = n + 10.0;
+    }
+}
+
+/**
+ * Lấy nguồn gốc trước khi LU ghi đè hệ (A hàng i ở A + i * lda, b): path !=
+ * NULL map lại file --input, keep_copy giữ bản sao A, ngược lại là hệ test.
+ * Trả về 0 nếu hết bộ nhớ hoặc không map được file.
+ */
+static inline int verify_source_open(VerifySource *src, int n, const double *A, size_t lda,
+                                     const double *b, const char *path, int keep_copy) {
+    memset(src, 0, sizeof(*src));
+    src->n = n;
+    src->b = malloc((size_t)n * sizeof(double));
+    if (!src->b) {
+        return 0;
+    }
+    memcpy(src->b, b, (size_t)n * sizeof(double));
+
+    if (path) {
+        if (gauss_io_map(path, &src->file) != GAUSS_IO_OK) {
+            return 0;
+        }
+        src->A = src->file.A;
+        src->lda = src->file.hdr.lda;
+    } else if (keep_copy) {
+        src->copy = malloc((size_t)n * n * sizeof(double));
+        if (!src->copy) {
+            return 0;
+        }
+        for (int i = 0; i < n; i++) {
+            memcpy(src->copy + (size_t)i * n, A + (size_t)i * lda, (size_t)n * sizeof(double));
+        }
+        src->A = src->copy;
+        src->lda = n;
+    }
+    return 1;
+}
+
+static inline void verify_source_free(VerifySource *src) {
+    free(src->b);
+    free(src->copy);
+    if (src->file.map) {
+        gauss_io_unmap(&src->file);
+    }
+}
+
+static inline void verify_norms_init(VerifyNorms *acc) {
+    acc->norm_r = 0.0;
+    acc->norm_a = 0.0;
+}
+
+static inline void verify_norms_merge(VerifyNorms *acc, const VerifyNorms *part) {
+    if (!(part->norm_r <= acc->norm_r)) acc->norm_r = part->norm_r;
+    if (part->norm_a > acc->norm_a) acc->norm_a = part->norm_a;
+}
+
+/**
+ * Gộp một hàng: ax = (A*x)_i, row_abs = tổng |a_ij| của hàng (NaN trong
+ * nghiệm được giữ lại để kiểm tra thất bại)
+ */
+static inline void verify_norms_row(VerifyNorms *acc, double b, double ax, double row_abs) {
+    double r = fabs(b - ax);
+    if (!(r <= acc->norm_r)) acc->norm_r = r;
+    if (row_abs > acc->norm_a) acc->norm_a = row_abs;
+}
+
+/**
+ * Cộng dồn chuẩn của các hàng [i0, i1) vào acc
+ */
+static inline void verify_rows(const VerifySource *src, const double *x, int i0, int i1,
+                               VerifyNorms *acc) {
+    int n = src->n;
+    _Alignas(64) double buf[VERIFY_ROWS][VERIFY_COLS];
+    const double *a[VERIFY_ROWS];
+
+    for (int i = i0; i < i1; i += VERIFY_ROWS) {
+        int rows = (i + VERIFY_ROWS <= i1) ? VERIFY_ROWS : i1 - i;
+        double d[VERIFY_ROWS] = {0.0}, s[VERIFY_ROWS] = {0.0};
+
+        for (int j0 = 0; j0 < n; j0 += VERIFY_COLS) {
+            int len = (j0 + VERIFY_COLS <= n) ? VERIFY_COLS : n - j0;
+            for (int r = 0; r < VERIFY_ROWS; r++) {
+                if (r >= rows) {
+                    a[r] = a[0];    // Hàng đệm, kết quả bỏ đi
+                } else if (src->A) {
+                    a[r] = src->A + (size_t)(i + r) * src->lda + j0;
+                } else {
+                    verify_test_row(n, i + r, j0, len, buf[r]);
+                    a[r] = buf[r];
+                }
+            }
+            simd_gemv4(len, a[0], a[1], a[2], a[3], x + j0, d, s);
+        }
+        for (int r = 0; r < rows; r++) {
+            verify_norms_row(acc, src->b[i + r], d[r], s[r]);
+        }
+    }
+}
+
+/**
+ * Sai số ngược chuẩn vô cùng từ các chuẩn đã gộp
+ */
+static inline double verify_backward_error(const VerifyNorms *acc, int n, const double *x,
+                                           const double *b) {
+    double norm_x = 0.0, norm_b = 0.0;
+    for (int i = 0; i < n; i++) {
+        if (fabs(x[i]) > norm_x) norm_x = fabs(x[i]);
+        if (fabs(b[i]) > norm_b) norm_b = fabs(b[i]);
+    }
+    double denom = acc->norm_a * norm_x + norm_b;
+    return (denom > 0.0) ? acc->norm_r / denom : acc->norm_r;
+}
+
+#endif /* GAUSS_VERIFY_H */
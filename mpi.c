@@ -1,392 +1,406 @@
 /**
  * GAUSSIAN ELIMINATION - PHIÊN BẢN MPI
  * Giải hệ phương trình tuyến tính với distributed memory parallelism
+ * Chương trình chỉ đọc tham số và in kết quả; phần tính toán là engine MPI
+ * của libgauss (gauss_mpi.c)
  */
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
-#include <mpi.h>
+#include <string.h>
+#include "gauss_mpi.h"
 
-// Cấu trúc lưu trữ hệ phương trình
-typedef struct {
-    double **A;     // Ma trận hệ số n x n
-    double *b;      // Vector hằng số
-    double *x;      // Vector nghiệm
-    int n;          // Kích thước ma trận
-} LinearSystem;
 
 /**
- * Tạo hệ phương trình mới với kích thước n x n
+ * In lưới process và phần ma trận của từng process
  */
-LinearSystem* create_system(int n) {
-    LinearSystem *sys = malloc(sizeof(LinearSystem));
-    sys->n = n;
-    
-    sys->A = malloc(n * sizeof(double*));
-    for (int i = 0; i < n; i++) {
-        sys->A[i] = malloc(n * sizeof(double));
+static void print_distribution(int n, int nb, ProcessGrid *grid) {
+    printf("Phân phối công việc (lưới %d x %d, khối %d x %d block-cyclic):\n",
+           grid->P, grid->Q, nb, nb);
+    for (int r = 0; r < grid->size; r++) {
+        int prow = r / grid->Q;
+        int pcol = r % grid->Q;
+        int rows = local_index(n, nb, grid->P, prow);
+        int cols = local_index(n, nb, grid->Q, pcol);
+        printf("  Process %d (%d, %d): %d hàng x %d cột\n", r, prow, pcol, rows, cols);
     }
-    
-    sys->b = malloc(n * sizeof(double));
-    sys->x = malloc(n * sizeof(double));
-    
-    return sys;
-}
-
-/**
- * Giải phóng bộ nhớ
- */
-void free_system(LinearSystem *sys) {
-    if (!sys) return;
-    
-    for (int i = 0; i < sys->n; i++) {
-        free(sys->A[i]);
-    }
-    free(sys->A);
-    free(sys->b);
-    free(sys->x);
-    free(sys);
+    printf("\n");
 }
 
 /**
- * Tạo hệ phương trình test với ma trận dominant diagonal
+ * In ma trận (chỉ khi n <= 10). Gọi trên mọi process: các phần sở hữu được
+ * cộng dồn về process 0 để in.
  */
-void generate_test_system(LinearSystem *sys) {
+void print_matrix(LinearSystem *sys) {
     int n = sys->n;
+    if (n > 10) return;
     
-    // Tạo ma trận A với đường chéo chính lớn (đảm bảo khả nghịch)
+    double full[100] = {0};
     for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            if (i == j) {
-                sys->A[i][j] = n + 10.0;  // Đường chéo chính lớn
-            } else {
-                sys->A[i][j] = 1.0 / (i + j + 1.0);  // Phần tử khác nhỏ
-            }
+        if (!row_owned(sys, i)) {
+            continue;
+        }
+        for (int c = 0; c < sys->local_cols; c++) {
+            int j = global_index(c, sys->nb, sys->grid->Q, sys->grid->pcol);
+            full[i * n + j] = row_ptr(sys, i)[c];
         }
     }
+    MPI_Reduce(sys->grid->rank == 0 ? MPI_IN_PLACE : full, full, n * n, MPI_DOUBLE, MPI_SUM,
+               0, MPI_COMM_WORLD);
+    if (sys->grid->rank != 0) return;
     
-    // Tạo vector nghiệm x cố định: x[i] = i + 1
-    double *true_x = malloc(n * sizeof(double));
-    for (int i = 0; i < n; i++) {
-        true_x[i] = i + 1.0;
-    }
-    
-    // Tính b = A * x
+    printf("Ma trận A:\n");
     for (int i = 0; i < n; i++) {
-        sys->b[i] = 0.0;
         for (int j = 0; j < n; j++) {
-            sys->b[i] += sys->A[i][j] * true_x[j];
+            printf("%8.2f ", full[i * n + j]);
         }
+        printf("\n");
     }
-    
-    free(true_x);
 }
 
 /**
- * Kiểm tra tính đúng đắn nghiệm bằng cách tính A*x so với b
+ * In vector (chỉ khi n <= 10)
  */
-int verify_solution(LinearSystem *sys) {
-    int n = sys->n;
-    double tolerance = 1e-9;
-    double max_error = 0.0;
-    int error_count = 0;
+void print_vector(double *v, int n, const char *name) {
+    if (n > 10) return;
     
+    printf("%s: ", name);
     for (int i = 0; i < n; i++) {
-        double sum = 0.0;
-        for (int j = 0; j < n; j++) {
-            sum += sys->A[i][j] * sys->x[j];
-        }
-        
-        double error = fabs(sum - sys->b[i]);
-        if (error > max_error) {
-            max_error = error;
+        printf("%.2f ", v[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * In thời gian broadcast pivot/panel L: tổng thời gian đang bay, phần lộ ra
+ * (process phải chặn chờ) và phần được che bởi tính toán; per_step = 1 in
+ * thêm từng bước
+ */
+void print_timing(StepTiming *timing, int per_step) {
+    double factor = 0.0, in_flight = 0.0, exposed = 0.0, hidden_total = 0.0;
+    if (per_step) {
+        printf("\n     Bước    Panel (s)      Bay (s)    Lộ ra (s)     Che được\n");
+    }
+    for (int s = 0; s < timing->steps; s++) {
+        double hidden = timing->in_flight[s] - timing->exposed[s];
+        if (hidden < 0.0) {
+            hidden = 0.0;
         }
-        
-        if (error > tolerance) {
-            error_count++;
+        if (per_step) {
+            printf("   %6d %12.6f %12.6f %12.6f %12.6f\n", s, timing->factor[s],
+                   timing->in_flight[s], timing->exposed[s], hidden);
         }
+        factor += timing->factor[s];
+        in_flight += timing->in_flight[s];
+        exposed += timing->exposed[s];
+        hidden_total += hidden;
     }
-    
-    // Adaptive tolerance cho ma trận lớn
-    double adaptive_tolerance = (n > 2000) ? 1e-6 : tolerance;
-    
-    if (n > 2000 && max_error <= adaptive_tolerance) {
-        return 1;  // Pass với adaptive tolerance
-    }
-    
-    return (error_count == 0) ? 1 : 0;
+    printf("   - Phân tích panel: %.6f giây\n", factor);
+    printf("   - Broadcast panel: %.6f giây đang bay, %.6f giây chờ, %.6f giây che được (%.1f%%)\n",
+           in_flight, exposed, hidden_total, in_flight > 0.0 ? 100.0 * hidden_total / in_flight : 0.0);
 }
 
 /**
- * Thuật toán Gaussian Elimination sử dụng MPI
- * Phân phối hàng cho các processes
+ * Chế độ --tridiag: hệ test ba đường chéo n hàng chia đều theo process, mỗi
+ * process tự sinh phần của mình
  */
-int gaussian_elimination_mpi(LinearSystem *sys, int rank, int size) {
-    int n = sys->n;
-    double **A = sys->A;
-    double *b = sys->b;
-    double *x = sys->x;
-    
-    // Tính toán phân phối hàng
-    int rows_per_proc = n / size;
-    int extra_rows = n % size;
-    int start_row = rank * rows_per_proc + (rank < extra_rows ? rank : extra_rows);
-    int local_rows = rows_per_proc + (rank < extra_rows ? 1 : 0);
-    int end_row = start_row + local_rows;
+int run_tridiag(int n) {
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
     
-    if (rank == 0) {
-        printf("Phân phối công việc:\n");
-        for (int i = 0; i < size; i++) {
-            int proc_start = i * rows_per_proc + (i < extra_rows ? i : extra_rows);
-            int proc_rows = rows_per_proc + (i < extra_rows ? 1 : 0);
-            printf("  Process %d: hàng %d - %d (%d hàng)\n", 
-                   i, proc_start, proc_start + proc_rows - 1, proc_rows);
-        }
-        printf("\n");
+    // n nhỏ so với số process: chia ít phần hơn (mỗi phần >= TRIDIAG_MIN_ROWS
+    // hàng), chỉ đủ một phần thì process 0 giải Thomas tuần tự; các process
+    // thừa đứng ngoài comm
+    int parts = (size < n / TRIDIAG_MIN_ROWS) ? size : n / TRIDIAG_MIN_ROWS;
+    if (parts < 2) {
+        parts = 1;
     }
-    
-    // Buffer để lưu trữ hàng pivot
-    double *pivot_row = malloc((n + 1) * sizeof(double));
-    
-    // Giai đoạn 1: Khử xuôi
-    for (int k = 0; k < n - 1; k++) {
-        int global_pivot_row = k;
-        int pivot_owner = -1;
-        
-        // Xác định process nào sở hữu hàng k
-        for (int i = 0; i < size; i++) {
-            int proc_start = i * rows_per_proc + (i < extra_rows ? i : extra_rows);
-            int proc_rows = rows_per_proc + (i < extra_rows ? 1 : 0);
-            if (k >= proc_start && k < proc_start + proc_rows) {
-                pivot_owner = i;
-                break;
-            }
+    MPI_Comm comm;
+    MPI_Comm_split(MPI_COMM_WORLD, (rank < parts) ? 0 : MPI_UNDEFINED, rank, &comm);
+    
+    int success = 0;
+    if (comm != MPI_COMM_NULL) {
+        int begin = (int)((long long)n * rank / parts);
+        int end = (int)((long long)n * (rank + 1) / parts);
+        TridiagSystem *ts = tridiag_create(end - begin);
+        if (!ts) {
+            printf("Lỗi: Process %d không đủ bộ nhớ cho %d hàng\n", rank, end - begin);
+            MPI_Abort(MPI_COMM_WORLD, 1);
         }
+        tridiag_fill_test(ts, begin, end, n);
         
-        // Tìm pivot lớn nhất
-        double local_pivot_value = -1.0;
-        int local_pivot_row = k;
-        
-        // Mỗi process tìm pivot trong phần của mình
-        for (int i = start_row; i < end_row; i++) {
-            if (i >= k && fabs(A[i][k]) > local_pivot_value) {
-                local_pivot_value = fabs(A[i][k]);
-                local_pivot_row = i;
+        if (rank == 0) {
+            printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN MPI (BA ĐƯỜNG CHÉO)\n");
+            printf("Số hàng: %d\n", n);
+            if (parts > 1) {
+                printf("Số processes: %d (hệ rút gọn %d ẩn)\n", parts, 2 * parts);
+            } else {
+                printf("Số processes: 1 (Thomas tuần tự)\n");
             }
-        }
-        
-        // Thu thập thông tin pivot từ tất cả processes
-        struct {
-            double value;
-            int rank;
-        } local_max, global_max;
-        
-        local_max.value = local_pivot_value;
-        local_max.rank = rank;
-        
-        MPI_Allreduce(&local_max, &global_max, 1, MPI_DOUBLE_INT, MPI_MAXLOC, MPI_COMM_WORLD);
-        
-        // Process có pivot lớn nhất broadcast hàng pivot
-        if (rank == global_max.rank) {
-            // Copy hàng pivot vào buffer
-            for (int j = 0; j < n; j++) {
-                pivot_row[j] = A[local_pivot_row][j];
+            if (parts < size) {
+                printf("⚠️  n quá nhỏ cho %d processes (cần %d hàng mỗi process): %d process đứng ngoài\n",
+                       size, TRIDIAG_MIN_ROWS, size - parts);
             }
-            pivot_row[n] = b[local_pivot_row];  // Thêm phần tử từ vector b
-            global_pivot_row = local_pivot_row;
+            printf("📏 Bộ nhớ mỗi process: %.1f MB\n\n", 7.0 * (end - begin) * sizeof(double) / 1e6);
         }
         
-        // Broadcast thông tin pivot
-        MPI_Bcast(&global_pivot_row, 1, MPI_INT, global_max.rank, MPI_COMM_WORLD);
-        MPI_Bcast(pivot_row, n + 1, MPI_DOUBLE, global_max.rank, MPI_COMM_WORLD);
+        MPI_Barrier(comm);
+        double start_time = MPI_Wtime();
+        success = (parts > 1) ? tridiag_solve_mpi(ts, comm) : tridiag_thomas(ts);
+        double elapsed_time = MPI_Wtime() - start_time;
+        MPI_Allreduce(MPI_IN_PLACE, &elapsed_time, 1, MPI_DOUBLE, MPI_MAX, comm);
         
-        // Kiểm tra tính khả nghịch
-        if (fabs(pivot_row[k]) < 1e-12) {
-            if (rank == 0) {
-                printf("Lỗi: Ma trận không khả nghịch (pivot ≈ 0)\n");
-            }
-            free(pivot_row);
-            return 0;
-        }
-        
-        // Hoán đổi hàng thông minh: swap giữa processes
-        if (global_pivot_row != k) {
-            if (rank == pivot_owner) {
-                // Process owns hàng k: gửi hàng k cho process có pivot
-                if (k >= start_row && k < end_row) {
-                    MPI_Send(A[k], n, MPI_DOUBLE, global_max.rank, k, MPI_COMM_WORLD);
-                    MPI_Send(&b[k], 1, MPI_DOUBLE, global_max.rank, k + n, MPI_COMM_WORLD);
-                }
-            }
-            
-            if (rank == global_max.rank && rank != pivot_owner) {
-                // Process có pivot: nhận hàng k và thay thế
-                double *temp_row = malloc(n * sizeof(double));
-                double temp_b;
-                MPI_Recv(temp_row, n, MPI_DOUBLE, pivot_owner, k, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                MPI_Recv(&temp_b, 1, MPI_DOUBLE, pivot_owner, k + n, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                
-                // Swap trong local storage
-                if (global_pivot_row >= start_row && global_pivot_row < end_row) {
-                    for (int j = 0; j < n; j++) {
-                        A[global_pivot_row][j] = temp_row[j];
-                    }
-                    b[global_pivot_row] = temp_b;
-                }
-                free(temp_row);
-            }
-            
-            // Process owns hàng k: nhận pivot row
-            if (rank == pivot_owner && k >= start_row && k < end_row) {
-                for (int j = 0; j < n; j++) {
-                    A[k][j] = pivot_row[j];
-                }
-                b[k] = pivot_row[n];
-            }
+        double error = 0.0;
+        if (success) {
+            error = (parts > 1) ? tridiag_backward_error_mpi(ts, comm) : tridiag_backward_error(ts);
         }
-        
-        // Thực hiện khử trong phần của mình
-        for (int i = start_row; i < end_row; i++) {
-            if (i > k) {
-                double factor = A[i][k] / pivot_row[k];
-                
-                for (int j = k; j < n; j++) {
-                    A[i][j] -= factor * pivot_row[j];
-                }
-                b[i] -= factor * pivot_row[n];
-            }
+        if (error >= 1e-10) {
+            success = 0;
         }
-        
-        // Đồng bộ hóa
-        MPI_Barrier(MPI_COMM_WORLD);
-    }
-    
-    // Thu thập ma trận về process 0 để thực hiện backward substitution
-    if (rank == 0) {
-        // Nhận dữ liệu từ các process khác
-        for (int proc = 1; proc < size; proc++) {
-            int proc_start = proc * rows_per_proc + (proc < extra_rows ? proc : extra_rows);
-            int proc_rows = rows_per_proc + (proc < extra_rows ? 1 : 0);
-            
-            for (int i = 0; i < proc_rows; i++) {
-                MPI_Recv(A[proc_start + i], n, MPI_DOUBLE, proc, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                MPI_Recv(&b[proc_start + i], 1, MPI_DOUBLE, proc, i + n, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        if (rank == 0) {
+            if (success) {
+                printf("✅ Giải thành công!\n");
+                printf("⏱️  Thời gian thực hiện: %.6f giây (%.1f triệu hàng/giây)\n",
+                       elapsed_time, n / elapsed_time / 1e6);
+                printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+            } else if (error >= 1e-10) {
+                printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            } else {
+                printf("❌ Không thể giải hệ phương trình! (pivot ≈ 0)\n");
             }
         }
         
-        // Thực hiện backward substitution
-        for (int i = n - 1; i >= 0; i--) {
-            x[i] = b[i];
-            
-            for (int j = i + 1; j < n; j++) {
-                x[i] -= A[i][j] * x[j];
-            }
-            
-            x[i] /= A[i][i];
-        }
-    } else {
-        // Gửi dữ liệu về process 0
-        for (int i = 0; i < local_rows; i++) {
-            MPI_Send(A[start_row + i], n, MPI_DOUBLE, 0, i, MPI_COMM_WORLD);
-            MPI_Send(&b[start_row + i], 1, MPI_DOUBLE, 0, i + n, MPI_COMM_WORLD);
-        }
-    }
-    
-    // Broadcast nghiệm về tất cả processes
-    MPI_Bcast(x, n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-    
-    free(pivot_row);
-    return 1;
-}
-
-/**
- * In ma trận (chỉ khi n <= 10)
- */
-void print_matrix(LinearSystem *sys) {
-    int n = sys->n;
-    if (n > 10) return;
-    
-    printf("Ma trận A:\n");
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            printf("%8.2f ", sys->A[i][j]);
-        }
-        printf("\n");
+        tridiag_free(ts);
+        MPI_Comm_free(&comm);
     }
-}
-
-/**
- * In vector (chỉ khi n <= 10)
- */
-void print_vector(double *v, int n, const char *name) {
-    if (n > 10) return;
     
-    printf("%s: ", name);
-    for (int i = 0; i < n; i++) {
-        printf("%.2f ", v[i]);
-    }
-    printf("\n");
+    // Process đứng ngoài nhận kết quả chung để mã thoát thống nhất
+    MPI_Bcast(&success, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    return success;
 }
-
 /**
  * Chương trình chính
  */
 int main(int argc, char *argv[]) {
     int rank, size;
     int n = 100; // Kích thước mặc định
+    int block_size = DEFAULT_BLOCK_SIZE;
+    int grid_p = 0, grid_q = 0;     // 0: tự chọn lưới gần vuông
+    int scatter = 0;                // 1: process 0 tạo toàn bộ rồi gửi phần từng process (scatter_system)
+    int lookahead = 1;              // 1: chồng broadcast panel kế với cập nhật
+    int show_steps = 0;             // 1: in thời gian từng bước
+    int num_rhs = 0;                // Số vế phải giải thêm với cùng LU
+    int tridiag = 0;                // 1: hệ ba đường chéo n hàng chia theo process
+    const char *input_path = NULL;  // File hệ nhị phân (gauss_io.h) thay cho hệ test
+    const char *output_path = NULL; // File ghi nghiệm (process 0)
     
     // Khởi tạo MPI
     MPI_Init(&argc, &argv);
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     MPI_Comm_size(MPI_COMM_WORLD, &size);
     
-    if (argc > 1) {
-        n = atoi(argv[1]);
-        if (n <= 0) {
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--block") == 0 && a + 1 < argc) {
+            block_size = atoi(argv[++a]);
+            if (block_size <= 0) {
+                if (rank == 0) {
+                    printf("Kích thước khối phải > 0\n");
+                }
+                MPI_Finalize();
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--grid") == 0 && a + 1 < argc) {
+            a++;
+            if (sscanf(argv[a], "%dx%d", &grid_p, &grid_q) != 2 ||
+                grid_p <= 0 || grid_q <= 0 || grid_p * grid_q != size) {
+                if (rank == 0) {
+                    printf("Lưới không hợp lệ: %s (cần PxQ với P*Q = %d)\n", argv[a], size);
+                }
+                MPI_Finalize();
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--scatter") == 0) {
+            scatter = 1;
+        } else if (strcmp(argv[a], "--lookahead") == 0 && a + 1 < argc) {
+            lookahead = atoi(argv[++a]) != 0;
+        } else if (strcmp(argv[a], "--timing") == 0) {
+            show_steps = 1;
+        } else if (strcmp(argv[a], "--rhs") == 0 && a + 1 < argc) {
+            num_rhs = atoi(argv[++a]);
+            if (num_rhs < 0) {
+                if (rank == 0) {
+                    printf("Số vế phải phải >= 0\n");
+                }
+                MPI_Finalize();
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--tridiag") == 0) {
+            tridiag = 1;
+        } else if (strcmp(argv[a], "--input") == 0 && a + 1 < argc) {
+            input_path = argv[++a];
+        } else if (strcmp(argv[a], "--output") == 0 && a + 1 < argc) {
+            output_path = argv[++a];
+        } else if (argv[a][0] == '-') {
             if (rank == 0) {
-                printf("Kích thước ma trận phải > 0\n");
+                printf("Tham số không hợp lệ: %s\n", argv[a]);
+                printf("Dùng: mpirun -np N %s [n] [--grid PxQ] [--block nb] [--scatter]\n"
+                       "          [--lookahead 0|1] [--timing] [--rhs k] [--tridiag]\n"
+                       "          [--input file] [--output file]\n", argv[0]);
             }
             MPI_Finalize();
             return 1;
+        } else {
+            n = atoi(argv[a]);
+            if (n <= 0) {
+                if (rank == 0) {
+                    printf("Kích thước ma trận phải > 0\n");
+                }
+                MPI_Finalize();
+                return 1;
+            }
         }
     }
     
+    if (tridiag && input_path) {
+        if (rank == 0) {
+            printf("--input chỉ dùng cho hệ dense (không kết hợp --tridiag)\n");
+        }
+        MPI_Finalize();
+        return 1;
+    }
+    
+    if (tridiag) {
+        // Không cần lưới 2D: mỗi process giữ một dải hàng liên tiếp
+        int success = run_tridiag(n);
+        MPI_Finalize();
+        return success ? 0 : 1;
+    }
+    
+    // Hệ từ file: mọi process map cùng file, n lấy từ header
+    GaussFile input;
+    memset(&input, 0, sizeof(input));
+    if (input_path) {
+        int rc = gauss_io_map(input_path, &input);
+        uint32_t need = GAUSS_IO_HAS_A | GAUSS_IO_HAS_B;
+        if (rc == GAUSS_IO_OK &&
+            ((input.hdr.flags & need) != need || (input.hdr.flags & GAUSS_IO_FACTORED))) {
+            gauss_io_unmap(&input);
+            rc = GAUSS_IO_EFORMAT;
+        }
+        int all_ok = (rc == GAUSS_IO_OK);
+        MPI_Allreduce(MPI_IN_PLACE, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+        if (!all_ok) {
+            if (rc != GAUSS_IO_OK) {
+                printf("Lỗi: Process %d không nạp được %s: %s\n", rank, input_path, gauss_io_strerror(rc));
+            }
+            gauss_io_unmap(&input);
+            MPI_Finalize();
+            return 1;
+        }
+        n = (int)input.hdr.n;
+    }
+    
+    if (grid_p == 0) {
+        grid_default_shape(size, &grid_p, &grid_q);
+    }
+    ProcessGrid grid;
+    grid_init(&grid, grid_p, grid_q);
+    
     if (rank == 0) {
         printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN MPI\n");
         printf("Kích thước ma trận: %d x %d\n", n, n);
-        printf("Số processes: %d\n\n", size);
+        if (input_path) {
+            printf("Đầu vào: %s (mỗi process map file, chép phần sở hữu)\n", input_path);
+        }
+        printf("Số processes: %d\n", size);
+        printf("Kernel SIMD: %s\n\n", simd_kernels.name);
     }
     
-    // Tạo hệ phương trình (mỗi process tạo bản sao)
-    LinearSystem *sys = create_system(n);
+    // Mỗi process chỉ cấp phát các khối nó sở hữu
+    LinearSystem *sys = create_system_mpi(n, &grid, block_size);
+    if (!sys) {
+        printf("Lỗi: Process %d không đủ bộ nhớ cho phần ma trận của mình\n", rank);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
     
-    // Chỉ process 0 tạo dữ liệu test
-    if (rank == 0) {
-        generate_test_system(sys);
-        
-        // Hiển thị ma trận nếu nhỏ
-        if (n <= 10) {
-            print_matrix(sys);
+    if (input_path) {
+        load_system(sys, input.A, input.hdr.lda, input.b);
+        gauss_io_unmap(&input);
+    } else if (scatter) {
+        // Dữ liệu tập trung ở process 0 (như khi đọc từ file), phân phối một lần
+        double *full_A = NULL, *full_b = NULL;
+        if (rank == 0) {
+            full_A = malloc((size_t)n * n * sizeof(double));
+            full_b = malloc(n * sizeof(double));
+            if (!full_A || !full_b) {
+                printf("Lỗi: Process 0 không đủ bộ nhớ cho ma trận %d x %d\n", n, n);
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            }
+            for (int i = 0; i < n; i++) {
+                full_b[i] = 0.0;
+                for (int j = 0; j < n; j++) {
+                    full_A[(size_t)i * n + j] = verify_test_entry(n, i, j);
+                    full_b[i] += full_A[(size_t)i * n + j] * (j + 1.0);
+                }
+            }
+        }
+        scatter_system(sys, full_A, full_b);
+        free(full_A);
+        free(full_b);
+    } else {
+        // Mỗi process tự sinh phần của mình, b tính bằng tích phân tán
+        generate_test_system_mpi(sys);
+    }
+    
+    // Hiển thị ma trận nếu nhỏ
+    if (n <= 10) {
+        print_matrix(sys);
+        if (rank == 0) {
             print_vector(sys->b, n, "Vector b");
             printf("\n");
         }
     }
     
-    // Broadcast ma trận và vector b từ process 0 đến tất cả
-    for (int i = 0; i < n; i++) {
-        MPI_Bcast(sys->A[i], n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    // Nguồn kiểm tra nghiệm, lấy trước khi LU ghi đè A và b: hệ test sinh lại
+    // phần tử, hệ --input map lại file
+    VerifySource verify;
+    int verify_ok = verify_source_open(&verify, n, NULL, 0, sys->b, input_path, 0);
+    MPI_Allreduce(MPI_IN_PLACE, &verify_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (!verify_ok) {
+        printf("Lỗi: Process %d không giữ được hệ gốc để kiểm tra nghiệm\n", rank);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    
+    double *extra_rhs = (num_rhs > 0) ? generate_extra_rhs_mpi(sys, num_rhs) : NULL;
+    
+    if (rank == 0) {
+        print_distribution(n, block_size, &grid);
     }
-    MPI_Bcast(sys->b, n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
     
     // Đo thời gian (sử dụng MPI timer)
     double start_time = MPI_Wtime();
     
-    int success = gaussian_elimination_mpi(sys, rank, size);
+    StepTiming timing;
+    timing_init(&timing, n, block_size);
+    int success = gaussian_elimination_mpi(sys, lookahead, &timing);
     
     double end_time = MPI_Wtime();
     double elapsed_time = end_time - start_time;
     
+    // Kiểm tra nghiệm cần mọi process (mỗi process tính phần hàng/cột của mình)
+    double verify_time = MPI_Wtime();
+    double verify_error = success ? verify_solution_mpi(sys, &verify) : 0.0;
+    verify_time = MPI_Wtime() - verify_time;
+    
+    // Các vế phải thêm dùng lại LU (mọi process cùng tham gia thế phân tán)
+    double extra_error = 0.0, extra_time = 0.0;
+    if (success && num_rhs > 0) {
+        double t = MPI_Wtime();
+        extra_error = solve_extra_rhs_mpi(sys, extra_rhs, num_rhs);
+        extra_time = MPI_Wtime() - t;
+    }
+    
     // Chỉ process 0 in kết quả
     if (rank == 0) {
         if (success) {
@@ -399,16 +413,36 @@ int main(int argc, char *argv[]) {
             }
             
             // Kiểm tra tính đúng đắn của nghiệm
-            if (verify_solution(sys)) {
-                printf("✅ Nghiệm chính xác!\n");
+            if (verify_error < 1e-10) {
+                printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", verify_error);
             } else {
-                printf("❌ Nghiệm không chính xác!\n");
+                printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", verify_error);
+                success = 0;
+            }
+            printf("🔍 Kiểm tra trên hệ gốc: %.6f giây\n", verify_time);
+            
+            if (output_path) {
+                int rc = gauss_io_write(output_path, n, NULL, 0, NULL, NULL, NULL, sys->x);
+                if (rc == GAUSS_IO_OK) {
+                    printf("💾 Đã ghi nghiệm → %s\n", output_path);
+                } else {
+                    printf("❌ Không ghi được %s: %s\n", output_path, gauss_io_strerror(rc));
+                    success = 0;
+                }
+            }
+            
+            if (num_rhs > 0) {
+                printf("🔁 Giải thêm %d vế phải (dùng lại LU): %.6f giây (%.6f giây/lần)\n",
+                       num_rhs, extra_time, extra_time / num_rhs);
+                printf("%s Sai số lớn nhất: %.2e\n", (extra_error < 1e-6) ? "✅" : "❌", extra_error);
             }
             
             // Thông tin về hiệu năng
             printf("\n📊 Thông tin hiệu năng:\n");
             printf("   - Số processes: %d\n", size);
             printf("   - Thời gian: %.6f giây\n", elapsed_time);
+            printf("   - Lookahead: %s\n", lookahead ? "bật" : "tắt");
+            print_timing(&timing, show_steps);
             
         } else {
             printf("❌ Không thể giải hệ phương trình!\n");
@@ -416,10 +450,14 @@ int main(int argc, char *argv[]) {
     }
     
     // Dọn dẹp bộ nhớ
-    free_system(sys);
+    free(extra_rhs);
+    verify_source_free(&verify);
+    timing_free(&timing);
+    free_system_mpi(sys);
+    grid_free(&grid);
     
     // Kết thúc MPI
     MPI_Finalize();
     
     return success ? 0 : 1;
-} 
\ No newline at end of file
+} 
@@ -1,397 +1,826 @@
 /**
  * GAUSSIAN ELIMINATION - PHIÊN BẢN PTHREAD
  * Giải hệ phương trình tuyến tính với manual thread management
+ * Chương trình chỉ đọc tham số và in kết quả; phần tính toán là engine
+ * Pthread của libgauss (gauss_core.c, gauss_pthread.c)
  */
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
+#include <string.h>
+#include <limits.h>
 #include <time.h>
-#include <pthread.h>
+#include "gauss_core.h"
+#include "gauss_driver.h"
 
-// Cấu trúc lưu trữ hệ phương trình
-typedef struct {
-    double **A;     // Ma trận hệ số n x n
-    double *b;      // Vector hằng số
-    double *x;      // Vector nghiệm
-    int n;          // Kích thước ma trận
-} LinearSystem;
 
-// Cấu trúc dữ liệu cho các luồng tìm pivot
-typedef struct {
-    LinearSystem *sys;
-    int start_row;
-    int end_row;
-    int k;              // Cột hiện tại
-    int *pivot_row;     // Kết quả: hàng có pivot max
-    double *pivot_value; // Kết quả: giá trị pivot max
-    pthread_mutex_t *pivot_mutex;
-} PivotThreadData;
-
-// Cấu trúc dữ liệu cho các luồng khử Gauss
-typedef struct {
-    LinearSystem *sys;
-    int start_row;
-    int end_row;
-    int k;              // Bước khử hiện tại
-} EliminationThreadData;
+// Số hệ tối đa khi đo cách lặp giải từng hệ (--batch)
+#define BATCH_BASELINE_MAX 2000
 
 /**
- * Tạo hệ phương trình mới với kích thước n x n
+ * Kiểm tra nghiệm trên hệ gốc và in kết quả. Trả về 0 nếu không chính xác.
  */
-LinearSystem* create_system(int n) {
-    LinearSystem *sys = malloc(sizeof(LinearSystem));
-    sys->n = n;
+int report_solution(const VerifySource *src, const double *x, int num_threads) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    double error = verify_solution_pthread(src, x, num_threads);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     
-    sys->A = malloc(n * sizeof(double*));
-    for (int i = 0; i < n; i++) {
-        sys->A[i] = malloc(n * sizeof(double));
+    if (error < 1e-10) {
+        printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+    } else {
+        printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
     }
-    
-    sys->b = malloc(n * sizeof(double));
-    sys->x = malloc(n * sizeof(double));
-    
-    return sys;
+    printf("🔍 Kiểm tra trên hệ gốc: %.6f giây\n", elapsed);
+    return error < 1e-10;
 }
 
 /**
- * Giải phóng bộ nhớ
+ * Chế độ --batch: giải count hệ n x n bằng bộ giải lô (gauss_batch.h) và so
+ * với cách hiện tại là lặp create_system + giải + free_system cho từng hệ
+ * (đo trên tối đa BATCH_BASELINE_MAX hệ rồi quy ra hệ/giây)
  */
-void free_system(LinearSystem *sys) {
-    if (!sys) return;
+int run_batch(int n, int count, int num_threads, int block_size, int fused_pivot) {
+    BatchSystem *bs = batch_create(n, count);
+    if (!bs) {
+        printf("Lỗi: Không đủ bộ nhớ cho lô %d hệ %d x %d\n", count, n, n);
+        return 0;
+    }
+    batch_fill_test(bs, 0, count);
+    
+    // Dữ liệu cho cách lặp từng hệ, chuẩn bị trước khi đo
+    int loops = (count < BATCH_BASELINE_MAX) ? count : BATCH_BASELINE_MAX;
+    double *base_A = malloc((size_t)loops * n * n * sizeof(double));
+    double *base_b = malloc((size_t)loops * n * sizeof(double));
+    if (!base_A || !base_b) {
+        printf("Lỗi: Không đủ bộ nhớ cho lô %d hệ %d x %d\n", count, n, n);
+        free(base_A);
+        free(base_b);
+        batch_free(bs);
+        return 0;
+    }
+    for (int s = 0; s < loops; s++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                base_A[((size_t)s * n + i) * n + j] = batch_test_entry(s, i, j);
+            }
+            base_b[(size_t)s * n + i] = batch_test_rhs(s, i, n);
+        }
+    }
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    batch_solve_pthread(bs, num_threads);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double batch_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     
-    for (int i = 0; i < sys->n; i++) {
-        free(sys->A[i]);
+    int singular;
+    double max_error = batch_verify_test(bs, &singular);
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int loop_ok = 1;
+    for (int s = 0; s < loops; s++) {
+        LinearSystem *sys = create_system(n);
+        if (!sys) {
+            loop_ok = 0;
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            memcpy(row_ptr(sys, i), base_A + ((size_t)s * n + i) * n, n * sizeof(double));
+        }
+        memcpy(sys->b, base_b + (size_t)s * n, n * sizeof(double));
+        gaussian_elimination_pthread(sys, num_threads, block_size, fused_pivot, NULL);
+        free_system(sys);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double loop_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (!loop_ok) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận %d x %d\n", n, n);
+        free(base_A);
+        free(base_b);
+        batch_free(bs);
+        return 0;
     }
-    free(sys->A);
-    free(sys->b);
-    free(sys->x);
-    free(sys);
+    
+    double batch_rate = count / batch_time;
+    double loop_rate = loops / loop_time;
+    printf("📦 Bộ giải lô: %.6f giây → %.0f hệ/giây\n", batch_time, batch_rate);
+    printf("🔁 Lặp gaussian_elimination_pthread (%d hệ): %.6f giây → %.0f hệ/giây\n",
+           loops, loop_time, loop_rate);
+    printf("⚡ Bộ giải lô nhanh hơn %.1fx\n", batch_rate / loop_rate);
+    printf("%s Sai số ngược lớn nhất: %.2e (%d hệ suy biến)\n",
+           (max_error < 1e-10) ? "✅" : "❌", max_error, singular);
+    
+    free(base_A);
+    free(base_b);
+    batch_free(bs);
+    return max_error < 1e-10;
 }
 
 /**
- * Tạo hệ phương trình test với ma trận dominant diagonal
+ * Chế độ --mixed: giải bằng LU float + tinh chỉnh, sau đó giải lại bằng LU
+ * double trên cùng hệ để so thời gian. Nghiệm hỗn hợp được kiểm tra trên hệ
+ * gốc (src).
  */
-void generate_test_system(LinearSystem *sys) {
+int run_mixed(LinearSystem *sys, const VerifySource *src, int num_threads, int block_size,
+              int fused_pivot) {
     int n = sys->n;
+    int iterations, fallback;
     
-    // Tạo ma trận A với đường chéo chính lớn (đảm bảo khả nghịch)
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            if (i == j) {
-                sys->A[i][j] = n + 10.0;  // Đường chéo chính lớn
-            } else {
-                sys->A[i][j] = 1.0 / (i + j + 1.0);  // Phần tử khác nhỏ
-            }
-        }
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int success = gaussian_elimination_mixed_pthread(sys, num_threads, block_size, fused_pivot,
+                                                     &iterations, &fallback);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double mixed_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (!success) {
+        printf("❌ Không thể giải hệ phương trình!\n");
+        return 0;
     }
     
-    // Tạo vector nghiệm x cố định: x[i] = i + 1
-    double *true_x = malloc(n * sizeof(double));
-    for (int i = 0; i < n; i++) {
-        true_x[i] = i + 1.0;
+    double double_time = 0.0;
+    if (!fallback) {
+        double *x_mixed = malloc(n * sizeof(double));
+        memcpy(x_mixed, sys->x, n * sizeof(double));
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        success = gaussian_elimination_pthread(sys, num_threads, block_size, fused_pivot, NULL);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        
+        memcpy(sys->x, x_mixed, n * sizeof(double));
+        free(x_mixed);
+        if (!success) {
+            printf("❌ LU double thất bại!\n");
+            return 0;
+        }
     }
     
-    // Tính b = A * x
-    for (int i = 0; i < n; i++) {
-        sys->b[i] = 0.0;
-        for (int j = 0; j < n; j++) {
-            sys->b[i] += sys->A[i][j] * true_x[j];
-        }
+    printf("✅ Giải thành công!\n");
+    printf("⏱️  Thời gian thực hiện: %.6f giây\n", mixed_time);
+    
+    if (n <= 10) {
+        print_vector(sys->x, n, "Nghiệm x");
     }
     
-    free(true_x);
+    success = report_solution(src, sys->x, num_threads);
+    
+    if (fallback) {
+        printf("⚠️  Tinh chỉnh float không hội tụ sau %d lần → đã giải lại bằng double\n",
+               iterations);
+    } else {
+        printf("🔬 LU float + %d lần tinh chỉnh double\n", iterations);
+        printf("⚡ LU double: %.6f giây → hỗn hợp nhanh hơn %.2fx\n",
+               double_time, double_time / mixed_time);
+    }
+    return success;
 }
 
 /**
- * Kiểm tra tính đúng đắn nghiệm bằng cách tính A*x so với b
+ * Chế độ --tridiag: hệ test ba đường chéo n hàng, chỉ cấp phát các vector
+ * (đo được cả hệ hàng triệu hàng), kiểm tra bằng sai số ngược
  */
-int verify_solution(LinearSystem *sys) {
-    int n = sys->n;
-    double tolerance = 1e-9;
-    double max_error = 0.0;
-    int error_count = 0;
-    
-    for (int i = 0; i < n; i++) {
-        double sum = 0.0;
-        for (int j = 0; j < n; j++) {
-            sum += sys->A[i][j] * sys->x[j];
-        }
+int run_tridiag(int n, int num_threads) {
+    TridiagSystem *ts = tridiag_create(n);
+    if (!ts) {
+        printf("Lỗi: Không đủ bộ nhớ cho hệ ba đường chéo %d hàng\n", n);
+        return 0;
+    }
+    tridiag_fill_test(ts, 0, n, n);
+    printf("📏 Bộ nhớ: %.1f MB (dense cần %.1f GB)\n\n",
+           7.0 * n * sizeof(double) / 1e6, (double)n * n * sizeof(double) / 1e9);
+    
+    // Thomas tuần tự làm mốc, sau đó giải phân hoạch song song
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int success = tridiag_thomas(ts);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double thomas_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    double thomas_error = success ? tridiag_backward_error(ts) : 0.0;
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    success = success && tridiag_solve_pthread(ts, num_threads);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    if (success) {
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây (%.1f triệu hàng/giây)\n",
+               elapsed_time, n / elapsed_time / 1e6);
+        printf("🐢 Thomas tuần tự: %.6f giây → song song nhanh hơn %.2fx (sai số ngược %.2e)\n",
+               thomas_time, thomas_time / elapsed_time, thomas_error);
         
-        double error = fabs(sum - sys->b[i]);
-        if (error > max_error) {
-            max_error = error;
+        if (n <= 10) {
+            print_vector(ts->x, n, "Nghiệm x");
         }
         
-        if (error > tolerance) {
-            error_count++;
+        double error = tridiag_backward_error(ts);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
         }
+    } else {
+        printf("❌ Không thể giải hệ phương trình! (pivot ≈ 0)\n");
     }
     
-    // Adaptive tolerance cho ma trận lớn
-    double adaptive_tolerance = (n > 2000) ? 1e-6 : tolerance;
-    
-    if (n > 2000 && max_error <= adaptive_tolerance) {
-        return 1;  // Pass với adaptive tolerance
-    }
-    
-    return (error_count == 0) ? 1 : 0;
+    tridiag_free(ts);
+    return success;
 }
 
 /**
- * Hàm tìm pivot lớn nhất trong phạm vi được gán
+ * Chế độ --btd m: hệ test khối ba đường chéo nb khối hàng m x m
  */
-void* find_pivot_thread(void* arg) {
-    PivotThreadData *data = (PivotThreadData*)arg;
-    LinearSystem *sys = data->sys;
-    int k = data->k;
-    
-    int local_max_row = k;
-    double local_max_val = (data->start_row <= k) ? fabs(sys->A[k][k]) : 0.0;
-    
-    // Tìm pivot trong phạm vi được gán
-    for (int i = (data->start_row > k) ? data->start_row : k; i < data->end_row && i < sys->n; i++) {
-        if (fabs(sys->A[i][k]) > local_max_val) {
-            local_max_val = fabs(sys->A[i][k]);
-            local_max_row = i;
+int run_block_tridiag(int nb, int m, int block_size, int num_threads) {
+    BlockTridiag *bt = btd_create(nb, m);
+    if (!bt) {
+        printf("Lỗi: Không đủ bộ nhớ cho hệ khối ba đường chéo %d x %d\n", nb, m);
+        return 0;
+    }
+    btd_fill_test(bt);
+    printf("📏 Bộ nhớ: %.1f MB cho %d khối hàng (dense cần %.1f GB)\n\n",
+           3.0 * nb * m * m * sizeof(double) / 1e6, nb,
+           (double)nb * m * nb * m * sizeof(double) / 1e9);
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int success = block_tridiag_solve_pthread(bt, block_size, num_threads);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    if (success) {
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây\n", elapsed_time);
+        
+        double error = btd_backward_error(bt);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
         }
+    } else {
+        printf("❌ Không thể giải hệ phương trình!\n");
     }
     
-    // Cập nhật pivot toàn cục với mutex
-    pthread_mutex_lock(data->pivot_mutex);
-    if (local_max_val > *(data->pivot_value)) {
-        *(data->pivot_value) = local_max_val;
-        *(data->pivot_row) = local_max_row;
+    btd_free(bt);
+    return success;
+}
+
+/**
+ * Nạp ma trận Matrix Market (gauss_mtx.h) vào hệ dense: các luồng đếm dòng
+ * rồi parse các đoạn của file song song; b = A * x (x[i] = i + 1) như hệ test
+ */
+int load_mtx(LinearSystem *sys, const MtxFile *f, int num_threads) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int ok = mtx_read_pthread(f, sys, NULL, NULL, NULL, num_threads);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (!ok) {
+        printf("Lỗi: Matrix Market %s\n", mtx_strerror(MTX_EPARSE));
+        return 0;
     }
-    pthread_mutex_unlock(data->pivot_mutex);
+    double bytes = (double)(f->size - f->body);
+    printf("📥 Đọc Matrix Market (%d luồng): %.1f MB, %ld phần tử trong %.6f giây (%.2f GB/s)\n",
+           num_threads, bytes / 1e6, f->nnz, elapsed, bytes / elapsed / 1e9);
     
-    return NULL;
+    fill_test_rhs(sys);
+    return 1;
 }
 
 /**
- * Hàm thực hiện khử Gauss trong phạm vi được gán
+ * Nạp file Matrix Market coordinate thành CSR: parse song song vào mảng toạ
+ * độ, gom theo hàng tuần tự. Trả về NULL (đã in lỗi) nếu dữ liệu hỏng hoặc
+ * hết bộ nhớ.
  */
-void* elimination_thread(void* arg) {
-    EliminationThreadData *data = (EliminationThreadData*)arg;
-    LinearSystem *sys = data->sys;
-    int k = data->k;
-    
-    // Thực hiện khử trong phạm vi được gán
-    for (int i = data->start_row; i < data->end_row && i < sys->n; i++) {
-        if (i > k) {  // Chỉ khử các hàng dưới pivot
-            double factor = sys->A[i][k] / sys->A[k][k];
-            
-            // Cập nhật hàng i
-            for (int j = k; j < sys->n; j++) {
-                sys->A[i][j] -= factor * sys->A[k][j];
-            }
-            sys->b[i] -= factor * sys->b[k];
-        }
+SparseMatrix* load_mtx_sparse(const MtxFile *f, int num_threads) {
+    int *rows = malloc(f->nnz * sizeof(int));
+    int *cols = malloc(f->nnz * sizeof(int));
+    double *vals = malloc(f->nnz * sizeof(double));
+    if (!rows || !cols || !vals) {
+        printf("Lỗi: Không đủ bộ nhớ cho %ld phần tử\n", f->nnz);
+        free(rows);
+        free(cols);
+        free(vals);
+        return NULL;
     }
     
-    return NULL;
+    struct timespec t0, t1, t2;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int ok = mtx_read_pthread(f, NULL, rows, cols, vals, num_threads);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    SparseMatrix *A = ok ? mtx_coo_to_csr(f, rows, cols, vals) : NULL;
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    free(rows);
+    free(cols);
+    free(vals);
+    
+    if (!ok) {
+        printf("Lỗi: Matrix Market %s\n", mtx_strerror(MTX_EPARSE));
+        return NULL;
+    }
+    if (!A) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận CSR\n");
+        return NULL;
+    }
+    double parse_time = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    double bytes = (double)(f->size - f->body);
+    printf("📥 Đọc Matrix Market (%d luồng): %.1f MB, %ld phần tử trong %.6f giây (%.2f GB/s)\n",
+           num_threads, bytes / 1e6, f->nnz, parse_time, bytes / parse_time / 1e9);
+    printf("   - Gom CSR: %.6f giây\n", (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9);
+    return A;
 }
 
 /**
- * Thuật toán Gaussian Elimination sử dụng Pthreads
+ * Chế độ --sparse: hệ test lưới 5 điểm k x k (k*k <= n ẩn), hệ ngẫu nhiên n
+ * ẩn cần hoán vị hàng (random_system, --sparse-random) hoặc ma trận
+ * coordinate từ file .mtx (mtx != NULL) lưu CSR, giải bằng LU thưa
+ * (gauss_sparse.h); phân tích số tuần tự làm mốc, sau đó chia
+ * các cây con của cây khử cho các luồng
  */
-int gaussian_elimination_pthread(LinearSystem *sys, int num_threads) {
-    int n = sys->n;
+int run_sparse(int n, int num_threads, int random_system, const MtxFile *mtx) {
+    int k = 1;
+    while ((long)(k + 1) * (k + 1) <= n) {
+        k++;
+    }
+    SparseMatrix *A = mtx ? load_mtx_sparse(mtx, num_threads) : NULL;
+    if (mtx && !A) {
+        return 0;
+    }
+    n = A ? A->n : random_system ? n : k * k;
+    double *b = malloc((size_t)n * sizeof(double));
+    double *x = malloc((size_t)n * sizeof(double));
+    if (A && b) {
+        mtx_test_rhs(A, b);
+    } else if (!A) {
+        A = !b ? NULL : random_system ? sparse_test_random(n, b) : sparse_test_system(k, b);
+    }
+    if (!A || !b || !x) {
+        printf("Lỗi: Không đủ bộ nhớ cho hệ thưa %d ẩn\n", n);
+        free(b);
+        free(x);
+        sparse_free(A);
+        return 0;
+    }
+    if (mtx) {
+        printf("Ma trận Matrix Market: %d ẩn, %d phần tử khác 0\n", n, A->nnz);
+    } else if (random_system) {
+        printf("Hệ ngẫu nhiên (đường chéo phần lớn bằng 0): %d ẩn, %d phần tử khác 0\n",
+               n, A->nnz);
+    } else {
+        printf("Lưới %d x %d: %d ẩn, %d phần tử khác 0\n", k, k, n, A->nnz);
+    }
     
-    // Tạo mutex cho việc tìm pivot
-    pthread_mutex_t pivot_mutex = PTHREAD_MUTEX_INITIALIZER;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    SparseLU *lu = sparse_analyze(A);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double analyze_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (!lu) {
+        printf("Lỗi: Không đủ bộ nhớ cho hệ số L + U\n");
+        free(b);
+        free(x);
+        sparse_free(A);
+        return 0;
+    }
+    printf("🔎 Phân tích ký hiệu: %.6f giây (nested dissection, %d supernode, front lớn nhất %d)\n",
+           analyze_time, lu->nsuper, lu->max_front);
+    printf("📏 L + U: %zu phần tử khác 0 (gấp %.1f lần A), %.1f MB (dense cần %.1f GB)\n\n",
+           sparse_lu_nnz(lu), (double)sparse_lu_nnz(lu) / A->nnz,
+           sparse_lu_nnz(lu) * sizeof(double) / 1e6, (double)n * n * sizeof(double) / 1e9);
     
-    // Thực hiện khử xuôi
-    for (int k = 0; k < n - 1; k++) {
-        // === PHASE 1: Tìm pivot song song ===
-        pthread_t *pivot_threads = malloc(num_threads * sizeof(pthread_t));
-        PivotThreadData *pivot_data = malloc(num_threads * sizeof(PivotThreadData));
-        
-        int pivot_row = k;
-        double pivot_value = fabs(sys->A[k][k]);
-        
-        // Chia công việc tìm pivot cho các luồng
-        int rows_per_thread = (n - k) / num_threads;
-        int remaining_rows = (n - k) % num_threads;
-        
-        for (int i = 0; i < num_threads; i++) {
-            pivot_data[i].sys = sys;
-            pivot_data[i].start_row = k + i * rows_per_thread;
-            pivot_data[i].end_row = k + (i + 1) * rows_per_thread;
-            pivot_data[i].k = k;
-            pivot_data[i].pivot_row = &pivot_row;
-            pivot_data[i].pivot_value = &pivot_value;
-            pivot_data[i].pivot_mutex = &pivot_mutex;
-            
-            // Phân bổ các hàng còn lại cho luồng cuối
-            if (i == num_threads - 1) {
-                pivot_data[i].end_row += remaining_rows;
-            }
-            
-            // Tạo thread tìm pivot
-            if (pthread_create(&pivot_threads[i], NULL, find_pivot_thread, &pivot_data[i]) != 0) {
-                printf("Lỗi: Không thể tạo luồng tìm pivot %d\n", i);
-                free(pivot_threads);
-                free(pivot_data);
-                return 0;
-            }
-        }
-        
-        // Chờ tất cả threads tìm pivot hoàn thành
-        for (int i = 0; i < num_threads; i++) {
-            pthread_join(pivot_threads[i], NULL);
-        }
-        
-        free(pivot_threads);
-        free(pivot_data);
-        
-        // Kiểm tra ma trận có khả nghịch không
-        if (pivot_value < 1e-12) {
-            printf("Lỗi: Ma trận không khả nghịch (pivot ≈ 0)\n");
-            pthread_mutex_destroy(&pivot_mutex);
-            return 0;
-        }
-        
-        // Hoán đổi hàng nếu cần
-        if (pivot_row != k) {
-            // Hoán đổi trong ma trận A
-            double *temp_row = sys->A[k];
-            sys->A[k] = sys->A[pivot_row];
-            sys->A[pivot_row] = temp_row;
-            
-            // Hoán đổi trong vector b
-            double temp = sys->b[k];
-            sys->b[k] = sys->b[pivot_row];
-            sys->b[pivot_row] = temp;
+    // Phân tích số tuần tự làm mốc (ghi đè bởi lần song song)
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int success = sparse_factor(lu);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double serial_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    success = success && sparse_factor_pthread(lu, num_threads);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double factor_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int refine_iters = 0;
+    if (success) {
+        sparse_solve(lu, b, x);
+        refine_iters = sparse_refine(A, lu, b, x, SPARSE_MAX_REFINE);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double solve_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    if (success) {
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây\n", analyze_time + factor_time + solve_time);
+        printf("   - Phân tích số: %.6f giây (%.2f GFLOP/s)\n", factor_time, lu->flops / factor_time / 1e9);
+        printf("   - Thế xuôi/ngược + tinh chỉnh: %.6f giây\n", solve_time);
+        printf("🐢 Phân tích số tuần tự: %.6f giây → song song nhanh hơn %.2fx\n",
+               serial_time, serial_time / factor_time);
+        int weak = sparse_weak_pivots(lu);
+        if (weak > 0) {
+            printf("⚠️  %d pivot dưới ngưỡng %.1f (chỉ đổi hàng trong supernode), tinh chỉnh lặp %d lần\n",
+                   weak, SPARSE_PIVOT_TOL, refine_iters);
         }
         
-        // === PHASE 2: Khử Gauss song song ===
-        pthread_t *elim_threads = malloc(num_threads * sizeof(pthread_t));
-        EliminationThreadData *elim_data = malloc(num_threads * sizeof(EliminationThreadData));
-        
-        // Chia công việc khử cho các luồng
-        rows_per_thread = (n - k - 1) / num_threads;
-        remaining_rows = (n - k - 1) % num_threads;
-        
-        for (int i = 0; i < num_threads; i++) {
-            elim_data[i].sys = sys;
-            elim_data[i].start_row = k + 1 + i * rows_per_thread;
-            elim_data[i].end_row = k + 1 + (i + 1) * rows_per_thread;
-            elim_data[i].k = k;
-            
-            // Phân bổ các hàng còn lại cho luồng cuối
-            if (i == num_threads - 1) {
-                elim_data[i].end_row += remaining_rows;
-            }
-            
-            // Chỉ tạo thread nếu có công việc
-            if (elim_data[i].start_row < elim_data[i].end_row && elim_data[i].start_row < n) {
-                if (pthread_create(&elim_threads[i], NULL, elimination_thread, &elim_data[i]) != 0) {
-                    printf("Lỗi: Không thể tạo luồng khử %d\n", i);
-                    free(elim_threads);
-                    free(elim_data);
-                    pthread_mutex_destroy(&pivot_mutex);
-                    return 0;
-                }
-            } else {
-                elim_threads[i] = 0; // Đánh dấu thread không được tạo
-            }
+        if (n <= 10) {
+            print_vector(x, n, "Nghiệm x");
         }
         
-        // Chờ tất cả threads khử hoàn thành
-        for (int i = 0; i < num_threads; i++) {
-            if (elim_threads[i] != 0) {
-                pthread_join(elim_threads[i], NULL);
-            }
+        double error = sparse_backward_error(A, x, b);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
         }
-        
-        free(elim_threads);
-        free(elim_data);
+    } else {
+        printf("❌ Không thể giải hệ phương trình! (không có pivot trong supernode)\n");
     }
     
-    // Kiểm tra phần tử cuối cùng trên đường chéo
-    if (fabs(sys->A[n-1][n-1]) < 1e-12) {
-        printf("Lỗi: Ma trận không khả nghịch\n");
-        pthread_mutex_destroy(&pivot_mutex);
+    sparse_lu_free(lu);
+    sparse_free(A);
+    free(b);
+    free(x);
+    return success;
+}
+
+/**
+ * Chế độ --ooc: hệ test n x n nằm trong file trên đĩa (thư mục hiện tại), LU
+ * left-looking theo panel với mem_mb MB buffer; luồng I/O đọc trước panel kế
+ * tiếp trong khi pool luồng cập nhật panel hiện tại
+ */
+int run_ooc(int n, double mem_mb, int num_threads) {
+    int w = ooc_choose_width(n, mem_mb);
+    OocMatrix *m = ooc_create(n, w, ".");
+    double *buf = m ? malloc((size_t)n * w * sizeof(double)) : NULL;
+    if (!buf) {
+        printf("Lỗi: Không tạo được file ma trận %.1f GB hoặc buffer panel\n",
+               (double)n * n * sizeof(double) / 1e9);
+        ooc_free(m);
         return 0;
     }
+    double matrix_gb = (double)n * n * sizeof(double) / 1e9;
+    printf("📀 Ma trận trên đĩa: %.2f GB, %d panel x %d cột, buffer %d x %.1f MB\n",
+           matrix_gb, m->npanels, w, OOC_BUFFERS, (double)n * w * sizeof(double) / 1e6);
+    
+    struct timespec t0, t1, t2, t3;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int success = ooc_fill_test(m, buf);
+    free(buf);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("💾 Ghi hệ test: %.6f giây\n\n", (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9);
+    m->bytes_written = 0.0;
+    m->write_time = 0.0;
+    
+    success = success && ooc_factor_pthread(m, num_threads);
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    success = success && ooc_solve(m);
+    clock_gettime(CLOCK_MONOTONIC, &t3);
+    double factor_time = (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9;
+    double solve_time = (t3.tv_sec - t2.tv_sec) + (t3.tv_nsec - t2.tv_nsec) / 1e9;
     
-    // Giai đoạn 2: Thế ngược (tuần tự vì khó song song hóa hiệu quả)
-    for (int i = n - 1; i >= 0; i--) {
-        sys->x[i] = sys->b[i];
+    if (success) {
+        double flops = 2.0 / 3.0 * n * (double)n * n;
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây\n", factor_time + solve_time);
+        printf("   - Phân tích LU: %.6f giây (%.2f GFLOP/s)\n", factor_time, flops / factor_time / 1e9);
+        printf("   - Thế xuôi/ngược: %.6f giây\n", solve_time);
+        printf("📊 I/O: đọc %.2f GB (%.1f lần ma trận), ghi %.2f GB\n",
+               m->bytes_read / 1e9, m->bytes_read / 1e9 / matrix_gb, m->bytes_written / 1e9);
+        printf("   - Đọc: %.6f giây (%.2f GB/s), chờ đọc: %.6f giây, ghi: %.6f giây\n",
+               m->read_time, m->read_time > 0 ? m->bytes_read / m->read_time / 1e9 : 0.0,
+               m->wait_time, m->write_time);
+        printf("   - Hiệu suất che I/O: %.1f%% thời gian đọc chạy song song với tính toán\n",
+               100.0 * ooc_overlap(m));
         
-        for (int j = i + 1; j < n; j++) {
-            sys->x[i] -= sys->A[i][j] * sys->x[j];
+        if (n <= 10) {
+            print_vector(m->x, n, "Nghiệm x");
         }
         
-        sys->x[i] /= sys->A[i][i];
+        double error = ooc_backward_error(m);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
+        }
+    } else {
+        printf("❌ Không thể giải hệ phương trình! (pivot ≈ 0 hoặc lỗi I/O)\n");
     }
     
-    // Dọn dẹp mutex
-    pthread_mutex_destroy(&pivot_mutex);
-    
-    return 1; // Thành công
+    ooc_free(m);
+    return success;
 }
 
 /**
- * In ma trận (chỉ khi n <= 10)
+ * Giải hệ lưu trữ băng (--band hoặc phát hiện băng khi nạp): LU băng rồi thế
+ * xuôi/ngược, kiểm tra bằng sai số ngược trên bản sao A trước khi phân tích
  */
-void print_matrix(LinearSystem *sys) {
-    int n = sys->n;
-    if (n > 10) return;
+int run_band(BandSystem *bs, int num_threads) {
+    int n = bs->n;
+    size_t band_bytes = (size_t)n * bs->ldab * sizeof(double);
+    double *AB = malloc(band_bytes);
+    if (!AB) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận băng %d x %d\n", n, n);
+        return 0;
+    }
+    memcpy(AB, bs->AB, band_bytes);
     
-    printf("Ma trận A:\n");
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            printf("%8.2f ", sys->A[i][j]);
-        }
-        printf("\n");
+    printf("📐 Lưu trữ băng: kl = %d, ku = %d, %d phần tử/cột (%.1f MB, dense %.1f MB)\n\n",
+           bs->kl, bs->ku, bs->ldab, band_bytes / 1e6, (double)n * n * sizeof(double) / 1e6);
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int success = band_factor_pthread(bs, num_threads);
+    if (success) {
+        band_solve(bs);
     }
-}
-
-/**
- * In vector (chỉ khi n <= 10)
- */
-void print_vector(double *v, int n, const char *name) {
-    if (n > 10) return;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     
-    printf("%s: ", name);
-    for (int i = 0; i < n; i++) {
-        printf("%.2f ", v[i]);
+    if (success) {
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây\n", elapsed_time);
+        
+        if (n <= 10) {
+            print_vector(bs->x, n, "Nghiệm x");
+        }
+        
+        double error = band_backward_error(bs, AB);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
+        }
+    } else {
+        printf("❌ Không thể giải hệ phương trình!\n");
     }
-    printf("\n");
+    
+    free(AB);
+    return success;
 }
-
 /**
  * Chương trình chính
  */
 int main(int argc, char *argv[]) {
     int n = 100;          // Kích thước mặc định
     int num_threads = 4;  // Số luồng mặc định
-    
-    if (argc > 1) {
-        n = atoi(argv[1]);
-        if (n <= 0) {
-            printf("Kích thước ma trận phải > 0\n");
+    int block_size = DEFAULT_BLOCK_SIZE;
+    int breakdown = 0;    // Báo cáo chi phí pool so với cách tạo luồng cũ
+    int fused_pivot = 1;  // Tìm pivot gộp vào lượt khử (mặc định)
+    int num_rhs = 0;      // Số vế phải giải thêm với cùng LU
+    int batch_count = 0;  // > 0: giải lô hệ nhỏ cùng kích thước
+    int mixed = 0;        // LU float + tinh chỉnh lặp double
+    int band_kl = -1, band_ku = -1;   // >= 0: hệ test dạng băng
+    int tridiag = 0;      // Hệ ba đường chéo n hàng (chỉ lưu 3 vector)
+    int btd_block = 0;    // > 0: hệ khối ba đường chéo, n khối hàng btd_block x btd_block
+    int sparse = 0;       // Hệ thưa CSR khoảng n ẩn (LU thưa), 2: hệ ngẫu nhiên
+    double ooc_mb = 0.0;  // > 0: ma trận trên đĩa, buffer panel ooc_mb MB
+    const char *input_path = NULL;    // File hệ nhị phân (gauss_io.h) thay cho hệ test
+    const char *output_path = NULL;   // File ghi nghiệm
+    const char *save_input_path = NULL;   // File ghi hệ A, b trước khi giải
+    int save_factors = 0;             // Ghi thêm L\U vào file --output
+    int positional = 0;
+    
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--block") == 0 && a + 1 < argc) {
+            block_size = atoi(argv[++a]);
+            if (block_size < 0) {
+                printf("Độ rộng panel phải >= 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--breakdown") == 0) {
+            breakdown = 1;
+        } else if (strcmp(argv[a], "--pivot") == 0 && a + 1 < argc) {
+            a++;
+            if (strcmp(argv[a], "fused") == 0) {
+                fused_pivot = 1;
+            } else if (strcmp(argv[a], "separate") == 0) {
+                fused_pivot = 0;
+            } else {
+                printf("Chế độ pivot không hợp lệ: %s (fused|separate)\n", argv[a]);
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--rhs") == 0 && a + 1 < argc) {
+            num_rhs = atoi(argv[++a]);
+            if (num_rhs < 0) {
+                printf("Số vế phải phải >= 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--mixed") == 0) {
+            mixed = 1;
+        } else if (strcmp(argv[a], "--batch") == 0 && a + 1 < argc) {
+            batch_count = atoi(argv[++a]);
+            if (batch_count <= 0) {
+                printf("Số hệ trong lô phải > 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--band") == 0 && a + 1 < argc) {
+            a++;
+            int fields = sscanf(argv[a], "%d,%d", &band_kl, &band_ku);
+            if (fields == 1) {
+                band_ku = band_kl;
+            }
+            if (fields < 1 || band_kl < 0 || band_ku < 0) {
+                printf("Băng không hợp lệ: %s (cần kl,ku >= 0)\n", argv[a]);
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--tridiag") == 0) {
+            tridiag = 1;
+        } else if (strcmp(argv[a], "--btd") == 0 && a + 1 < argc) {
+            btd_block = atoi(argv[++a]);
+            if (btd_block <= 0) {
+                printf("Kích thước khối phải > 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--sparse") == 0) {
+            sparse = 1;
+        } else if (strcmp(argv[a], "--sparse-random") == 0) {
+            sparse = 2;
+        } else if (strcmp(argv[a], "--input") == 0 && a + 1 < argc) {
+            input_path = argv[++a];
+        } else if (strcmp(argv[a], "--output") == 0 && a + 1 < argc) {
+            output_path = argv[++a];
+        } else if (strcmp(argv[a], "--factors") == 0) {
+            save_factors = 1;
+        } else if (strcmp(argv[a], "--save-input") == 0 && a + 1 < argc) {
+            save_input_path = argv[++a];
+        } else if (strcmp(argv[a], "--ooc") == 0 && a + 1 < argc) {
+            ooc_mb = atof(argv[++a]);
+            if (ooc_mb <= 0) {
+                printf("Bộ nhớ buffer phải > 0 MB\n");
+                return 1;
+            }
+        } else if (argv[a][0] == '-') {
+            printf("Tham số không hợp lệ: %s\n", argv[a]);
+            printf("Dùng: %s [n] [threads] [--block nb] [--pivot fused|separate] [--breakdown]\n"
+                   "          [--rhs k] [--mixed] [--batch count] [--band kl,ku]\n"
+                   "          [--tridiag] [--btd m] [--sparse] [--sparse-random] [--ooc MB]\n"
+                   "          [--input file] [--output file [--factors]] [--save-input file]\n", argv[0]);
             return 1;
+        } else if (positional == 0) {
+            positional++;
+            n = atoi(argv[a]);
+            if (n <= 0) {
+                printf("Kích thước ma trận phải > 0\n");
+                return 1;
+            }
+        } else if (positional == 1) {
+            positional++;
+            num_threads = atoi(argv[a]);
+            if (num_threads <= 0) {
+                printf("Số luồng phải > 0\n");
+                return 1;
+            }
         }
     }
     
-    if (argc > 2) {
-        num_threads = atoi(argv[2]);
-        if (num_threads <= 0) {
-            printf("Số luồng phải > 0\n");
+    if (save_input_path &&
+        (batch_count > 0 || band_kl >= 0 || tridiag || btd_block > 0 || sparse || ooc_mb > 0)) {
+        printf("--save-input chỉ dùng cho hệ dense "
+               "(không kết hợp --batch/--band/--tridiag/--btd/--sparse/--ooc)\n");
+        return 1;
+    }
+    
+    // Hệ từ file: map một lần, n lấy từ header
+    GaussFile *input = NULL;
+    MtxFile mtx;          // File .mtx (mtx.data != NULL khi đã mở)
+    memset(&mtx, 0, sizeof(mtx));
+    if (input_path) {
+        int is_mtx = mtx_is_path(input_path);
+        if (batch_count > 0 || band_kl >= 0 || tridiag || btd_block > 0 || (sparse && !is_mtx) ||
+            ooc_mb > 0) {
+            printf("--input chỉ dùng cho hệ dense, hoặc --sparse với file .mtx "
+                   "(không kết hợp --batch/--band/--tridiag/--btd/--ooc)\n");
             return 1;
         }
+        if (is_mtx) {
+            int rc = mtx_open(input_path, &mtx);
+            if (rc == MTX_OK && sparse && !mtx.coordinate) {
+                mtx_close(&mtx);
+                rc = MTX_EUNSUPPORTED;
+            }
+            if (rc != MTX_OK) {
+                printf("Lỗi: Không nạp được %s: %s\n", input_path, mtx_strerror(rc));
+                return 1;
+            }
+            n = mtx.n;
+        } else {
+            input = open_input(input_path);
+            if (!input) {
+                return 1;
+            }
+            n = (int)input->hdr.n;
+        }
+    }
+    
+    if (batch_count > 0) {
+        printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN PTHREAD (LÔ HỆ NHỎ)\n");
+        printf("Lô: %d hệ %d x %d, xen kẽ %d hệ/nhóm\n", batch_count, n, n, BATCH_LANES);
+        printf("Kernel SIMD: %s\n", simd_kernels.name);
+        printf("Số luồng: %d\n", num_threads);
+        printf("\n");
+        return run_batch(n, batch_count, num_threads, block_size, fused_pivot) ? 0 : 1;
+    }
+    
+    if (sparse) {
+        printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN PTHREAD (THƯA CSR)\n");
+        if (mtx.data) {
+            printf("Đầu vào: %s (Matrix Market, đọc song song)\n", input_path);
+        }
+        printf("Kernel SIMD: %s\n", simd_kernels.name);
+        printf("Số luồng: %d\n", num_threads);
+        int success = run_sparse(n, num_threads, sparse == 2, mtx.data ? &mtx : NULL);
+        mtx_close(&mtx);
+        return success ? 0 : 1;
+    }
+    
+    if (ooc_mb > 0) {
+        printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN PTHREAD (NGOÀI BỘ NHỚ)\n");
+        printf("Kích thước ma trận: %d x %d, buffer panel %.0f MB\n", n, n, ooc_mb);
+        printf("Kernel SIMD: %s\n", simd_kernels.name);
+        printf("Số luồng: %d\n", num_threads);
+        return run_ooc(n, ooc_mb, num_threads) ? 0 : 1;
+    }
+    
+    if (tridiag || btd_block > 0) {
+        printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN PTHREAD (BA ĐƯỜNG CHÉO)\n");
+        if (btd_block > 0) {
+            printf("Hệ khối ba đường chéo: %d khối hàng %d x %d (Thomas khối)\n",
+                   n, btd_block, btd_block);
+        } else {
+            printf("Hệ ba đường chéo: %d hàng (phân hoạch song song)\n", n);
+        }
+        printf("Kernel SIMD: %s\n", simd_kernels.name);
+        printf("Số luồng: %d\n", num_threads);
+        int success = (btd_block > 0) ? run_block_tridiag(n, btd_block, block_size, num_threads)
+                                      : run_tridiag(n, num_threads);
+        return success ? 0 : 1;
     }
     
     printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN PTHREAD\n");
     printf("Kích thước ma trận: %d x %d\n", n, n);
-    printf("Số luồng: %d\n\n", num_threads);
+    if (input) {
+        printf("Đầu vào: %s (mmap, không sao chép)\n", input_path);
+    } else if (mtx.data) {
+        printf("Đầu vào: %s (Matrix Market, đọc song song)\n", input_path);
+    }
+    printf("Kernel SIMD: %s\n", simd_kernels.name);
+    printf("Số luồng: %d\n", num_threads);
+    if (mixed) {
+        printf("Độ chính xác: LU float + tinh chỉnh lặp double\n");
+    }
+    if (band_kl >= 0) {
+        // Hệ test băng tạo thẳng trong lưu trữ băng, không cấp phát n x n
+        printf("Chế độ: LU băng\n");
+        BandSystem *bs = band_create(n, band_kl, band_ku);
+        if (!bs) {
+            printf("Lỗi: Không đủ bộ nhớ cho ma trận băng %d x %d\n", n, n);
+            return 1;
+        }
+        band_fill_test(bs);
+        int success = run_band(bs, num_threads);
+        band_free(bs);
+        return success ? 0 : 1;
+    }
+    if (block_size > 0) {
+        printf("Chế độ: LU khối (panel = %d cột)\n", block_size);
+    } else {
+        printf("Chế độ: khử từng cột (rank-1)\n");
+    }
+    printf("Tìm pivot: %s\n\n", fused_pivot ? "gộp vào lượt khử" : "quét cột riêng");
     
     // Tạo hệ phương trình
-    LinearSystem *sys = create_system(n);
-    generate_test_system(sys);
+    LinearSystem *sys = input ? map_system(input) : create_system(n);
+    if (!sys) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận %d x %d\n", n, n);
+        return 1;
+    }
+    int keep_copy = (mtx.data != NULL);
+    if (mtx.data) {
+        int loaded = load_mtx(sys, &mtx, num_threads);
+        mtx_close(&mtx);
+        if (!loaded) {
+            free_system(sys);
+            return 1;
+        }
+    } else if (!input) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        generate_test_system_pthread(sys, num_threads);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        printf("🧪 Sinh hệ test: %.6f giây\n",
+               (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+    }
+    
+    if (save_input_path && !save_input(save_input_path, sys)) {
+        free_system(sys);
+        return 1;
+    }
     
     // Hiển thị ma trận nếu nhỏ
     if (n <= 10) {
@@ -400,11 +829,56 @@ int main(int argc, char *argv[]) {
         printf("\n");
     }
     
+    // Ma trận nạp vào có dạng băng đủ hẹp: chuyển sang lưu trữ băng (trừ khi
+    // --factors cần L\U dense để ghi ra file)
+    int kl, ku;
+    if (!mixed && num_rhs == 0 && !save_factors && band_detect(sys->A, sys->lda, n, &kl, &ku)) {
+        printf("🔎 Phát hiện ma trận băng → chuyển sang LU băng\n");
+        BandSystem *bs = band_create(n, kl, ku);
+        if (!bs) {
+            printf("Lỗi: Không đủ bộ nhớ cho ma trận băng %d x %d\n", n, n);
+            free_system(sys);
+            return 1;
+        }
+        band_load(bs, sys->A, sys->lda, sys->b);
+        free_system(sys);
+        int success = run_band(bs, num_threads);
+        if (success && output_path) {
+            success = save_output(output_path, n, bs->x, NULL);
+        }
+        band_free(bs);
+        return success ? 0 : 1;
+    }
+    
+    // Nguồn kiểm tra nghiệm, lấy trước khi LU ghi đè A và b
+    VerifySource verify;
+    if (!verify_source_open(&verify, n, sys->A, sys->lda, sys->b,
+                            input ? input_path : NULL, keep_copy)) {
+        printf("Lỗi: Không giữ được hệ gốc để kiểm tra nghiệm\n");
+        verify_source_free(&verify);
+        free_system(sys);
+        return 1;
+    }
+    
+    if (mixed) {
+        int success = run_mixed(sys, &verify, num_threads, block_size, fused_pivot);
+        if (success && output_path) {
+            success = save_output(output_path, n, sys->x, save_factors ? sys : NULL);
+        }
+        verify_source_free(&verify);
+        free_system(sys);
+        return success ? 0 : 1;
+    }
+    
+    double *extra_rhs = (num_rhs > 0) ? generate_extra_rhs(sys, num_rhs) : NULL;
+    
     // Đo thời gian thực hiện
     struct timespec start, end;
     clock_gettime(CLOCK_MONOTONIC, &start);
     
-    int success = gaussian_elimination_pthread(sys, num_threads);
+    PoolStats stats;
+    int success = gaussian_elimination_pthread(sys, num_threads, block_size, fused_pivot,
+                                               breakdown ? &stats : NULL);
     
     clock_gettime(CLOCK_MONOTONIC, &end);
     double elapsed_time = (end.tv_sec - start.tv_sec) + 
@@ -419,22 +893,71 @@ int main(int argc, char *argv[]) {
             print_vector(sys->x, n, "Nghiệm x");
         }
         
-        if (verify_solution(sys)) {
-            printf("✅ Nghiệm chính xác!\n");
-        } else {
-            printf("❌ Nghiệm không chính xác!\n");
+        success = report_solution(&verify, sys->x, num_threads);
+        
+        if (num_rhs > 0) {
+            double *X = malloc((size_t)n * num_rhs * sizeof(double));
+            
+            // Từng vế phải một: thế xuôi/ngược dạng ma trận-vector
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            solve_extra_rhs(sys, extra_rhs, X, num_rhs);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double single_time = (end.tv_sec - start.tv_sec) +
+                                 (end.tv_nsec - start.tv_nsec) / 1e9;
+            double max_error = extra_rhs_error(X, n, num_rhs);
+            
+            // Cả khối vế phải cùng lúc: thế xuôi/ngược dạng ma trận-ma trận
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            lu_solve_multi_pthread(sys, num_threads, extra_rhs, num_rhs, X, num_rhs, num_rhs);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double block_time = (end.tv_sec - start.tv_sec) +
+                                (end.tv_nsec - start.tv_nsec) / 1e9;
+            double block_error = extra_rhs_error(X, n, num_rhs);
+            if (block_error > max_error) {
+                max_error = block_error;
+            }
+            
+            printf("🔁 Giải thêm %d vế phải (dùng lại LU): %.6f giây (%.6f giây/lần)\n",
+                   num_rhs, single_time, single_time / num_rhs);
+            printf("🧱 Giải khối %d vế phải: %.6f giây (%.6f giây/lần, nhanh hơn %.1fx)\n",
+                   num_rhs, block_time, block_time / num_rhs,
+                   (block_time > 0) ? single_time / block_time : 0.0);
+            printf("%s Sai số lớn nhất: %.2e\n", (max_error < 1e-6) ? "✅" : "❌", max_error);
+            free(X);
         }
         
         printf("\n📊 Thông tin hiệu năng:\n");
         printf("   - Số luồng: %d\n", num_threads);
         printf("   - Thời gian: %.6f giây\n", elapsed_time);
         
+        if (breakdown) {
+            // Cách cũ: mỗi cột tạo + join num_threads luồng 2 lần (tìm pivot, khử)
+            int legacy_rounds = 2 * (n - 1);
+            double legacy_cost = measure_legacy_spawn_cost(num_threads, legacy_rounds);
+            
+            printf("\n📊 Phân tích chi phí luồng:\n");
+            printf("   - Pool: tạo/join %d luồng một lần: %.6f giây\n",
+                   stats.num_threads, stats.spawn_time);
+            printf("   - Chờ barrier: %ld lần, trung bình %.6f giây/luồng (%.1f%%)\n",
+                   stats.barrier_count, stats.barrier_time,
+                   100.0 * stats.barrier_time / elapsed_time);
+            printf("   - Cách cũ: %ld lần tạo/join luồng ≈ %.6f giây (%.1f%% thời gian giải hiện tại)\n",
+                   (long)legacy_rounds * num_threads, legacy_cost,
+                   100.0 * legacy_cost / elapsed_time);
+        }
+        
     } else {
         printf("❌ Không thể giải hệ phương trình!\n");
     }
     
+    if (success && output_path) {
+        success = save_output(output_path, n, sys->x, save_factors ? sys : NULL);
+    }
+    
     // Dọn dẹp bộ nhớ
+    free(extra_rhs);
+    verify_source_free(&verify);
     free_system(sys);
     
     return success ? 0 : 1;
-} 
\ No newline at end of file
+} 
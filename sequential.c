@@ -1,248 +1,778 @@
 /**
  * GAUSSIAN ELIMINATION - PHIÊN BẢN TUẦN TỰ
  * Giải hệ phương trình tuyến tính Ax = b
+ * Chương trình chỉ đọc tham số và in kết quả; phần tính toán là engine tuần
+ * tự của libgauss (gauss_core.c, gauss_sequential.c)
  */
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
+#include <string.h>
+#include <limits.h>
 #include <time.h>
+#include "gauss_core.h"
+#include "gauss_driver.h"
 
-// Cấu trúc lưu trữ hệ phương trình
-typedef struct {
-    double **A;     // Ma trận hệ số n x n
-    double *b;      // Vector hằng số
-    double *x;      // Vector nghiệm
-    int n;          // Kích thước ma trận
-} LinearSystem;
 
-/**
- * Tạo hệ phương trình mới với kích thước n x n
- */
-LinearSystem* create_system(int n) {
-    LinearSystem *sys = malloc(sizeof(LinearSystem));
-    sys->n = n;
-    
-    sys->A = malloc(n * sizeof(double*));
-    for (int i = 0; i < n; i++) {
-        sys->A[i] = malloc(n * sizeof(double));
-    }
-    
-    sys->b = malloc(n * sizeof(double));
-    sys->x = malloc(n * sizeof(double));
-    
-    return sys;
-}
+// Số hệ tối đa khi đo cách lặp giải từng hệ (--batch)
+#define BATCH_BASELINE_MAX 2000
 
 /**
- * Giải phóng bộ nhớ
+ * Kiểm tra nghiệm trên hệ gốc và in kết quả. Trả về 0 nếu không chính xác.
  */
-void free_system(LinearSystem *sys) {
-    if (!sys) return;
+int report_solution(const VerifySource *src, const double *x) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    double error = verify_solution(src, x);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     
-    for (int i = 0; i < sys->n; i++) {
-        free(sys->A[i]);
+    if (error < 1e-10) {
+        printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+    } else {
+        printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
     }
-    free(sys->A);
-    free(sys->b);
-    free(sys->x);
-    free(sys);
+    printf("🔍 Kiểm tra trên hệ gốc: %.6f giây\n", elapsed);
+    return error < 1e-10;
 }
 
 /**
- * Tạo hệ phương trình test với ma trận dominant diagonal
+ * Chế độ --batch: giải count hệ n x n bằng bộ giải lô (gauss_batch.h) và so
+ * với cách hiện tại là lặp create_system + giải + free_system cho từng hệ
+ * (đo trên tối đa BATCH_BASELINE_MAX hệ rồi quy ra hệ/giây)
  */
-void generate_test_system(LinearSystem *sys) {
-    int n = sys->n;
+int run_batch(int n, int count, int block_size) {
+    BatchSystem *bs = batch_create(n, count);
+    if (!bs) {
+        printf("Lỗi: Không đủ bộ nhớ cho lô %d hệ %d x %d\n", count, n, n);
+        return 0;
+    }
+    batch_fill_test(bs, 0, count);
     
-    // Tạo ma trận A với đường chéo chính lớn (đảm bảo khả nghịch)
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            if (i == j) {
-                sys->A[i][j] = n + 10.0;  // Đường chéo chính lớn
-            } else {
-                sys->A[i][j] = 1.0 / (i + j + 1.0);  // Phần tử khác nhỏ
+    // Dữ liệu cho cách lặp từng hệ, chuẩn bị trước khi đo
+    int loops = (count < BATCH_BASELINE_MAX) ? count : BATCH_BASELINE_MAX;
+    double *base_A = malloc((size_t)loops * n * n * sizeof(double));
+    double *base_b = malloc((size_t)loops * n * sizeof(double));
+    if (!base_A || !base_b) {
+        printf("Lỗi: Không đủ bộ nhớ cho lô %d hệ %d x %d\n", count, n, n);
+        free(base_A);
+        free(base_b);
+        batch_free(bs);
+        return 0;
+    }
+    for (int s = 0; s < loops; s++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                base_A[((size_t)s * n + i) * n + j] = batch_test_entry(s, i, j);
             }
+            base_b[(size_t)s * n + i] = batch_test_rhs(s, i, n);
         }
     }
     
-    // Tạo vector nghiệm x cố định: x[i] = i + 1
-    double *true_x = malloc(n * sizeof(double));
-    for (int i = 0; i < n; i++) {
-        true_x[i] = i + 1.0;
-    }
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    batch_solve_groups(bs, 0, bs->groups);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double batch_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     
-    // Tính b = A * x
-    for (int i = 0; i < n; i++) {
-        sys->b[i] = 0.0;
-        for (int j = 0; j < n; j++) {
-            sys->b[i] += sys->A[i][j] * true_x[j];
+    int singular;
+    double max_error = batch_verify_test(bs, &singular);
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int loop_ok = 1;
+    for (int s = 0; s < loops; s++) {
+        LinearSystem *sys = create_system(n);
+        if (!sys) {
+            loop_ok = 0;
+            break;
         }
+        for (int i = 0; i < n; i++) {
+            memcpy(row_ptr(sys, i), base_A + ((size_t)s * n + i) * n, n * sizeof(double));
+        }
+        memcpy(sys->b, base_b + (size_t)s * n, n * sizeof(double));
+        gaussian_elimination(sys, block_size);
+        free_system(sys);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double loop_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (!loop_ok) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận %d x %d\n", n, n);
+        free(base_A);
+        free(base_b);
+        batch_free(bs);
+        return 0;
     }
     
-    free(true_x);
+    double batch_rate = count / batch_time;
+    double loop_rate = loops / loop_time;
+    printf("📦 Bộ giải lô: %.6f giây → %.0f hệ/giây\n", batch_time, batch_rate);
+    printf("🔁 Lặp gaussian_elimination (%d hệ): %.6f giây → %.0f hệ/giây\n",
+           loops, loop_time, loop_rate);
+    printf("⚡ Bộ giải lô nhanh hơn %.1fx\n", batch_rate / loop_rate);
+    printf("%s Sai số ngược lớn nhất: %.2e (%d hệ suy biến)\n",
+           (max_error < 1e-10) ? "✅" : "❌", max_error, singular);
+    
+    free(base_A);
+    free(base_b);
+    batch_free(bs);
+    return max_error < 1e-10;
 }
 
 /**
- * Kiểm tra tính đúng đắn nghiệm bằng cách tính A*x so với b
+ * Chế độ --mixed: giải bằng LU float + tinh chỉnh, sau đó giải lại bằng LU
+ * double trên cùng hệ để so thời gian. Nghiệm hỗn hợp được kiểm tra trên hệ
+ * gốc (src).
  */
-int verify_solution(LinearSystem *sys) {
+int run_mixed(LinearSystem *sys, const VerifySource *src, int block_size) {
     int n = sys->n;
-    double tolerance = 1e-9;
-    double max_error = 0.0;
-    int error_count = 0;
+    int iterations, fallback;
     
-    for (int i = 0; i < n; i++) {
-        double sum = 0.0;
-        for (int j = 0; j < n; j++) {
-            sum += sys->A[i][j] * sys->x[j];
-        }
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int success = gaussian_elimination_mixed(sys, block_size, &iterations, &fallback);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double mixed_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (!success) {
+        printf("❌ Không thể giải hệ phương trình!\n");
+        return 0;
+    }
+    
+    double double_time = 0.0;
+    if (!fallback) {
+        double *x_mixed = malloc(n * sizeof(double));
+        memcpy(x_mixed, sys->x, n * sizeof(double));
         
-        double error = fabs(sum - sys->b[i]);
-        if (error > max_error) {
-            max_error = error;
-        }
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        success = gaussian_elimination(sys, block_size);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
         
-        if (error > tolerance) {
-            error_count++;
+        memcpy(sys->x, x_mixed, n * sizeof(double));
+        free(x_mixed);
+        if (!success) {
+            printf("❌ LU double thất bại!\n");
+            return 0;
         }
     }
     
-    // Adaptive tolerance cho ma trận lớn
-    double adaptive_tolerance = (n > 2000) ? 1e-6 : tolerance;
+    printf("✅ Giải thành công!\n");
+    printf("⏱️  Thời gian thực hiện: %.6f giây\n", mixed_time);
     
-    if (n > 2000 && max_error <= adaptive_tolerance) {
-        return 1;  // Pass với adaptive tolerance
+    if (n <= 10) {
+        print_vector(sys->x, n, "Nghiệm x");
     }
     
-    return (error_count == 0) ? 1 : 0;
+    success = report_solution(src, sys->x);
+    
+    if (fallback) {
+        printf("⚠️  Tinh chỉnh float không hội tụ sau %d lần → đã giải lại bằng double\n",
+               iterations);
+    } else {
+        printf("🔬 LU float + %d lần tinh chỉnh double\n", iterations);
+        printf("⚡ LU double: %.6f giây → hỗn hợp nhanh hơn %.2fx\n",
+               double_time, double_time / mixed_time);
+    }
+    return success;
 }
 
 /**
- * Thuật toán Gaussian Elimination với Partial Pivoting
- * Phương pháp khử Gauss tuần tự
+ * Chế độ --tridiag: hệ test ba đường chéo n hàng, chỉ cấp phát các vector
+ * (đo được cả hệ hàng triệu hàng), kiểm tra bằng sai số ngược
  */
-int gaussian_elimination(LinearSystem *sys) {
-    int n = sys->n;
-    double **A = sys->A;
-    double *b = sys->b;
-    double *x = sys->x;
-    
-    // Giai đoạn 1: Khử xuôi (Forward Elimination)
-    for (int k = 0; k < n - 1; k++) {
-        // Tìm pivot lớn nhất trong cột k (từ hàng k trở xuống)
-        int max_row = k;
-        double max_val = fabs(A[k][k]);
-        
-        for (int i = k + 1; i < n; i++) {
-            if (fabs(A[i][k]) > max_val) {
-                max_val = fabs(A[i][k]);
-                max_row = i;
-            }
-        }
+int run_tridiag(int n) {
+    TridiagSystem *ts = tridiag_create(n);
+    if (!ts) {
+        printf("Lỗi: Không đủ bộ nhớ cho hệ ba đường chéo %d hàng\n", n);
+        return 0;
+    }
+    tridiag_fill_test(ts, 0, n, n);
+    printf("📏 Bộ nhớ: %.1f MB (dense cần %.1f GB)\n\n",
+           7.0 * n * sizeof(double) / 1e6, (double)n * n * sizeof(double) / 1e9);
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int success = tridiag_thomas(ts);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    if (success) {
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây (%.1f triệu hàng/giây)\n",
+               elapsed_time, n / elapsed_time / 1e6);
         
-        // Kiểm tra ma trận có khả nghịch không
-        if (max_val < 1e-12) {
-            printf("Lỗi: Ma trận không khả nghịch (pivot ≈ 0)\n");
-            return 0;
+        if (n <= 10) {
+            print_vector(ts->x, n, "Nghiệm x");
         }
         
-        // Hoán đổi hàng k với hàng max_row nếu cần
-        if (max_row != k) {
-            // Hoán đổi trong ma trận A
-            double *temp_row = A[k];
-            A[k] = A[max_row];
-            A[max_row] = temp_row;
-            
-            // Hoán đổi trong vector b
-            double temp = b[k];
-            b[k] = b[max_row];
-            b[max_row] = temp;
+        double error = tridiag_backward_error(ts);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
         }
+    } else {
+        printf("❌ Không thể giải hệ phương trình! (pivot ≈ 0)\n");
+    }
+    
+    tridiag_free(ts);
+    return success;
+}
+
+/**
+ * Chế độ --btd m: hệ test khối ba đường chéo nb khối hàng m x m
+ */
+int run_block_tridiag(int nb, int m, int block_size) {
+    BlockTridiag *bt = btd_create(nb, m);
+    if (!bt) {
+        printf("Lỗi: Không đủ bộ nhớ cho hệ khối ba đường chéo %d x %d\n", nb, m);
+        return 0;
+    }
+    btd_fill_test(bt);
+    printf("📏 Bộ nhớ: %.1f MB cho %d khối hàng (dense cần %.1f GB)\n\n",
+           3.0 * nb * m * m * sizeof(double) / 1e6, nb,
+           (double)nb * m * nb * m * sizeof(double) / 1e9);
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int success = block_tridiag_solve(bt, block_size);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    if (success) {
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây\n", elapsed_time);
         
-        // Khử các phần tử dưới pivot
-        for (int i = k + 1; i < n; i++) {
-            double factor = A[i][k] / A[k][k];
-            
-            // Cập nhật hàng i
-            for (int j = k; j < n; j++) {
-                A[i][j] -= factor * A[k][j];
-            }
-            b[i] -= factor * b[k];
+        double error = btd_backward_error(bt);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
         }
+    } else {
+        printf("❌ Không thể giải hệ phương trình!\n");
+    }
+    
+    btd_free(bt);
+    return success;
+}
+
+/**
+ * Nạp ma trận Matrix Market (gauss_mtx.h) vào hệ dense bằng một lượt parse;
+ * b = A * x (x[i] = i + 1) như hệ test để kiểm tra được nghiệm
+ */
+int load_mtx(LinearSystem *sys, const MtxFile *f) {
+    int n = sys->n;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < n; i++) {
+        memset(row_ptr(sys, i), 0, n * sizeof(double));
+    }
+    long parsed = mtx_parse_dense(f, f->body, f->size, 0, sys->A, sys->lda);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (parsed != f->nnz) {
+        printf("Lỗi: Matrix Market %s\n", mtx_strerror(MTX_EPARSE));
+        return 0;
+    }
+    double bytes = (double)(f->size - f->body);
+    printf("📥 Đọc Matrix Market: %.1f MB, %ld phần tử trong %.6f giây (%.2f GB/s)\n",
+           bytes / 1e6, f->nnz, elapsed, bytes / elapsed / 1e9);
+    
+    fill_test_rhs(sys);
+    return 1;
+}
+
+/**
+ * Nạp file Matrix Market coordinate thành CSR: parse vào mảng toạ độ rồi
+ * gom theo hàng. Trả về NULL (đã in lỗi) nếu dữ liệu hỏng hoặc hết bộ nhớ.
+ */
+SparseMatrix* load_mtx_sparse(const MtxFile *f) {
+    int *rows = malloc(f->nnz * sizeof(int));
+    int *cols = malloc(f->nnz * sizeof(int));
+    double *vals = malloc(f->nnz * sizeof(double));
+    if (!rows || !cols || !vals) {
+        printf("Lỗi: Không đủ bộ nhớ cho %ld phần tử\n", f->nnz);
+        free(rows);
+        free(cols);
+        free(vals);
+        return NULL;
+    }
+    
+    struct timespec t0, t1, t2;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    long parsed = mtx_parse_coo(f, f->body, f->size, 0, rows, cols, vals);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    SparseMatrix *A = (parsed == f->nnz) ? mtx_coo_to_csr(f, rows, cols, vals) : NULL;
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    free(rows);
+    free(cols);
+    free(vals);
+    
+    if (parsed != f->nnz) {
+        printf("Lỗi: Matrix Market %s\n", mtx_strerror(MTX_EPARSE));
+        return NULL;
+    }
+    if (!A) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận CSR\n");
+        return NULL;
+    }
+    double parse_time = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    double bytes = (double)(f->size - f->body);
+    printf("📥 Đọc Matrix Market: %.1f MB, %ld phần tử trong %.6f giây (%.2f GB/s)\n",
+           bytes / 1e6, f->nnz, parse_time, bytes / parse_time / 1e9);
+    printf("   - Gom CSR: %.6f giây\n", (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9);
+    return A;
+}
+
+/**
+ * Chế độ --sparse: hệ test lưới 5 điểm k x k (k*k <= n ẩn), hệ ngẫu nhiên n
+ * ẩn cần hoán vị hàng (random_system, --sparse-random) hoặc ma trận
+ * coordinate từ file .mtx (mtx != NULL) lưu CSR, giải bằng LU thưa
+ * (gauss_sparse.h), kiểm tra bằng sai số ngược
+ */
+int run_sparse(int n, int random_system, const MtxFile *mtx) {
+    int k = 1;
+    while ((long)(k + 1) * (k + 1) <= n) {
+        k++;
+    }
+    SparseMatrix *A = mtx ? load_mtx_sparse(mtx) : NULL;
+    if (mtx && !A) {
+        return 0;
+    }
+    n = A ? A->n : random_system ? n : k * k;
+    double *b = malloc((size_t)n * sizeof(double));
+    double *x = malloc((size_t)n * sizeof(double));
+    if (A && b) {
+        mtx_test_rhs(A, b);
+    } else if (!A) {
+        A = !b ? NULL : random_system ? sparse_test_random(n, b) : sparse_test_system(k, b);
+    }
+    if (!A || !b || !x) {
+        printf("Lỗi: Không đủ bộ nhớ cho hệ thưa %d ẩn\n", n);
+        free(b);
+        free(x);
+        sparse_free(A);
+        return 0;
+    }
+    if (mtx) {
+        printf("Ma trận Matrix Market: %d ẩn, %d phần tử khác 0\n", n, A->nnz);
+    } else if (random_system) {
+        printf("Hệ ngẫu nhiên (đường chéo phần lớn bằng 0): %d ẩn, %d phần tử khác 0\n",
+               n, A->nnz);
+    } else {
+        printf("Lưới %d x %d: %d ẩn, %d phần tử khác 0\n", k, k, n, A->nnz);
     }
     
-    // Kiểm tra phần tử cuối cùng trên đường chéo
-    if (fabs(A[n-1][n-1]) < 1e-12) {
-        printf("Lỗi: Ma trận không khả nghịch\n");
+    struct timespec t0, t1, t2, t3;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    SparseLU *lu = sparse_analyze(A);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (!lu) {
+        printf("Lỗi: Không đủ bộ nhớ cho hệ số L + U\n");
+        free(b);
+        free(x);
+        sparse_free(A);
         return 0;
     }
+    double analyze_time = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    printf("🔎 Phân tích ký hiệu: %.6f giây (nested dissection, %d supernode, front lớn nhất %d)\n",
+           analyze_time, lu->nsuper, lu->max_front);
+    printf("📏 L + U: %zu phần tử khác 0 (gấp %.1f lần A), %.1f MB (dense cần %.1f GB)\n\n",
+           sparse_lu_nnz(lu), (double)sparse_lu_nnz(lu) / A->nnz,
+           sparse_lu_nnz(lu) * sizeof(double) / 1e6, (double)n * n * sizeof(double) / 1e9);
     
-    // Giai đoạn 2: Thế ngược (Backward Substitution)
-    for (int i = n - 1; i >= 0; i--) {
-        x[i] = b[i];
+    int success = sparse_factor(lu);
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    int refine_iters = 0;
+    if (success) {
+        sparse_solve(lu, b, x);
+        refine_iters = sparse_refine(A, lu, b, x, SPARSE_MAX_REFINE);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t3);
+    double factor_time = (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9;
+    double solve_time = (t3.tv_sec - t2.tv_sec) + (t3.tv_nsec - t2.tv_nsec) / 1e9;
+    
+    if (success) {
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây\n", analyze_time + factor_time + solve_time);
+        printf("   - Phân tích số: %.6f giây (%.2f GFLOP/s)\n", factor_time, lu->flops / factor_time / 1e9);
+        printf("   - Thế xuôi/ngược + tinh chỉnh: %.6f giây\n", solve_time);
+        int weak = sparse_weak_pivots(lu);
+        if (weak > 0) {
+            printf("⚠️  %d pivot dưới ngưỡng %.1f (chỉ đổi hàng trong supernode), tinh chỉnh lặp %d lần\n",
+                   weak, SPARSE_PIVOT_TOL, refine_iters);
+        }
         
-        // Trừ đi các phần tử đã biết
-        for (int j = i + 1; j < n; j++) {
-            x[i] -= A[i][j] * x[j];
+        if (n <= 10) {
+            print_vector(x, n, "Nghiệm x");
         }
         
-        // Chia cho hệ số của ẩn x[i]
-        x[i] /= A[i][i];
+        double error = sparse_backward_error(A, x, b);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
+        }
+    } else {
+        printf("❌ Không thể giải hệ phương trình! (không có pivot trong supernode)\n");
     }
     
-    return 1;  // Thành công
+    sparse_lu_free(lu);
+    sparse_free(A);
+    free(b);
+    free(x);
+    return success;
 }
 
 /**
- * In ma trận (chỉ khi n <= 10)
+ * Chế độ --ooc: hệ test n x n nằm trong file trên đĩa (thư mục hiện tại), LU
+ * left-looking theo panel với mem_mb MB buffer, luồng I/O đọc trước panel kế
+ * tiếp trong khi tính; báo cáo lưu lượng I/O và mức che được I/O
  */
-void print_matrix(LinearSystem *sys) {
-    int n = sys->n;
-    if (n > 10) return;
+int run_ooc(int n, double mem_mb) {
+    int w = ooc_choose_width(n, mem_mb);
+    OocMatrix *m = ooc_create(n, w, ".");
+    double *buf = m ? malloc((size_t)n * w * sizeof(double)) : NULL;
+    if (!buf) {
+        printf("Lỗi: Không tạo được file ma trận %.1f GB hoặc buffer panel\n",
+               (double)n * n * sizeof(double) / 1e9);
+        ooc_free(m);
+        return 0;
+    }
+    double matrix_gb = (double)n * n * sizeof(double) / 1e9;
+    printf("📀 Ma trận trên đĩa: %.2f GB, %d panel x %d cột, buffer %d x %.1f MB\n",
+           matrix_gb, m->npanels, w, OOC_BUFFERS, (double)n * w * sizeof(double) / 1e6);
     
-    printf("Ma trận A:\n");
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            printf("%8.2f ", sys->A[i][j]);
+    struct timespec t0, t1, t2, t3;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int success = ooc_fill_test(m, buf);
+    free(buf);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("💾 Ghi hệ test: %.6f giây\n\n", (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9);
+    m->bytes_written = 0.0;
+    m->write_time = 0.0;
+    
+    success = success && ooc_factor(m);
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    success = success && ooc_solve(m);
+    clock_gettime(CLOCK_MONOTONIC, &t3);
+    double factor_time = (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9;
+    double solve_time = (t3.tv_sec - t2.tv_sec) + (t3.tv_nsec - t2.tv_nsec) / 1e9;
+    
+    if (success) {
+        double flops = 2.0 / 3.0 * n * (double)n * n;
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây\n", factor_time + solve_time);
+        printf("   - Phân tích LU: %.6f giây (%.2f GFLOP/s)\n", factor_time, flops / factor_time / 1e9);
+        printf("   - Thế xuôi/ngược: %.6f giây\n", solve_time);
+        printf("📊 I/O: đọc %.2f GB (%.1f lần ma trận), ghi %.2f GB\n",
+               m->bytes_read / 1e9, m->bytes_read / 1e9 / matrix_gb, m->bytes_written / 1e9);
+        printf("   - Đọc: %.6f giây (%.2f GB/s), chờ đọc: %.6f giây, ghi: %.6f giây\n",
+               m->read_time, m->read_time > 0 ? m->bytes_read / m->read_time / 1e9 : 0.0,
+               m->wait_time, m->write_time);
+        printf("   - Hiệu suất che I/O: %.1f%% thời gian đọc chạy song song với tính toán\n",
+               100.0 * ooc_overlap(m));
+        
+        if (n <= 10) {
+            print_vector(m->x, n, "Nghiệm x");
         }
-        printf("\n");
+        
+        double error = ooc_backward_error(m);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
+        }
+    } else {
+        printf("❌ Không thể giải hệ phương trình! (pivot ≈ 0 hoặc lỗi I/O)\n");
     }
+    
+    ooc_free(m);
+    return success;
 }
 
 /**
- * In vector (chỉ khi n <= 10)
+ * Giải hệ lưu trữ băng (--band hoặc phát hiện băng khi nạp): LU băng rồi thế
+ * xuôi/ngược, kiểm tra bằng sai số ngược trên bản sao A trước khi phân tích
  */
-void print_vector(double *v, int n, const char *name) {
-    if (n > 10) return;
+int run_band(BandSystem *bs) {
+    int n = bs->n;
+    size_t band_bytes = (size_t)n * bs->ldab * sizeof(double);
+    double *AB = malloc(band_bytes);
+    if (!AB) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận băng %d x %d\n", n, n);
+        return 0;
+    }
+    memcpy(AB, bs->AB, band_bytes);
     
-    printf("%s: ", name);
-    for (int i = 0; i < n; i++) {
-        printf("%.2f ", v[i]);
+    printf("📐 Lưu trữ băng: kl = %d, ku = %d, %d phần tử/cột (%.1f MB, dense %.1f MB)\n\n",
+           bs->kl, bs->ku, bs->ldab, band_bytes / 1e6, (double)n * n * sizeof(double) / 1e6);
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int success = band_factor(bs);
+    if (success) {
+        band_solve(bs);
     }
-    printf("\n");
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    if (success) {
+        printf("✅ Giải thành công!\n");
+        printf("⏱️  Thời gian thực hiện: %.6f giây\n", elapsed_time);
+        
+        if (n <= 10) {
+            print_vector(bs->x, n, "Nghiệm x");
+        }
+        
+        double error = band_backward_error(bs, AB);
+        if (error < 1e-10) {
+            printf("✅ Nghiệm chính xác! (sai số ngược %.2e)\n", error);
+        } else {
+            printf("❌ Nghiệm không chính xác! (sai số ngược %.2e)\n", error);
+            success = 0;
+        }
+    } else {
+        printf("❌ Không thể giải hệ phương trình!\n");
+    }
+    
+    free(AB);
+    return success;
 }
-
 /**
  * Chương trình chính
  */
 int main(int argc, char *argv[]) {
     int n = 100;  // Kích thước mặc định
+    int block_size = DEFAULT_BLOCK_SIZE;
+    int num_rhs = 0;    // Số vế phải giải thêm với cùng LU
+    int batch_count = 0;  // > 0: giải lô hệ nhỏ cùng kích thước
+    int mixed = 0;        // LU float + tinh chỉnh lặp double
+    int band_kl = -1, band_ku = -1;   // >= 0: hệ test dạng băng
+    int tridiag = 0;      // Hệ ba đường chéo n hàng (chỉ lưu 3 vector)
+    int btd_block = 0;    // > 0: hệ khối ba đường chéo, n khối hàng btd_block x btd_block
+    int sparse = 0;       // Hệ thưa CSR khoảng n ẩn (LU thưa), 2: hệ ngẫu nhiên
+    double ooc_mb = 0.0;  // > 0: ma trận trên đĩa, buffer panel ooc_mb MB
+    const char *input_path = NULL;    // File hệ nhị phân (gauss_io.h) thay cho hệ test
+    const char *output_path = NULL;   // File ghi nghiệm
+    const char *save_input_path = NULL;   // File ghi hệ A, b trước khi giải
+    int save_factors = 0;             // Ghi thêm L\U vào file --output
+    int positional = 0;
+    
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--block") == 0 && a + 1 < argc) {
+            block_size = atoi(argv[++a]);
+            if (block_size < 0) {
+                printf("Độ rộng panel phải >= 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--rhs") == 0 && a + 1 < argc) {
+            num_rhs = atoi(argv[++a]);
+            if (num_rhs < 0) {
+                printf("Số vế phải phải >= 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--mixed") == 0) {
+            mixed = 1;
+        } else if (strcmp(argv[a], "--batch") == 0 && a + 1 < argc) {
+            batch_count = atoi(argv[++a]);
+            if (batch_count <= 0) {
+                printf("Số hệ trong lô phải > 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--band") == 0 && a + 1 < argc) {
+            a++;
+            int fields = sscanf(argv[a], "%d,%d", &band_kl, &band_ku);
+            if (fields == 1) {
+                band_ku = band_kl;
+            }
+            if (fields < 1 || band_kl < 0 || band_ku < 0) {
+                printf("Băng không hợp lệ: %s (cần kl,ku >= 0)\n", argv[a]);
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--tridiag") == 0) {
+            tridiag = 1;
+        } else if (strcmp(argv[a], "--btd") == 0 && a + 1 < argc) {
+            btd_block = atoi(argv[++a]);
+            if (btd_block <= 0) {
+                printf("Kích thước khối phải > 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[a], "--sparse") == 0) {
+            sparse = 1;
+        } else if (strcmp(argv[a], "--sparse-random") == 0) {
+            sparse = 2;
+        } else if (strcmp(argv[a], "--input") == 0 && a + 1 < argc) {
+            input_path = argv[++a];
+        } else if (strcmp(argv[a], "--output") == 0 && a + 1 < argc) {
+            output_path = argv[++a];
+        } else if (strcmp(argv[a], "--factors") == 0) {
+            save_factors = 1;
+        } else if (strcmp(argv[a], "--save-input") == 0 && a + 1 < argc) {
+            save_input_path = argv[++a];
+        } else if (strcmp(argv[a], "--ooc") == 0 && a + 1 < argc) {
+            ooc_mb = atof(argv[++a]);
+            if (ooc_mb <= 0) {
+                printf("Bộ nhớ buffer phải > 0 MB\n");
+                return 1;
+            }
+        } else if (argv[a][0] == '-') {
+            printf("Tham số không hợp lệ: %s\n", argv[a]);
+            printf("Dùng: %s [n] [--block nb] [--rhs k] [--mixed] [--batch count] [--band kl,ku]\n"
+                   "          [--tridiag] [--btd m] [--sparse] [--sparse-random] [--ooc MB]\n"
+                   "          [--input file] [--output file [--factors]] [--save-input file]\n",
+                   argv[0]);
+            return 1;
+        } else if (positional++ == 0) {
+            n = atoi(argv[a]);
+            if (n <= 0) {
+                printf("Kích thước ma trận phải > 0\n");
+                return 1;
+            }
+        }
+    }
     
-    if (argc > 1) {
-        n = atoi(argv[1]);
-        if (n <= 0) {
-            printf("Kích thước ma trận phải > 0\n");
+    if (save_input_path &&
+        (batch_count > 0 || band_kl >= 0 || tridiag || btd_block > 0 || sparse || ooc_mb > 0)) {
+        printf("--save-input chỉ dùng cho hệ dense "
+               "(không kết hợp --batch/--band/--tridiag/--btd/--sparse/--ooc)\n");
+        return 1;
+    }
+    
+    // Hệ từ file: map một lần, n lấy từ header
+    GaussFile *input = NULL;
+    MtxFile mtx;          // File .mtx (mtx.data != NULL khi đã mở)
+    memset(&mtx, 0, sizeof(mtx));
+    if (input_path) {
+        int is_mtx = mtx_is_path(input_path);
+        if (batch_count > 0 || band_kl >= 0 || tridiag || btd_block > 0 || (sparse && !is_mtx) ||
+            ooc_mb > 0) {
+            printf("--input chỉ dùng cho hệ dense, hoặc --sparse với file .mtx "
+                   "(không kết hợp --batch/--band/--tridiag/--btd/--ooc)\n");
             return 1;
         }
+        if (is_mtx) {
+            int rc = mtx_open(input_path, &mtx);
+            if (rc == MTX_OK && sparse && !mtx.coordinate) {
+                mtx_close(&mtx);
+                rc = MTX_EUNSUPPORTED;
+            }
+            if (rc != MTX_OK) {
+                printf("Lỗi: Không nạp được %s: %s\n", input_path, mtx_strerror(rc));
+                return 1;
+            }
+            n = mtx.n;
+        } else {
+            input = open_input(input_path);
+            if (!input) {
+                return 1;
+            }
+            n = (int)input->hdr.n;
+        }
+    }
+    
+    if (batch_count > 0) {
+        batch_init();
+        printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN TUẦN TỰ (LÔ HỆ NHỎ)\n");
+        printf("Lô: %d hệ %d x %d, xen kẽ %d hệ/nhóm\n", batch_count, n, n, BATCH_LANES);
+        printf("Kernel SIMD: %s\n", simd_kernels.name);
+        printf("\n");
+        return run_batch(n, batch_count, block_size) ? 0 : 1;
+    }
+    
+    if (tridiag || btd_block > 0) {
+        printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN TUẦN TỰ (BA ĐƯỜNG CHÉO)\n");
+        if (btd_block > 0) {
+            printf("Hệ khối ba đường chéo: %d khối hàng %d x %d (Thomas khối)\n",
+                   n, btd_block, btd_block);
+        } else {
+            printf("Hệ ba đường chéo: %d hàng (Thomas)\n", n);
+        }
+        printf("Kernel SIMD: %s\n", simd_kernels.name);
+        int success = (btd_block > 0) ? run_block_tridiag(n, btd_block, block_size)
+                                      : run_tridiag(n);
+        return success ? 0 : 1;
+    }
+    
+    if (sparse) {
+        printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN TUẦN TỰ (THƯA CSR)\n");
+        if (mtx.data) {
+            printf("Đầu vào: %s (Matrix Market)\n", input_path);
+        }
+        printf("Kernel SIMD: %s\n", simd_kernels.name);
+        int success = run_sparse(n, sparse == 2, mtx.data ? &mtx : NULL);
+        mtx_close(&mtx);
+        return success ? 0 : 1;
+    }
+    
+    if (ooc_mb > 0) {
+        printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN TUẦN TỰ (NGOÀI BỘ NHỚ)\n");
+        printf("Kích thước ma trận: %d x %d, buffer panel %.0f MB\n", n, n, ooc_mb);
+        printf("Kernel SIMD: %s\n", simd_kernels.name);
+        return run_ooc(n, ooc_mb) ? 0 : 1;
     }
     
     printf("🧮 GAUSSIAN ELIMINATION - PHIÊN BẢN TUẦN TỰ\n");
-    printf("Kích thước ma trận: %d x %d\n\n", n, n);
+    printf("Kích thước ma trận: %d x %d\n", n, n);
+    if (input) {
+        printf("Đầu vào: %s (mmap, không sao chép)\n", input_path);
+    } else if (mtx.data) {
+        printf("Đầu vào: %s (Matrix Market)\n", input_path);
+    }
+    printf("Kernel SIMD: %s\n", simd_kernels.name);
+    if (mixed) {
+        printf("Độ chính xác: LU float + tinh chỉnh lặp double\n");
+    }
+    if (band_kl >= 0) {
+        // Hệ test băng tạo thẳng trong lưu trữ băng, không cấp phát n x n
+        printf("Chế độ: LU băng\n");
+        BandSystem *bs = band_create(n, band_kl, band_ku);
+        if (!bs) {
+            printf("Lỗi: Không đủ bộ nhớ cho ma trận băng %d x %d\n", n, n);
+            return 1;
+        }
+        band_fill_test(bs);
+        int success = run_band(bs);
+        band_free(bs);
+        return success ? 0 : 1;
+    }
+    if (block_size > 0) {
+        printf("Chế độ: LU khối (panel = %d cột)\n\n", block_size);
+    } else {
+        printf("Chế độ: khử từng cột (rank-1)\n\n");
+    }
     
     // Tạo hệ phương trình
-    LinearSystem *sys = create_system(n);
-    generate_test_system(sys);
+    LinearSystem *sys = input ? map_system(input) : create_system(n);
+    if (!sys) {
+        printf("Lỗi: Không đủ bộ nhớ cho ma trận %d x %d\n", n, n);
+        return 1;
+    }
+    int keep_copy = (mtx.data != NULL);
+    if (mtx.data) {
+        int loaded = load_mtx(sys, &mtx);
+        mtx_close(&mtx);
+        if (!loaded) {
+            free_system(sys);
+            return 1;
+        }
+    } else if (!input) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        generate_test_system(sys);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        printf("🧪 Sinh hệ test: %.6f giây\n",
+               (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+    }
+    
+    if (save_input_path && !save_input(save_input_path, sys)) {
+        free_system(sys);
+        return 1;
+    }
     
     // Hiển thị ma trận nếu nhỏ
     if (n <= 10) {
@@ -251,11 +781,54 @@ int main(int argc, char *argv[]) {
         printf("\n");
     }
     
+    // Ma trận nạp vào có dạng băng đủ hẹp: chuyển sang lưu trữ băng (trừ khi
+    // --factors cần L\U dense để ghi ra file)
+    int kl, ku;
+    if (!mixed && num_rhs == 0 && !save_factors && band_detect(sys->A, sys->lda, n, &kl, &ku)) {
+        printf("🔎 Phát hiện ma trận băng → chuyển sang LU băng\n");
+        BandSystem *bs = band_create(n, kl, ku);
+        if (!bs) {
+            printf("Lỗi: Không đủ bộ nhớ cho ma trận băng %d x %d\n", n, n);
+            free_system(sys);
+            return 1;
+        }
+        band_load(bs, sys->A, sys->lda, sys->b);
+        free_system(sys);
+        int success = run_band(bs);
+        if (success && output_path) {
+            success = save_output(output_path, n, bs->x, NULL);
+        }
+        band_free(bs);
+        return success ? 0 : 1;
+    }
+    
+    // Nguồn kiểm tra nghiệm, lấy trước khi LU ghi đè A và b
+    VerifySource verify;
+    if (!verify_source_open(&verify, n, sys->A, sys->lda, sys->b,
+                            input ? input_path : NULL, keep_copy)) {
+        printf("Lỗi: Không giữ được hệ gốc để kiểm tra nghiệm\n");
+        verify_source_free(&verify);
+        free_system(sys);
+        return 1;
+    }
+    
+    if (mixed) {
+        int success = run_mixed(sys, &verify, block_size);
+        if (success && output_path) {
+            success = save_output(output_path, n, sys->x, save_factors ? sys : NULL);
+        }
+        verify_source_free(&verify);
+        free_system(sys);
+        return success ? 0 : 1;
+    }
+    
+    double *extra_rhs = (num_rhs > 0) ? generate_extra_rhs(sys, num_rhs) : NULL;
+    
     // Đo thời gian thực hiện
     struct timespec start, end;
     clock_gettime(CLOCK_MONOTONIC, &start);
     
-    int success = gaussian_elimination(sys);
+    int success = gaussian_elimination(sys, block_size);
     
     clock_gettime(CLOCK_MONOTONIC, &end);
     double elapsed_time = (end.tv_sec - start.tv_sec) + 
@@ -270,17 +843,50 @@ int main(int argc, char *argv[]) {
             print_vector(sys->x, n, "Nghiệm x");
         }
         
-        if (verify_solution(sys)) {
-            printf("✅ Nghiệm chính xác!\n");
-        } else {
-            printf("❌ Nghiệm không chính xác!\n");
+        success = report_solution(&verify, sys->x);
+        
+        if (num_rhs > 0) {
+            double *X = malloc((size_t)n * num_rhs * sizeof(double));
+            
+            // Từng vế phải một: thế xuôi/ngược dạng ma trận-vector
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            solve_extra_rhs(sys, extra_rhs, X, num_rhs);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double single_time = (end.tv_sec - start.tv_sec) +
+                                 (end.tv_nsec - start.tv_nsec) / 1e9;
+            double max_error = extra_rhs_error(X, n, num_rhs);
+            
+            // Cả khối vế phải cùng lúc: thế xuôi/ngược dạng ma trận-ma trận
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            lu_solve_multi(sys, extra_rhs, num_rhs, X, num_rhs, num_rhs);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double block_time = (end.tv_sec - start.tv_sec) +
+                                (end.tv_nsec - start.tv_nsec) / 1e9;
+            double block_error = extra_rhs_error(X, n, num_rhs);
+            if (block_error > max_error) {
+                max_error = block_error;
+            }
+            
+            printf("🔁 Giải thêm %d vế phải (dùng lại LU): %.6f giây (%.6f giây/lần)\n",
+                   num_rhs, single_time, single_time / num_rhs);
+            printf("🧱 Giải khối %d vế phải: %.6f giây (%.6f giây/lần, nhanh hơn %.1fx)\n",
+                   num_rhs, block_time, block_time / num_rhs,
+                   (block_time > 0) ? single_time / block_time : 0.0);
+            printf("%s Sai số lớn nhất: %.2e\n", (max_error < 1e-6) ? "✅" : "❌", max_error);
+            free(X);
         }
     } else {
         printf("❌ Không thể giải hệ phương trình!\n");
     }
     
+    if (success && output_path) {
+        success = save_output(output_path, n, sys->x, save_factors ? sys : NULL);
+    }
+    
     // Dọn dẹp bộ nhớ
+    free(extra_rhs);
+    verify_source_free(&verify);
     free_system(sys);
     
     return success ? 0 : 1;
-} 
\ No newline at end of file
+} 